@@ -0,0 +1,127 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "audio.h"
+#include "blip.h"
+
+class bus;
+class cpu;
+
+// Four sound channels, the 512 Hz frame sequencer and the NR50/NR51 mixer.
+//
+// Nothing is clocked per T-cycle: every register access first catches the
+// APU up to the CPU's timestamp, stepping from one channel edge to the next,
+// and end_frame() does the same before handing finished samples to the sink.
+class apu
+{
+private:
+    struct envelope
+    {
+        std::uint8_t volume;
+        std::uint8_t period;
+        std::uint8_t timer;
+        bool increase;
+
+        void trigger(std::uint8_t nrx2);
+        void clock();
+    };
+
+    struct square_channel
+    {
+        bool enabled;
+        std::uint8_t duty;
+        std::uint8_t step;
+        std::uint16_t frequency;
+        std::uint32_t countdown;
+        std::uint16_t length;
+        envelope env;
+        // channel 1 only
+        std::uint16_t sweep_shadow;
+        std::uint8_t sweep_timer;
+        bool sweep_enabled;
+    };
+
+    struct wave_channel
+    {
+        bool enabled;
+        std::uint8_t position;
+        std::uint16_t frequency;
+        std::uint32_t countdown;
+        std::uint16_t length;
+        std::uint8_t sample;
+    };
+
+    struct noise_channel
+    {
+        bool enabled;
+        std::uint16_t lfsr;
+        std::uint32_t countdown;
+        std::uint16_t length;
+        envelope env;
+    };
+
+    // NR10..NR52 and wave RAM, as last written
+    std::array<std::uint8_t, 0x30> registers;
+    bool powered;
+
+    square_channel square1;
+    square_channel square2;
+    wave_channel wave;
+    noise_channel noise;
+
+    std::uint32_t sequencer_countdown;
+    std::uint8_t sequencer_step;
+
+    std::uint64_t time;       // CPU timestamp the APU has been run up to
+    std::uint32_t frame_time; // clocks since the last end_frame
+    std::int32_t left_level;
+    std::int32_t right_level;
+
+    audio_sink *sink;
+    null_audio_sink silent;
+    bool synthesize;
+    std::uint32_t sample_rate;
+    blip_buffer left;
+    blip_buffer right;
+    std::vector<std::int16_t> samples;
+
+    cpu *gb_cpu;
+
+    std::uint8_t &reg(std::uint16_t address);
+    void catch_up();
+    void run(std::uint64_t until);
+    void clock_sequencer();
+    void clock_length();
+    void clock_sweep();
+    std::uint16_t sweep_target();
+    void update_output();
+    void deliver();
+
+    void trigger_square(square_channel &channel, std::uint16_t base);
+    void trigger_wave();
+    void trigger_noise();
+    std::uint32_t noise_period();
+    void power_off();
+
+public:
+    apu();
+    apu(const apu &) = delete;
+    // Copies the emulated state; the output keeps its own sink and buffers.
+    apu &operator=(const apu &other);
+    // Power-on state, from the CPU's current timestamp; the output stays.
+    void reset();
+
+    void connect_cpu(cpu *c);
+    void connect(audio_sink *s); // nullptr discards the output
+    // Scales the output sample rate by `ratio` (close to 1) so the producer
+    // can track the device's real clock; call between frames.
+    void set_rate_ratio(double ratio);
+
+    std::uint8_t read(std::uint16_t address);
+    void write(std::uint16_t address, std::uint8_t data);
+
+    // Runs up to the current timestamp and delivers the samples so far.
+    void end_frame();
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <SDL.h>
+
+#include "ring_buffer.h"
+
+// Destination for the APU's output: interleaved stereo 16-bit frames.
+class audio_sink
+{
+public:
+    virtual ~audio_sink() = default;
+
+    // 0 means samples are never listened to and need not be synthesised.
+    virtual std::uint32_t sample_rate() = 0;
+    virtual void write(const std::int16_t *samples, size_t frames) = 0;
+};
+
+// Headless runs: the APU keeps its register state but produces nothing.
+class null_audio_sink : public audio_sink
+{
+public:
+    std::uint32_t sample_rate() override;
+    void write(const std::int16_t *samples, size_t frames) override;
+};
+
+// Emulation thread pushes into a lock-free ring; SDL's audio thread pulls
+// from it in the device callback and plays silence on underrun.
+class sdl_audio_sink : public audio_sink
+{
+private:
+    spsc_ring<std::int16_t> ring;
+    SDL_AudioDeviceID device;
+    std::uint32_t rate;
+    std::atomic<std::uint64_t> underrun_count;
+
+    static void callback(void *userdata, Uint8 *stream, int length);
+
+public:
+    sdl_audio_sink();
+    ~sdl_audio_sink();
+    sdl_audio_sink(const sdl_audio_sink &) = delete;
+    sdl_audio_sink &operator=(const sdl_audio_sink &) = delete;
+
+    bool open(std::uint32_t requested_rate);
+
+    std::uint32_t sample_rate() override;
+    void write(const std::int16_t *samples, size_t frames) override;
+
+    size_t queued_frames();
+    size_t capacity_frames();
+    std::uint64_t underruns(); // device callbacks that ran out of samples
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Band-limited step synthesis. Amplitude changes are recorded as deltas at
+// emulated clock times; each delta is spread over `taps` output samples with
+// a windowed-sinc kernel, picked from `phases` sub-sample offsets, so square
+// edges resample to the host rate without aliasing. Output is the running
+// sum of the deltas with a slow DC-removing leak.
+class blip_buffer
+{
+private:
+    static constexpr int taps = 16;
+    static constexpr int phase_bits = 5;
+    static constexpr int phases = 1 << phase_bits;
+    static constexpr int kernel_bits = 15;
+    static constexpr int frac_bits = 32;
+
+    static const std::array<std::array<std::int32_t, taps>, phases> kernel;
+
+    std::vector<std::int32_t> deltas;
+    std::uint64_t factor; // output samples per clock, 32.32 fixed point
+    std::uint64_t offset; // start of the current frame, in output samples
+    std::int64_t integrator;
+
+public:
+    blip_buffer();
+
+    // `max_samples` bounds the samples produced by one frame.
+    void set_rates(double clock_rate, double sample_rate, size_t max_samples);
+
+    inline void add_delta(std::uint32_t time, std::int32_t delta)
+    {
+        std::uint64_t position = offset + time * factor;
+        std::int32_t *out = &deltas[position >> frac_bits];
+        const std::array<std::int32_t, taps> &k = kernel[(position >> (frac_bits - phase_bits)) & (phases - 1)];
+        for (int i = 0; i < taps; ++i)
+        {
+            out[i] += delta * k[i];
+        }
+    }
+
+    // Closes a frame `time` clocks long; its samples become available.
+    void end_frame(std::uint32_t time);
+    size_t available();
+    // Writes up to `count` samples `stride` apart, returns the number written.
+    size_t read(std::int16_t *out, size_t count, size_t stride);
+};
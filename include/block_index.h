@@ -0,0 +1,62 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// How a basic block hands over control.
+namespace block_exit
+{
+    constexpr std::uint8_t fallthrough = 0; // into the next block
+    constexpr std::uint8_t jump = 1;        // JP/JR to a fixed address
+    constexpr std::uint8_t branch = 2;      // conditional JP/JR
+    constexpr std::uint8_t call = 3;        // CALL/RST, conditional or not
+    constexpr std::uint8_t ret = 4;         // RET/RETI, conditional or not
+    constexpr std::uint8_t indirect = 5;    // JP (HL)
+    constexpr std::uint8_t invalid = 6;     // ran into an unused opcode or the end of the bank
+}
+
+// One basic block found by gb_disasm: straight-line code entered only at
+// `address` and left only after its last instruction.
+struct block_record
+{
+    std::uint16_t bank; // ROM bank; 0 for 0x0000-0x3fff
+    std::uint16_t address;
+    std::uint16_t length; // bytes
+    std::uint16_t instructions;
+    std::uint8_t exit; // block_exit
+    std::uint8_t function; // 1 if a call target or vector
+    std::array<std::uint8_t, 6> reserved;
+};
+static_assert(sizeof(block_record) == 16, "block_record is a fixed on-disk layout");
+
+// File layout: block_index_header followed by `count` records sorted by
+// bank, then address.
+struct block_index_header
+{
+    std::array<char, 8> magic; // "GBBLOCK"
+    std::uint32_t version;
+    std::uint32_t record_size;
+    std::uint16_t rom_checksum; // cartridge header 0x014e-0x014f
+    std::array<std::uint8_t, 6> reserved;
+    std::uint64_t count;
+};
+static_assert(sizeof(block_index_header) == 32, "block_index_header is a fixed on-disk layout");
+
+constexpr std::array<char, 8> block_index_magic = {'G', 'B', 'B', 'L', 'O', 'C', 'K', '\0'};
+
+// Precomputed block boundaries for a ROM, e.g. for a block cache to seed
+// itself with instead of discovering blocks at run time.
+class block_index
+{
+public:
+    std::vector<block_record> blocks;
+    std::uint16_t rom_checksum;
+
+    block_index();
+
+    bool load(const std::string &path);
+    bool save(const std::string &path);
+    // The block starting at bank:address, or nullptr.
+    const block_record *find(std::uint16_t bank, std::uint16_t address) const;
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// PC breakpoints for the instrumentation::debug instantiations, one bit per
+// address: ROM addresses are looked up under the bank mapped there, so the
+// check before each instruction is a single bit test. RAM is unbanked.
+class breakpoint_map
+{
+private:
+    static constexpr size_t rom_banks = 512; // MBC5 maximum
+    static constexpr size_t bank_words = 0x4000 / 64;
+
+    std::vector<std::uint64_t> rom;              // bank * 0x4000 + (address & 0x3fff)
+    std::array<std::uint64_t, 0x8000 / 64> ram; // address - 0x8000
+    bool resuming; // let the instruction stopped at run once
+    bool stepping; // stop before the next instruction
+    bool pending;  // either of the above
+    bool stopped;
+
+    std::uint64_t &word(std::uint16_t address, std::uint16_t bank);
+    bool arrive(bool set);
+
+public:
+    static constexpr std::uint16_t any_bank = 0xffff;
+
+    breakpoint_map();
+
+    // `bank` only matters below 0x8000
+    void set(std::uint16_t address, std::uint16_t bank = any_bank);
+    void clear(std::uint16_t address, std::uint16_t bank = any_bank);
+    void clear_all();
+
+    // Called before each instruction; true stops the machine in front of it.
+    inline bool stop(std::uint16_t address, std::uint16_t bank)
+    {
+        bool set = address < 0x8000
+                       ? (rom[(bank & (rom_banks - 1)) * bank_words + ((address & 0x3fff) >> 6)] >> (address & 63)) & 1
+                       : (ram[(address - 0x8000) >> 6] >> (address & 63)) & 1;
+        if (!set && !pending)
+        {
+            return false;
+        }
+        return arrive(set);
+    }
+
+    // Continues from a stop; step() runs the instruction at PC and stops
+    // in front of the next one.
+    void resume();
+    void step();
+    bool is_stopped();
+};
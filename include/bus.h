@@ -1,46 +1,217 @@
 #pragma once
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 
+#include "instance_state.h"
+#include "paged_memory.h"
+#include "profile.h"
+#include "watch.h"
+
+class serial;
+class apu;
+class cpu;
+
+// A view over the banking state and IO registers in a hot_state and the
+// memory in a memory_arena. Copies of the arena share VRAM, WRAM and
+// cartridge RAM page by page until one side writes; copying a bus copies the
+// ROM, palettes and page table that live in it.
+//
+// Accesses go through a table of 256-byte pages: ROM and RAM pages point
+// straight at memory, everything else (registers, MBC writes, disabled or
+// shared RAM, watched pages) takes the full address decode.
 class bus
 {
 private:
-    std::vector<uint8_t> rom;
-    std::array<uint8_t, 0x2000> vram;
-    std::vector<uint8_t> ext_ram;
-    std::array<uint8_t, 0x2000> wram;
-    std::array<uint8_t, 0xa0> oam;
-    std::array<uint8_t, 0x80> io_registers;
-    std::array<uint8_t, 0x7f> hram;
-    std::uint8_t ie_register;
-
-    std::uint16_t rom_bank_index;
-    std::uint8_t rom_bank_0_index;
-    std::uint8_t ext_ram_bank_index;
+    // A copy starts without write pages, since every RAM page is then
+    // shared. The source's own write pages are stale from then on, but
+    // copying must not touch the source (threads may copy it at once), so it
+    // only counts the copy; the source drops them itself once it notices.
+    struct page_map
+    {
+        std::array<const std::uint8_t *, 256> read;
+        std::array<std::uint8_t *, 256> write;
+        mutable std::atomic<std::uint32_t> copies; // taken from this map
+        std::uint32_t copies_seen;                 // when `write` was last checked
+
+        page_map();
+        page_map(const page_map &other);
+        page_map &operator=(const page_map &other);
+
+        inline bool current() const
+        {
+            return copies.load(std::memory_order_relaxed) == copies_seen;
+        }
+    };
+
+    template <size_t pages>
+    using ram = memory_arena::ram<pages>;
+
+    bus_state &state;
+    std::array<std::uint8_t, 0x80> &io_registers;
+    memory_arena &arena;
+
+    std::shared_ptr<const std::vector<std::uint8_t>> rom_image;
+    const std::uint8_t *rom; // rom_image->data()
+    // Overlays 0x0000-0x00ff, and 0x0200-0x08ff for a CGB one, until a
+    // write to 0xff50 unmaps it for good.
+    std::shared_ptr<const std::vector<std::uint8_t>> boot_image;
+
     std::uint16_t n_rom_banks;
     std::uint8_t n_ram_banks;
+    std::uint8_t cartridge_type;
 
-    bool ram_enabled;
-    bool banking_mode;
+    // CGB
+    bool cgb_mode;
+    std::array<uint8_t, 64> bg_palettes; // 8 palettes * 4 colours, RGB555 little-endian
+    std::array<uint8_t, 64> obj_palettes;
+    std::uint8_t bg_palette_index;  // BCPS: bits 0-5 index, bit 7 auto-increment
+    std::uint8_t obj_palette_index; // OCPS
 
-    std::uint8_t cartridge_type;
+    std::uint16_t wram_index(std::uint16_t address);
+    std::uint8_t read_cgb_register(std::uint16_t address);
+    void write_cgb_register(std::uint16_t address, std::uint8_t data);
+    const std::uint8_t *dma_source(std::uint16_t address, std::uint16_t &length);
+    void hdma_copy(std::uint16_t blocks);
+
+    std::uint8_t joypad_lines();
+    // raises the joypad interrupt if a P10-P13 line went from high to low
+    void request_joypad_interrupt(std::uint8_t previous_lines);
+
+    serial *gb_serial;
+    apu *gb_apu;
+    cpu *gb_cpu;
 
-    std::uint8_t dma_cycle;
+    void map(std::uint8_t first_page, std::uint8_t count, const std::uint8_t *read, std::uint8_t *write);
+    template <size_t n>
+    void map_ram(std::uint8_t first_page, std::uint8_t count, ram<n> &memory, size_t index);
+    void map_rom();
+    void map_vram();
+    void map_ext_ram();
+    void map_wram();
+    void remap();
+    template <size_t n>
+    void write_ram(ram<n> &memory, size_t index, std::uint16_t address, std::uint8_t data);
 
-    std::array<bool, 4> action_buttons;    // A, B, Select, Start
-    std::array<bool, 4> direction_buttons; // Right, Left, Up, Down
+    struct watch_entry
+    {
+        std::uint32_t id;
+        watchpoint point;
+    };
+    std::vector<watch_entry> watchpoints;
+    std::array<bool, 256> watched_pages;
+    std::uint32_t next_watch_id;
+    bool watch_paused;
+    page_map pages;
+    void check_watchpoints(std::uint16_t address, std::uint8_t access, std::uint8_t value, std::uint8_t previous);
+
+    inline std::uint8_t read_memory(std::uint16_t address)
+    {
+        const std::uint8_t *page = pages.read[address >> 8];
+        if (page != nullptr)
+        {
+            return page[address & 0xff];
+        }
+        return read_unmapped(address);
+    }
+    inline void write_memory(std::uint16_t address, std::uint8_t data)
+    {
+        std::uint8_t *page = pages.write[address >> 8];
+        if (page != nullptr && pages.current())
+        {
+            page[address & 0xff] = data;
+            return;
+        }
+        write_unmapped(address, data);
+    }
+    // the full decode, plus watchpoints
+    std::uint8_t read_unmapped(std::uint16_t address);
+    void write_unmapped(std::uint16_t address, std::uint8_t data);
+    std::uint8_t read_region(std::uint16_t address);
+    void write_region(std::uint16_t address, std::uint8_t data);
 
 public:
-    bus();
+#ifdef GB_INSTRUMENT
+    bus_profile *profile;
+#endif
+
+
+    bus(bus_state &s, std::array<std::uint8_t, 0x80> &io, memory_arena &memory);
+    bus(const bus &) = delete;
+    // Copies the cartridge, palettes and page table; the state and memory
+    // behind the views are copied with the hot_state and memory_arena.
+    // Connections and watchpoints stay as they were.
+    bus &operator=(const bus &other);
+    // Back to power-on: memory, registers and MBC state from fixed images.
+    // The ROM, boot ROM, cartridge RAM contents (battery-backed on the real
+    // thing), connections and watchpoints stay.
+    void reset();
     std::uint8_t read(std::uint16_t address);
     void write(std::uint16_t address, std::uint8_t data);
+    // Debugger access: the CPU's view of memory, without watchpoints
+    std::uint8_t peek(std::uint16_t address);
+    void poke(std::uint16_t address, std::uint8_t data);
     void increment_div();
+    std::uint16_t current_rom_bank(std::uint16_t address);
+    std::uint16_t rom_banks(); // from the cartridge header
     void load_rom(std::string path);
+    // A 256-byte DMG or 2304-byte CGB boot ROM; false if the file is neither.
+    // IO registers go back to their power-on values for it to set up.
+    bool load_boot_rom(std::string path);
+    bool boot_rom_mapped();
     void load_ext_ram(std::string path);
+    // WRAM and HRAM power up holding noise that some games use as entropy.
+    // The noise comes from `seed` so runs can be reproduced; 0 means all zero.
+    void randomize_ram(std::uint64_t seed);
+
+    void connect_serial(serial *s);
+    void connect_apu(apu *a);
+    void connect_cpu(cpu *c);
 
-    void set_action_button(std::uint8_t index, bool value);
-    void set_direction_button(std::uint8_t index, bool value);
+    // JOYP reads reflect the mask immediately
+    void set_buttons(std::uint8_t mask); // A, B, Select, Start, Right, Left, Up, Down
+    std::uint8_t get_buttons();
 
     void dma_clock();
+
+    // Watched pages drop out of the page table, so the rest of memory keeps
+    // its direct access. Returns an id for remove_watchpoint.
+    std::uint32_t add_watchpoint(const watchpoint &w);
+    void remove_watchpoint(std::uint32_t id);
+    void clear_watchpoints();
+    bool watching();
+    bool paused(); // a watchpoint asked to pause since the last resume()
+    void resume();
+
+    bool is_cgb();
+    bool is_double_speed();
+    bool switch_speed(); // STOP: toggles double speed if KEY1 armed it
+    void hblank();       // runs one block of an active HBlank DMA
+    // Registers the CPU and timer poll every cycle, read without the address
+    // decode; being internal, these reads do not trigger watchpoints.
+    inline std::uint8_t read_io(std::uint8_t index)
+    {
+        return io_registers[index];
+    }
+    inline std::uint8_t interrupt_enable()
+    {
+        return state.ie_register;
+    }
+    // The byte at `address` if its page maps straight to memory, else -1;
+    // for looking ahead in code, so no side effects and no watchpoints.
+    inline int peek_mapped(std::uint16_t address)
+    {
+        const std::uint8_t *page = pages.read[address >> 8];
+        return page != nullptr ? page[address & 0xff] : -1;
+    }
+    // PPU access to either VRAM bank without going through VBK
+    inline std::uint8_t read_vram(std::uint8_t bank, std::uint16_t address)
+    {
+        return arena.vram[(bank << 13) | (address & 0x1fff)];
+    }
+    std::uint16_t bg_color(std::uint8_t palette, std::uint8_t index);
+    std::uint16_t obj_color(std::uint8_t palette, std::uint8_t index);
 };
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ring_buffer.h"
+
+// Receives every frame the PPU draws, at VBlank, on the emulation thread.
+class frame_sink
+{
+public:
+    virtual ~frame_sink() = default;
+
+    virtual void frame(const std::array<std::uint16_t, 160 * 144> &pixels) = 0;
+};
+
+// Records frames to disk from a background thread.
+//
+//   y4m: YUV4MPEG2, 4:4:4, 59.73 fps; plays in ffmpeg/mpv as is.
+//   raw: no header. DMG frames are the shade index (0 white .. 3 black) at
+//        2 bits per pixel, four pixels per byte, leftmost in the high bits;
+//        CGB frames are RGB555 little-endian.
+//
+// frame() copies into a bounded lock-free queue and never waits: when the
+// writer falls behind and the queue is full, the frame is dropped and
+// counted.
+class video_capture : public frame_sink
+{
+public:
+    enum class format
+    {
+        y4m,
+        raw
+    };
+
+private:
+    static constexpr size_t frame_pixels = 160 * 144;
+
+    spsc_ring<std::uint16_t> queue;
+    std::ofstream out;
+    format container;
+    bool color;
+    std::thread writer;
+    std::atomic<bool> stopping;
+    std::atomic<std::uint64_t> dropped_frames;
+    std::atomic<std::uint64_t> written_frames;
+
+    void run();
+    void encode(const std::uint16_t *pixels, std::vector<char> &buffer);
+
+public:
+    explicit video_capture(size_t queue_frames = 64);
+    ~video_capture();
+    video_capture(const video_capture &) = delete;
+    video_capture &operator=(const video_capture &) = delete;
+
+    // `color` selects the CGB encoding for raw streams.
+    bool open(const std::string &path, format f, bool color);
+    void close(); // drains the queue and joins the writer
+
+    void frame(const std::array<std::uint16_t, 160 * 144> &pixels) override;
+
+    std::uint64_t dropped();
+    std::uint64_t written();
+};
@@ -1,17 +1,37 @@
 #pragma once
+#include <array>
 #include <cstdint>
 
+#include "instance_state.h"
+
 class bus;
+class opcode_profiler;
+class trace_buffer;
+class trace_comparator;
 
-class cpu
+struct opcode_info
 {
-private:
-    std::uint8_t cycle;
-    bool ime_flag;
-    bool halted;
+    const char *mnemonic; // operands: d8/d16 immediate, a8/a16 address, r8 signed offset
+    std::uint8_t length;
+    std::uint8_t cycles;
+    std::uint8_t cycles_taken; // conditional branches when the condition holds
+};
 
-    bus *gb_bus;
+extern const std::array<opcode_info, 256> opcode_table;
+extern const std::array<opcode_info, 256> cb_opcode_table;
 
+// Compile-time hooks for cpu::clock; the default instantiation has none.
+namespace instrumentation
+{
+    constexpr std::uint8_t none = 0;
+    constexpr std::uint8_t profile = 1 << 0;
+    constexpr std::uint8_t trace = 1 << 1;
+    constexpr std::uint8_t compare = 1 << 2; // requires trace
+    constexpr std::uint8_t debug = 1 << 3;   // breakpoints; GB_DEBUGGER builds only
+}
+
+struct cpu_registers
+{
     std::uint8_t a;
     std::uint8_t f;
     std::uint8_t b;
@@ -20,16 +40,67 @@ private:
     std::uint8_t e;
     std::uint8_t h;
     std::uint8_t l;
-
     std::uint16_t sp;
     std::uint16_t pc;
+};
+
+// A view over the registers and counters in a cpu_state.
+class cpu
+{
+private:
+    cpu_state &state;
+    bus *gb_bus;
+
+    template <std::uint8_t flags>
+    void record_trace();
 
 public:
-    cpu();
+    opcode_profiler *profiler;
+    trace_buffer *tracer;
+    trace_comparator *comparator;
+    // Superinstructions in the uninstrumented clock(). Off by default: they
+    // trade exact interrupt timing for speed.
+    bool fusion;
+
+    explicit cpu(cpu_state &s);
+    cpu(const cpu &) = delete;
+    cpu &operator=(const cpu &) = delete;
 
     void connect_bus(bus *b);
+    // Registers for the first instruction: the boot ROM's entry point when
+    // the bus has one mapped, otherwise the state it hands the cartridge.
+    void power_on();
+    // Power-on again: counters cleared, then power_on(); hooks stay.
+    void reset();
+    template <std::uint8_t flags = instrumentation::none>
     void clock();
     void handle_interrupt();
+    std::uint64_t get_instruction_count();
+    inline std::uint16_t get_pc()
+    {
+        return state.pc;
+    }
+    cpu_registers get_registers();
+    void set_registers(const cpu_registers &r);
+    // the next tick fetches the instruction at pc
+    inline bool at_instruction_boundary()
+    {
+        return state.cycle == 0 && state.stall_cycles == 0 && !state.halted;
+    }
+    inline std::uint64_t get_timestamp()
+    {
+        return state.timestamp;
+    }
+    inline bool is_double_speed()
+    {
+        return state.speed == 2;
+    }
+    // Keeps the CPU off the bus for `ticks` ticks once the current
+    // instruction finishes.
+    inline void stall(std::uint16_t ticks)
+    {
+        state.stall_cycles += ticks * state.speed;
+    }
 
     std::uint8_t read(std::uint16_t address);
     void write(std::uint16_t address, std::uint8_t data);
@@ -537,4 +608,8 @@ public:
     std::uint8_t set_7_a();
 
     std::uint8_t invalid();
+
+    bool may_fuse();
+    std::uint8_t fuse(std::uint8_t opcode);
+    std::uint8_t push_pop(std::uint8_t push_opcode, std::uint8_t pop_opcode);
 };
\ No newline at end of file
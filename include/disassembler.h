@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "cpu.h"
+
+// Entry of opcode_table or cb_opcode_table for the instruction starting with
+// `bytes` (two bytes are read for a CB prefix).
+const opcode_info &decode(const std::uint8_t *bytes);
+
+// The instruction at `address` as text, e.g. "JR NZ,$0150" or
+// "LDH A,($FF44)", with operands filled in from `bytes`, which holds the
+// instruction's decode(bytes).length bytes. Relative jumps show their
+// target.
+std::string disassemble(std::uint16_t address, const std::uint8_t *bytes);
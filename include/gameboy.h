@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cpu.h"
+#include "ppu.h"
+#include "bus.h"
+#include "timer.h"
+#include "serial.h"
+#include "apu.h"
+#include "input.h"
+#include "breakpoints.h"
+#include "instance_state.h"
+
+// Owns the emulated state: the hot_state at the start of the object, which
+// is cache-line aligned so two instances never share a line of it, and the
+// memory_arena in an allocation of its own. The components are views over
+// them.
+class alignas(64) gameboy
+{
+private:
+    hot_state state;
+    std::unique_ptr<memory_arena> memory;
+
+    input_queue *input;
+    // run_frame stopped for a watchpoint partway through frame `paused_frame`
+    bool frame_paused;
+    std::uint64_t paused_frame;
+
+    void connect();
+    // a watchpoint or breakpoint stopped the last clock()
+    template <std::uint8_t flags>
+    bool interrupted();
+
+public:
+    // the small views first, so they sit in the lines after the hot state;
+    // the ppu's frame buffer last
+    cpu gb_cpu;
+    timer gb_timer;
+    serial gb_serial;
+    bus gb_bus;
+    ppu gb_ppu;
+    apu gb_apu;
+#ifdef GB_DEBUGGER
+    breakpoint_map *breakpoints; // checked by the instrumentation::debug instantiations
+#endif
+
+    gameboy();
+    gameboy(const gameboy &) = delete;
+    gameboy &operator=(const gameboy &) = delete;
+
+    // Runs a DMG or CGB boot ROM before the cartridge instead of starting
+    // at the state it hands over; call before load_rom. False if the file is
+    // not a boot ROM.
+    bool load_boot_rom(std::string path);
+    void load_rom(std::string path);
+    // Runs until the boot ROM unmaps itself, or for `limit` T-cycles if it
+    // never does (the DMG one locks up on a logo it does not recognise).
+    bool finish_boot(std::uint64_t limit = 4194304 * 10);
+    // A machine that has run the boot ROM on `rom_path` up to the hand-off,
+    // for restore() to start later instances from; nullptr if either file
+    // is unusable or the boot ROM never finishes.
+    static std::unique_ptr<gameboy> boot_snapshot(std::string boot_path, std::string rom_path);
+    // `count` copies of the running machine for branching search. Children
+    // share the ROM and, until either side writes, the RAM pages of this
+    // instance; each is independent and may run on its own thread. Host
+    // connections (window, sinks, input, cable, profilers, watchpoints) are
+    // not copied.
+    std::vector<std::unique_ptr<gameboy>> fork(size_t count);
+    // Replaces the emulated state with a copy of `source`, shared as fork()
+    // shares it. This instance keeps its own host connections, except for
+    // watchpoints, which are dropped. `source` is only read, so threads may
+    // restore from one snapshot at once, as long as it is not running.
+    void restore(const gameboy &source);
+    // Power-on again with the same cartridge, without reallocating: every
+    // component goes back to its fixed power-on image, through the boot ROM
+    // again if one was loaded. Cartridge RAM and host connections stay; RAM
+    // noise from bus::randomize_ram does not, so reseed after it if needed.
+    void reset();
+    template <std::uint8_t flags = instrumentation::none>
+    void clock();
+    // Returns early, after the instruction, when a watchpoint pauses
+    // (gb_bus.paused()), or before it at a breakpoint; the next call carries
+    // on with the same frame.
+    template <std::uint8_t flags = instrumentation::none>
+    void run_frame();
+    // Runs this instance and `peer` side by side until this one finishes a
+    // frame; the two are expected to share a serial_link.
+    void run_linked_frame(gameboy &peer);
+    void set_buttons(std::uint8_t mask); // A, B, Select, Start, Right, Left, Up, Down
+    // Button changes pushed to `q` are applied as emulated time reaches
+    // them; nullptr for none.
+    void connect_input(input_queue *q);
+    void poll_input(); // applies every event that is due now
+
+    std::uint64_t get_cycle_count();
+};
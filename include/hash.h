@@ -0,0 +1,7 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// XXH64. Four independent 64-bit lanes per 32-byte stripe keep the multiply
+// units busy; a 320-byte scanline is ten stripes.
+std::uint64_t xxh64(const void *data, size_t length, std::uint64_t seed = 0);
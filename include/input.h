@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+
+#include "ring_buffer.h"
+
+// A button mask (gameboy::set_buttons bit order) that applies from emulated
+// T-cycle `timestamp` on; 0 means as soon as possible.
+struct input_event
+{
+    std::uint64_t timestamp;
+    std::uint8_t mask;
+};
+
+// Hands button changes from a host thread or event callback to the emulation
+// thread without locking. One thread pushes; the emulator takes each event
+// once its cycle count reaches the timestamp, so late events apply on the
+// next tick and early ones wait for their time.
+class input_queue
+{
+private:
+    spsc_ring<input_event> events;
+    // consumer side
+    input_event pending;
+    bool has_pending;
+    std::uint64_t next_check; // cycle count at which to look again
+
+public:
+    explicit input_queue(size_t capacity = 64);
+
+    // Producer. Returns false, dropping the event, when the queue is full.
+    bool push(std::uint64_t timestamp, std::uint8_t mask);
+
+    // Consumer. An empty queue is only looked at again one scanline later,
+    // so the check in the emulation loop stays a single comparison.
+    inline bool due(std::uint64_t now)
+    {
+        return now >= next_check;
+    }
+    // Takes the next event due at `now`, if there is one.
+    bool pop(std::uint64_t now, std::uint8_t &mask);
+    // The emulated clock was set back or jumped (gameboy::reset, restore):
+    // look at the queue on the next tick, and let an event held from the old
+    // clock apply then instead of waiting for its timestamp.
+    void restart();
+};
@@ -0,0 +1,116 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "paged_memory.h"
+
+// The emulated state of one instance, split by how often it is touched.
+// cpu, ppu, timer, serial and bus keep none of it themselves: each is a view
+// over its part of a hot_state and, for the bus, a memory_arena, both owned
+// by the gameboy. Copying the two copies the machine.
+
+struct cpu_state
+{
+    std::uint8_t a;
+    std::uint8_t f;
+    std::uint8_t b;
+    std::uint8_t c;
+    std::uint8_t d;
+    std::uint8_t e;
+    std::uint8_t h;
+    std::uint8_t l;
+    std::uint16_t sp;
+    std::uint16_t pc;
+
+    std::uint8_t cycle;
+    std::uint8_t speed;         // T-cycles per tick: 1, or 2 in CGB double-speed mode
+    std::uint16_t stall_cycles; // owed to DMA, paid out at instruction boundaries
+    bool ime_flag;
+    bool halted;
+    std::uint64_t instruction_count;
+    std::uint64_t timestamp; // T-cycles since power-on
+};
+
+struct ppu_state
+{
+    std::uint64_t frame_count;
+    std::uint16_t cycle;
+    std::uint16_t drawing_dots; // length of mode 3 on the current line
+    std::uint8_t mode;
+    bool drawing;      // mode 3 in progress
+    bool render_frame; // decided when a frame starts
+    std::uint8_t drawing_line;
+};
+
+struct timer_state
+{
+    std::uint16_t div_counter;
+    std::uint16_t tima_counter;
+    std::uint8_t tima_delay;
+};
+
+struct serial_state
+{
+    std::uint32_t transfer_cycles;
+    std::uint8_t sb;
+    std::uint8_t sc;
+};
+
+// MBC, banking, DMA and joypad state; the IO registers are in hot_state.
+struct bus_state
+{
+    std::uint8_t ie_register;
+    std::uint8_t dma_cycle;
+    std::uint16_t rom_bank_index;
+    std::uint8_t rom_bank_0_index;
+    std::uint8_t ext_ram_bank_index;
+    bool ram_enabled;
+    bool banking_mode;
+    bool boot_mapped;
+
+    // CGB
+    std::uint8_t vram_bank;
+    std::uint8_t wram_bank; // bank mapped at 0xd000, 1-7
+    bool double_speed;
+    bool speed_switch_armed;
+    std::uint8_t hdma_blocks; // 16-byte blocks left in an HBlank transfer, 0 if idle
+    std::uint16_t hdma_source;
+    std::uint16_t hdma_destination;
+
+    std::uint8_t buttons; // pressed, in gameboy::set_buttons bit order
+};
+
+// Everything read or written on most ticks, in four cache lines: the CPU,
+// PPU and timer counters in the first, serial and bus state in the second,
+// the IO registers (IF, LY, STAT, DIV, TIMA...) in the last two. A thread
+// stepping many instances in turn brings in these lines, the page table and
+// the memory it touches, rather than pieces of every component.
+struct alignas(64) hot_state
+{
+    cpu_state cpu;
+    ppu_state ppu;
+    timer_state timer;
+    serial_state serial;
+    bus_state bus;
+    alignas(64) std::array<std::uint8_t, 0x80> io_registers;
+};
+
+static_assert(offsetof(hot_state, serial) == 64, "cpu, ppu and timer state share the first cache line");
+static_assert(sizeof(hot_state) == 256, "hot_state spans four cache lines");
+
+// Bulk memory, kept apart from hot_state so sweeping through it does not
+// push the counters out. VRAM, WRAM and cartridge RAM are paged so copies
+// can share them; OAM and HRAM are small enough to copy outright.
+struct alignas(64) memory_arena
+{
+    // pages the size of a WRAM bank
+    template <size_t pages>
+    using ram = paged_memory<std::uint8_t, 0x1000, pages>;
+
+    ram<4> vram;     // two banks on CGB
+    ram<32> ext_ram; // up to 16 8 KiB banks
+    ram<8> wram;     // eight 4 KiB banks on CGB
+    std::array<std::uint8_t, 0xa0> oam;
+    std::array<std::uint8_t, 0x7f> hram;
+};
@@ -0,0 +1,61 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class gameboy;
+
+// File layout: movie_header, then `changes` entries of (frame delta as
+// LEB128, button mask byte). A mask holds from its frame until the next
+// entry; button masks use the gameboy::set_buttons bit order.
+struct movie_header
+{
+    std::array<char, 4> magic; // "GBMV"
+    std::uint16_t version;
+    std::uint16_t rom_checksum; // cartridge header 0x014e-0x014f
+    std::uint64_t ram_seed;     // bus::randomize_ram seed used at power-on
+    std::uint32_t frames;       // length of the recording
+    std::uint32_t changes;
+};
+static_assert(sizeof(movie_header) == 24, "movie_header is a fixed on-disk layout");
+
+constexpr std::array<char, 4> movie_magic = {'G', 'B', 'M', 'V'};
+
+// Button input per frame, recorded or replayed.
+//
+// A replay is deterministic when it starts from a freshly loaded ROM with the
+// recorded RAM seed and is stepped with run_frame only: the core has no
+// host-time inputs, and frames are counted by the caller, not the clock.
+class movie
+{
+private:
+    struct change
+    {
+        std::uint32_t frame;
+        std::uint8_t mask;
+    };
+
+    std::vector<change> changes;
+    std::uint16_t rom_checksum;
+    std::uint64_t ram_seed;
+    std::uint32_t length;
+    size_t cursor; // next change to replay
+
+public:
+    movie();
+
+    // Both expect a gameboy that has just loaded its ROM and not run yet;
+    // they seed its RAM. A replay fails if the movie was made with another
+    // ROM.
+    void begin_recording(gameboy &gb, std::uint64_t seed);
+    bool begin_replay(gameboy &gb);
+
+    void record(std::uint32_t frame, std::uint8_t mask);
+    // Frames must be asked for in increasing order.
+    std::uint8_t play(std::uint32_t frame);
+    bool finished(std::uint32_t frame);
+
+    bool save(const std::string &path);
+    bool load(const std::string &path);
+};
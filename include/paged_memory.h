@@ -0,0 +1,196 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Array kept in fixed-size pages that copies share until they write to them.
+// Copying takes a reference on every page; the first write to a shared page
+// clones it. Copies may live on different threads: reference counts are
+// atomic, each copy only writes to pages it alone references, and copying
+// leaves the source untouched, so any number of threads may copy one source
+// at once (as long as it is not being written meanwhile).
+//
+// The page table lives inline, so an access costs one extra load.
+template <typename T, size_t page_size, size_t max_pages>
+class paged_memory
+{
+private:
+    // aligned, so copies on other threads taking or dropping references do
+    // not contend with a neighbouring allocation
+    struct alignas(64) page
+    {
+        std::atomic<std::uint32_t> references;
+        std::array<T, page_size> data;
+    };
+
+    std::array<page *, max_pages> pages;
+    size_t count; // pages in use
+    size_t length;
+
+    static page *allocate(T value)
+    {
+        page *p = new page;
+        p->references.store(1, std::memory_order_relaxed);
+        p->data.fill(value);
+        return p;
+    }
+
+    static void release(page *p)
+    {
+        if (p->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete p;
+        }
+    }
+
+    void release_all()
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            release(pages[i]);
+        }
+        count = 0;
+    }
+
+    void share(const paged_memory &other)
+    {
+        pages = other.pages;
+        count = other.count;
+        for (size_t i = 0; i < count; ++i)
+        {
+            pages[i]->references.fetch_add(1, std::memory_order_relaxed);
+        }
+        length = other.length;
+    }
+
+    // acquire: the last writer through another copy is done with it
+    bool sole(size_t index) const
+    {
+        return pages[index]->references.load(std::memory_order_acquire) == 1;
+    }
+
+    // Replaces shared page `index` with a private clone.
+    void own(size_t index)
+    {
+        page *current = pages[index];
+        page *copy = new page;
+        copy->references.store(1, std::memory_order_relaxed);
+        copy->data = current->data;
+        release(current);
+        pages[index] = copy;
+    }
+
+public:
+    explicit paged_memory(size_t size = 0, T value = T())
+    {
+        pages.fill(nullptr);
+        count = 0;
+        length = 0;
+        assign(size, value);
+    }
+
+    paged_memory(const paged_memory &other)
+    {
+        share(other);
+    }
+
+    paged_memory &operator=(const paged_memory &other)
+    {
+        if (this != &other)
+        {
+            release_all();
+            share(other);
+        }
+        return *this;
+    }
+
+    ~paged_memory()
+    {
+        release_all();
+    }
+
+    inline T operator[](size_t index) const
+    {
+        return pages[index / page_size]->data[index % page_size];
+    }
+
+    // For writing; clones the page first if it is shared.
+    inline T &writable(size_t index)
+    {
+        size_t p = index / page_size;
+        if (!sole(p))
+        {
+            own(p);
+        }
+        return pages[p]->data[index % page_size];
+    }
+
+    // Whether writing at `index` can go ahead without cloning a page.
+    inline bool owns(size_t index) const
+    {
+        return sole(index / page_size);
+    }
+
+    // Elements from `index` to the end of its page are contiguous.
+    inline const T *data(size_t index) const
+    {
+        return &pages[index / page_size]->data[index % page_size];
+    }
+
+    static constexpr size_t contiguous(size_t index)
+    {
+        return page_size - index % page_size;
+    }
+
+    const std::array<T, page_size> &page_data(size_t index) const
+    {
+        return pages[index]->data;
+    }
+
+    size_t size() const
+    {
+        return length;
+    }
+
+    // Replaces the contents with `size` copies of `value`; sizes are capped
+    // at max_pages.
+    void assign(size_t size, T value)
+    {
+        release_all();
+        length = std::min(size, max_pages * page_size);
+        for (; count < (length + page_size - 1) / page_size; ++count)
+        {
+            pages[count] = allocate(value);
+        }
+    }
+
+    // Sets every element to `value` without changing the size; pages shared
+    // with a copy are swapped for new ones instead of cloned.
+    void fill(T value)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (sole(i))
+            {
+                pages[i]->data.fill(value);
+            }
+            else
+            {
+                release(pages[i]);
+                pages[i] = allocate(value);
+            }
+        }
+    }
+
+    void assign(const std::vector<T> &values)
+    {
+        assign(values.size(), T());
+        for (size_t i = 0; i < length; ++i)
+        {
+            pages[i / page_size]->data[i % page_size] = values[i];
+        }
+    }
+};
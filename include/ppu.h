@@ -1,33 +1,87 @@
 #pragma once
 #include <cstdint>
 #include <array>
-#include <tuple>
+#include <bitset>
 #include <vector>
 #include <SDL.h>
 
+#include "instance_state.h"
+#include "renderer.h"
+
 class bus;
+class frame_sink;
 
 class ppu
 {
-private:
-    std::uint16_t cycle;
-    std::uint8_t mode;
+public:
+    enum class backend
+    {
+        scanline, // whole line at the start of mode 3; fast
+        fifo      // dot by dot; mid-line register writes and variable mode 3
+    };
 
+    // What happens to pixels; LY, STAT and the interrupts run regardless.
+    enum class render_mode
+    {
+        full,      // every frame
+        every_nth, // one frame in `render_interval`; the rest keep the last image
+        off        // no OAM scan, tile decoding or presenting at all
+    };
+
+private:
+    ppu_state &state; // mode timing and frame counters
     bus *gb_bus;
 
-    std::vector<std::tuple<std::uint8_t, std::uint8_t, std::uint8_t, std::uint8_t>> sprite_array;
-    std::array<std::uint8_t, 160> scanline;
-    std::array<std::uint8_t, 160 * 144> frame;
+    scanline_renderer scanline;
+    fifo_renderer fifo;
+    ppu_renderer *selected;
+    ppu_renderer *active; // latched when mode 3 starts
+
+    std::vector<sprite> sprite_array;
+    std::array<std::uint16_t, 160 * 144> frame; // RGB555
+    frame_sink *sink;
+
+    // xxh64 of each scanline as drawn; a line is dirty when its hash differs
+    // from the same line of the previous frame
+    std::array<std::uint64_t, 144> line_hashes;
+    std::bitset<144> changing_lines; // frame in progress
+    std::bitset<144> dirty_lines;    // last completed frame
+    std::uint64_t frame_hash;
+
+    render_mode rendering;
+    std::uint32_t render_interval;
+
+    bool should_render();
+    void draw();
 
 public:
     SDL_Window *window;
     SDL_Renderer *renderer;
     SDL_Texture *texture;
 
-    ppu();
+    explicit ppu(ppu_state &s);
+    ppu(const ppu &) = delete;
+    // Copies the frame, line hashes and renderers; the timing is in
+    // ppu_state, and the bus, sink and window stay as they were.
+    ppu &operator=(const ppu &other);
+    // Power-on state; the backend, render mode, sink and window stay.
+    void reset();
 
     void connect_bus(bus *b);
+    // Takes effect from the next line's mode 3.
+    void set_backend(backend b);
+    void connect_sink(frame_sink *s); // every drawn frame, at VBlank; nullptr for none
+    // Takes effect from the next frame.
+    void set_render_mode(render_mode mode, std::uint32_t interval = 1);
     void clock();
+    std::uint64_t get_frame_count();
+    bool frame_rendered(); // whether the last completed frame was drawn
+    // For the last completed frame; a frame that was not rendered keeps the
+    // previous hash and has no dirty lines.
+    std::uint64_t get_frame_hash();
+    const std::bitset<144> &get_dirty_lines();
+    bool frame_changed();
+    const std::array<std::uint16_t, 160 * 144> &get_frame();
 
     std::uint8_t read(std::uint16_t address);
     void write(std::uint16_t address, std::uint8_t data);
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Cheap monotonic tick source for instrumented builds. On x86 this is the TSC,
+// elsewhere steady_clock nanoseconds; callers convert to time by calibrating
+// against steady_clock over a whole run.
+inline std::uint64_t host_ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+struct bus_profile
+{
+    std::uint64_t read_ticks = 0;
+    std::uint64_t read_calls = 0;
+    std::uint64_t write_ticks = 0;
+    std::uint64_t write_calls = 0;
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+class gameboy;
+
+// Per-opcode, per-PC and per-ROM-bank execution counts, filled in by
+// cpu::clock<instrumentation::profile>.
+class opcode_profiler
+{
+private:
+    struct counter
+    {
+        std::uint64_t count = 0;
+        std::uint64_t cycles = 0;
+    };
+
+    std::array<counter, 256> base_opcodes;
+    std::array<counter, 256> cb_opcodes;
+    std::vector<counter> rom_pcs; // bank * 0x4000 + (pc & 0x3fff), sized by attach
+    std::array<counter, 0x8000> ram_pcs; // 0x8000-0xffff
+    std::vector<counter> banks;
+
+public:
+    opcode_profiler();
+
+    inline void record(std::uint16_t bank, std::uint16_t pc, std::uint8_t opcode, std::uint8_t cb_opcode, std::uint8_t cycles)
+    {
+        counter &op = opcode == 0xcb ? cb_opcodes[cb_opcode] : base_opcodes[opcode];
+        ++op.count;
+        op.cycles += cycles;
+
+        if (pc >= 0x8000)
+        {
+            ++ram_pcs[pc - 0x8000].count;
+            ram_pcs[pc - 0x8000].cycles += cycles;
+        }
+        else if (bank < banks.size())
+        {
+            // By ROM offset, as the breakpoint bitmaps are: a bank is the same
+            // code whether MBC1 mode 1 maps it at 0x0000 or at 0x4000.
+            counter &location = rom_pcs[bank * 0x4000 + (pc & 0x3fff)];
+            ++location.count;
+            location.cycles += cycles;
+            ++banks[bank].count;
+            banks[bank].cycles += cycles;
+        }
+        // a bank past the header's ROM size is unmapped; only the opcode counts
+    }
+
+    // Hooks the profiler up to `gb` and sizes the ROM tables from its
+    // cartridge header, so recording never allocates.
+    void attach(gameboy &gb);
+    void reset();
+    void dump(std::ostream &out, size_t hot_pcs = 32);
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+class apu;
+class sdl_audio_sink;
+
+// Paces the main loop once per emulated frame.
+//
+//   video: frames are released on a 59.73 Hz wall-clock schedule and the
+//          APU's output rate is nudged by up to +-0.5% so the audio ring
+//          hovers around its target fill instead of draining or overflowing.
+//   audio: the device clock is the master; each frame waits until the ring
+//          has drained back to the target, and the output rate stays fixed.
+//   none:  unthrottled (headless, benchmarks).
+//
+// Without an audio device both throttled modes fall back to plain video
+// pacing.
+class rate_control
+{
+public:
+    enum class sync
+    {
+        none,
+        video,
+        audio
+    };
+
+private:
+    sync mode;
+    apu *gb_apu;
+    sdl_audio_sink *audio;
+
+    std::chrono::steady_clock::time_point deadline;
+    std::chrono::nanoseconds frame_period;
+    std::uint64_t target_frames;
+    double ratio;
+    std::uint64_t late_frames;
+
+    void adjust_rate();
+    void wait_for_video();
+    void wait_for_audio();
+
+public:
+    rate_control(sync mode, apu *a, sdl_audio_sink *audio);
+
+    void frame_done();
+
+    double get_ratio();
+    std::uint64_t get_late_frames(); // frames that missed their deadline
+};
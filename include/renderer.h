@@ -0,0 +1,132 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class bus;
+
+// DMG shades as RGB555: white, light grey, dark grey, black
+inline constexpr std::array<std::uint16_t, 4> dmg_colors = {0x7fff, 0x6318, 0x318c, 0x0000};
+
+inline std::array<std::uint16_t, 4> dmg_palette(std::uint8_t palette)
+{
+    return {dmg_colors[palette & 0x03], dmg_colors[(palette >> 2) & 0x03], dmg_colors[(palette >> 4) & 0x03],
+            dmg_colors[(palette >> 6) & 0x03]};
+}
+
+// An OAM entry selected for the current line.
+struct sprite
+{
+    std::uint8_t y;
+    std::uint8_t x;
+    std::uint8_t tile;
+    std::uint8_t flags;
+};
+
+// Draws mode 3 of one scanline. ppu owns the mode timing and the OAM scan;
+// a renderer turns the line's registers, VRAM and sprites (in OAM order)
+// into 160 RGB555 pixels and says how many dots that took.
+class ppu_renderer
+{
+protected:
+    bus *gb_bus;
+    std::uint16_t *line; // pixels of the line being drawn
+
+public:
+    virtual ~ppu_renderer() = default;
+
+    void connect_bus(bus *b);
+    // Moves a line in progress to another buffer; for copies of a ppu.
+    void redirect(std::uint16_t *line);
+
+    virtual void begin(std::uint8_t ly, const std::vector<sprite> &sprites, std::uint16_t *line) = 0;
+    // Runs mode 3 forward; returns the dots taken.
+    virtual std::uint16_t step() = 0;
+    virtual bool done() = 0;
+};
+
+// Draws the whole line at once when mode 3 starts; mode 3 always lasts 172
+// dots, and register writes made during it only show up on the next line.
+class scanline_renderer : public ppu_renderer
+{
+private:
+    std::uint8_t ly;
+    std::vector<sprite> sprites;
+    bool finished;
+    std::uint8_t window_line; // window rows drawn so far this frame
+    std::array<std::uint8_t, 160> color_ids;
+    std::array<bool, 160> bg_priority; // CGB map attribute bit 7
+
+    void draw_span(std::uint16_t tilemap_address, std::uint8_t start, std::uint8_t end, std::uint8_t source_x,
+                   std::uint8_t source_y);
+    void draw();
+
+public:
+    scanline_renderer();
+
+    void begin(std::uint8_t ly, const std::vector<sprite> &sprites, std::uint16_t *line) override;
+    std::uint16_t step() override;
+    bool done() override;
+};
+
+// Steps the background/window fetcher, the sprite fetcher and the two pixel
+// FIFOs one dot at a time. Registers are read as pixels are fetched and
+// shifted out, so mid-line SCX, LCDC and palette writes take effect, and
+// mode 3 stretches with SCX fine scroll, the window and sprite fetches.
+class fifo_renderer : public ppu_renderer
+{
+private:
+    struct bg_pixel
+    {
+        std::uint8_t color;
+        std::uint8_t palette; // CGB attribute bits 0-2
+        bool priority;        // CGB attribute bit 7
+    };
+
+    struct obj_pixel
+    {
+        std::uint8_t color;
+        std::uint8_t palette; // OBP0/OBP1 on DMG, 0-7 on CGB
+        bool behind_bg;
+        std::uint8_t oam_index;
+    };
+
+    std::uint8_t ly;
+    std::vector<sprite> sprites;
+    std::array<bool, 10> fetched;
+
+    std::array<bg_pixel, 8> bg_fifo;
+    std::uint8_t bg_size;
+    std::array<obj_pixel, 8> obj_fifo;
+    std::uint8_t obj_size;
+
+    // background fetcher: 2 dots each for map, low and high byte, then push
+    std::uint8_t fetch_step;
+    std::uint8_t fetch_x; // tile column within the current layer
+    std::uint8_t tile_index;
+    std::uint8_t attributes;
+    std::uint8_t tile_row;
+    std::uint8_t tile_low;
+    std::uint8_t tile_high;
+    std::uint8_t startup; // dots left of the discarded first fetch
+
+    std::uint8_t lx;      // pixels shown so far
+    std::uint8_t discard; // SCX fine scroll still to drop
+    bool in_window;
+    bool window_drawn;
+    std::uint8_t window_line;
+
+    std::int8_t sprite_fetch; // index into sprites, -1 if idle
+    std::uint8_t sprite_dots;
+
+    void fetch_background();
+    void load_sprite(std::uint8_t index);
+    void shift_pixel();
+
+public:
+    fifo_renderer();
+
+    void begin(std::uint8_t ly, const std::vector<sprite> &sprites, std::uint16_t *line) override;
+    std::uint16_t step() override;
+    bool done() override;
+};
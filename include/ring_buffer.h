@@ -0,0 +1,72 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Capacity is rounded up to a power of two; push and pop move as
+// many items as fit and return the count.
+template <typename T>
+class spsc_ring
+{
+private:
+    std::vector<T> items;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head; // next slot to write, owned by the producer
+    alignas(64) std::atomic<size_t> tail; // next slot to read, owned by the consumer
+
+public:
+    explicit spsc_ring(size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        items.resize(size);
+        mask = size - 1;
+        head.store(0);
+        tail.store(0);
+    }
+
+    spsc_ring(const spsc_ring &) = delete;
+    spsc_ring &operator=(const spsc_ring &) = delete;
+
+    size_t push(const T *data, size_t count)
+    {
+        size_t write = head.load(std::memory_order_relaxed);
+        size_t read = tail.load(std::memory_order_acquire);
+        count = std::min(count, items.size() - (write - read));
+        for (size_t i = 0; i < count; ++i)
+        {
+            items[(write + i) & mask] = data[i];
+        }
+        head.store(write + count, std::memory_order_release);
+        return count;
+    }
+
+    size_t pop(T *data, size_t count)
+    {
+        size_t read = tail.load(std::memory_order_relaxed);
+        size_t write = head.load(std::memory_order_acquire);
+        count = std::min(count, write - read);
+        for (size_t i = 0; i < count; ++i)
+        {
+            data[i] = items[(read + i) & mask];
+        }
+        tail.store(read + count, std::memory_order_release);
+        return count;
+    }
+
+    // Approximate when called from the thread that doesn't own the far end.
+    size_t size() const
+    {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const
+    {
+        return items.size();
+    }
+};
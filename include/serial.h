@@ -0,0 +1,137 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "instance_state.h"
+
+class bus;
+class serial;
+
+// The other end of the link cable. The side driving the clock calls
+// exchange() once per byte when its transfer completes; the transport
+// delivers the byte to the peer and returns the byte shifted back in.
+class serial_transport
+{
+public:
+    virtual ~serial_transport() = default;
+
+    virtual void attach(serial *s);
+    virtual std::uint8_t exchange(std::uint8_t data) = 0;
+    // Transports whose peer runs asynchronously are polled every
+    // poll_interval() cycles to service transfers clocked by the peer.
+    virtual std::uint32_t poll_interval();
+    virtual void poll();
+};
+
+// No cable: the input line floats high.
+class null_serial : public serial_transport
+{
+public:
+    std::uint8_t exchange(std::uint8_t data) override;
+};
+
+// Links two instances running in the same thread. gameboy::run_linked_frame
+// interleaves the two cores in short slices, so a byte is delivered straight
+// into the peer's shift register with no queue or synchronisation.
+class serial_link
+{
+private:
+    class endpoint : public serial_transport
+    {
+    public:
+        serial *target = nullptr;
+        endpoint *peer = nullptr;
+
+        void attach(serial *s) override;
+        std::uint8_t exchange(std::uint8_t data) override;
+    };
+
+    endpoint ends[2];
+
+public:
+    serial_link();
+    serial_link(const serial_link &) = delete;
+    serial_link &operator=(const serial_link &) = delete;
+
+    serial_transport *first();
+    serial_transport *second();
+};
+
+// Connected stream socket (socketpair(2) or AF_UNIX). Each byte is a
+// two-byte message: 'T' + data from the clock master, 'R' + data in reply.
+// The master waits for the reply, which the other side sends on its next
+// poll, but for no more than wait_budget in any frame-long window; past that
+// a slow or missing peer reads as 0xff, so video and audio keep going.
+class socket_serial : public serial_transport
+{
+private:
+    static constexpr std::chrono::microseconds window{16743}; // one frame
+    static constexpr std::chrono::microseconds wait_budget{8000};
+
+    int fd;
+    serial *target;
+    std::chrono::steady_clock::time_point window_start;
+    std::chrono::microseconds waited;
+
+    bool receive(std::uint8_t &type, std::uint8_t &data, int timeout_ms);
+    void reply(std::uint8_t data);
+
+public:
+    explicit socket_serial(int fd);
+    ~socket_serial();
+    socket_serial(const socket_serial &) = delete;
+    socket_serial &operator=(const socket_serial &) = delete;
+
+    void attach(serial *s) override;
+    std::uint8_t exchange(std::uint8_t data) override;
+    std::uint32_t poll_interval() override;
+    void poll() override;
+};
+
+// Connects to the Unix socket at `path`, or listens there and waits for the
+// peer if nobody is listening yet. Returns the connected fd, or -1.
+int open_link_socket(const std::string &path);
+
+// A view over SB/SC and the shift clock in a serial_state. A transfer
+// started with the internal clock takes 8 bits at 8192 Hz (16384 Hz in
+// double speed); when it completes the byte is exchanged through the
+// transport and the serial interrupt is raised.
+class serial
+{
+private:
+    serial_state &state;
+    std::uint32_t poll_interval;
+    std::uint32_t poll_cycles;
+
+    serial_transport *transport;
+    null_serial disconnected;
+    std::string output;
+
+    bus *gb_bus;
+
+    void finish_transfer();
+
+public:
+    explicit serial(serial_state &s);
+    serial(const serial &) = delete;
+    // Copies the output log; SB, SC and the transfer are in serial_state,
+    // and the cable stays as it was.
+    serial &operator=(const serial &other);
+    // Clears the emulated state, including the output log; the cable stays.
+    void reset();
+
+    void connect_bus(bus *b);
+    void connect(serial_transport *t); // nullptr disconnects the cable
+
+    void clock();
+
+    std::uint8_t read(std::uint16_t address);
+    void write(std::uint16_t address, std::uint8_t data);
+
+    // The peer drove eight clocks into this side: shifts `data` in and
+    // returns the byte shifted out, or 0xff if no external transfer is armed.
+    std::uint8_t external_clock(std::uint8_t data);
+
+    const std::string &get_output(); // every byte sent with the internal clock
+};
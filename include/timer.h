@@ -1,19 +1,22 @@
 #pragma once
 #include <cstdint>
 
+#include "instance_state.h"
+
 class bus;
 
+// A view over the DIV and TIMA counters in a timer_state.
 class timer
 {
 private:
-    std::uint16_t div_counter;
-    std::uint16_t tima_counter;
-    std::uint8_t tima_delay;
-
+    timer_state &state;
     bus *gb_bus;
 
 public:
-    timer();
+    explicit timer(timer_state &s);
+    timer(const timer &) = delete;
+    timer &operator=(const timer &) = delete;
+    void reset();
 
     void connect_bus(bus *b);
 
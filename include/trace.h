@@ -0,0 +1,163 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// One executed instruction, captured before it runs.
+struct trace_record
+{
+    std::uint64_t cycle;
+    std::uint16_t pc;
+    std::uint16_t bank;
+    std::uint16_t sp;
+    std::uint8_t a;
+    std::uint8_t f;
+    std::uint8_t b;
+    std::uint8_t c;
+    std::uint8_t d;
+    std::uint8_t e;
+    std::uint8_t h;
+    std::uint8_t l;
+    std::array<std::uint8_t, 4> memory; // bytes at pc..pc+3
+    std::array<std::uint8_t, 6> reserved;
+};
+static_assert(sizeof(trace_record) == 32, "trace_record is a fixed on-disk layout");
+
+// File layout: trace_header followed by `count` records, oldest first.
+struct trace_header
+{
+    std::array<char, 8> magic; // "GBTRACE"
+    std::uint32_t version;
+    std::uint32_t record_size;
+    std::uint64_t count;
+};
+static_assert(sizeof(trace_header) == 24, "trace_header is a fixed on-disk layout");
+
+constexpr std::array<char, 8> trace_magic = {'G', 'B', 'T', 'R', 'A', 'C', 'E', '\0'};
+
+// Ring buffer of the most recent records. Written by the emulation thread
+// only; readers (dump, signal handlers) take a snapshot of `head`.
+class trace_buffer
+{
+private:
+    std::vector<trace_record> records;
+    std::uint64_t mask;
+    std::atomic<std::uint64_t> head;
+
+public:
+    explicit trace_buffer(std::uint64_t capacity);
+
+    inline trace_record &next()
+    {
+        return records[head.load(std::memory_order_relaxed) & mask];
+    }
+
+    inline void commit()
+    {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    std::uint64_t size();
+    std::uint64_t capacity();
+    const trace_record &at(std::uint64_t age); // 0 is the newest record
+
+    bool dump(int fd);
+    bool dump(const std::string &path);
+};
+
+// Dumps `buffer` to `path` on SIGUSR1 and on fatal signals (SEGV, BUS, ILL,
+// FPE, ABRT); fatal signals are re-raised afterwards.
+void install_trace_signal_handlers(trace_buffer *buffer, const std::string &path);
+
+// Read-only view of a trace file, memory-mapped.
+class trace_file
+{
+private:
+    void *mapping;
+    size_t mapping_size;
+
+public:
+    const trace_record *records;
+    std::uint64_t count;
+
+    trace_file();
+    ~trace_file();
+    trace_file(const trace_file &) = delete;
+    trace_file &operator=(const trace_file &) = delete;
+
+    bool open(const std::string &path);
+};
+
+// Checks every executed instruction against a reference trace and reports
+// the first divergence together with the recent history from `history`.
+// PC, SP, A-L and the first two opcode bytes are compared; bank and cycle
+// counter are ignored because text reference logs do not carry them.
+class trace_comparator
+{
+private:
+    // Bytes 8..23 of a record: pc, bank, sp, a-l, memory[0..1]; bank masked out.
+    static constexpr size_t state_offset = 8;
+    static constexpr std::uint32_t state_mask = 0xfff3;
+
+    static inline bool same_state(const trace_record &left, const trace_record &right)
+    {
+        const char *l = reinterpret_cast<const char *>(&left) + state_offset;
+        const char *r = reinterpret_cast<const char *>(&right) + state_offset;
+#ifdef __SSE2__
+        __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(l)),
+                                       _mm_loadu_si128(reinterpret_cast<const __m128i *>(r)));
+        return (~static_cast<std::uint32_t>(_mm_movemask_epi8(equal)) & state_mask) == 0;
+#else
+        for (size_t i = 0; i < 16; ++i)
+        {
+            if ((state_mask & (1 << i)) && l[i] != r[i])
+            {
+                return false;
+            }
+        }
+        return true;
+#endif
+    }
+
+    trace_file reference;
+    trace_buffer *history;
+    std::uint64_t index;
+    bool done;
+    bool failed;
+
+    void report_mismatch(const trace_record &live);
+
+public:
+    trace_comparator(trace_buffer *history);
+
+    bool open(const std::string &path);
+
+    inline void check(const trace_record &live)
+    {
+        if (done)
+        {
+            return;
+        }
+        if (index == reference.count)
+        {
+            done = true;
+            return;
+        }
+        if (!same_state(live, reference.records[index]))
+        {
+            report_mismatch(live);
+            return;
+        }
+        ++index;
+    }
+
+    bool finished();
+    bool mismatched();
+    std::uint64_t matched();
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+
+namespace watch_access
+{
+    constexpr std::uint8_t read = 1 << 0;
+    constexpr std::uint8_t write = 1 << 1;
+}
+
+// One access to a watched address. For reads `previous` equals `value`.
+struct watch_hit
+{
+    std::uint16_t address;
+    std::uint8_t access; // watch_access::read or watch_access::write
+    std::uint8_t value;
+    std::uint8_t previous;
+};
+
+// Watches bus accesses (CPU, DMA sources and the PPU's register reads) to
+// [first, last]. `condition` filters matches, e.g. a life counter reaching
+// zero:
+//
+//   [](const watch_hit &hit) { return hit.value == 0 && hit.previous != 0; }
+//
+// `callback` runs on every match and returns true to pause; without one,
+// every match pauses. Emulation stops at the end of the instruction, see
+// gameboy::run_frame. Neither may add or remove watchpoints.
+struct watchpoint
+{
+    std::uint16_t first;
+    std::uint16_t last;
+    std::uint8_t access; // watch_access bits
+    std::function<bool(const watch_hit &)> condition;
+    std::function<bool(const watch_hit &)> callback;
+};
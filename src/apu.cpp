@@ -0,0 +1,539 @@
+#include <cstdint>
+#include <algorithm>
+#include <array>
+
+#include "apu.h"
+#include "cpu.h"
+
+static constexpr double clock_rate = 4194304.0;
+static constexpr std::uint32_t sequencer_period = 8192; // 512 Hz
+// Longest stretch synthesised before samples are handed to the sink even
+// if end_frame() is not called, about 31 ms.
+static constexpr std::uint32_t max_frame_clocks = 1 << 17;
+// Full scale is 4 channels * 15 * 8 (NR50) = 480; leave room for the
+// kernel's overshoot.
+static constexpr std::int32_t volume_scale = 56;
+
+static constexpr std::array<std::uint8_t, 4> duty_patterns = {0b00000001, 0b10000001, 0b10000111, 0b01111110};
+static constexpr std::array<std::uint8_t, 4> wave_shifts = {4, 0, 1, 2}; // NR32 volume: mute, 100%, 50%, 25%
+static constexpr std::array<std::uint8_t, 8> noise_divisors = {8, 16, 32, 48, 64, 80, 96, 112};
+
+// Bits that read back as 1, NR10..NR52
+static constexpr std::array<std::uint8_t, 0x17> read_masks = {
+    0x80, 0x3f, 0x00, 0xff, 0xbf,
+    0xff, 0x3f, 0x00, 0xff, 0xbf,
+    0x7f, 0xff, 0x9f, 0xff, 0xbf,
+    0xff, 0xff, 0x00, 0x00, 0xbf,
+    0x00, 0x00, 0x70};
+
+void apu::envelope::trigger(std::uint8_t nrx2)
+{
+    volume = nrx2 >> 4;
+    increase = nrx2 & (1 << 3);
+    period = nrx2 & 0x07;
+    timer = period;
+}
+
+void apu::envelope::clock()
+{
+    if (period == 0 || --timer != 0)
+    {
+        return;
+    }
+    timer = period;
+    if (increase && volume < 15)
+    {
+        ++volume;
+    }
+    else if (!increase && volume > 0)
+    {
+        --volume;
+    }
+}
+
+apu::apu()
+{
+    gb_cpu = nullptr;
+    reset();
+    connect(nullptr);
+}
+
+void apu::reset()
+{
+    registers.fill(0);
+    square1 = {};
+    square2 = {};
+    wave = {};
+    noise = {};
+    noise.lfsr = 0x7fff;
+
+    // state left behind by the DMG boot ROM
+    static constexpr std::array<std::uint8_t, 0x17> boot = {
+        0x80, 0xbf, 0xf3, 0xff, 0xbf,
+        0xff, 0x3f, 0x00, 0xff, 0xbf,
+        0x7f, 0xff, 0x9f, 0xff, 0xbf,
+        0xff, 0xff, 0x00, 0x00, 0xbf,
+        0x77, 0xf3, 0xf1};
+    std::copy(boot.begin(), boot.end(), registers.begin());
+    powered = true;
+    square1.enabled = true;
+    square1.duty = 2;
+    square1.frequency = 0x7ff;
+    square1.countdown = 4;
+    square1.sweep_timer = 8;
+    square2.countdown = 8192;
+    wave.countdown = 4096;
+    noise.countdown = 8;
+
+    sequencer_countdown = sequencer_period;
+    sequencer_step = 0;
+    time = gb_cpu != nullptr ? gb_cpu->get_timestamp() : 0;
+    frame_time = 0;
+    left_level = 0;
+    right_level = 0;
+}
+
+apu &apu::operator=(const apu &other)
+{
+    registers = other.registers;
+    powered = other.powered;
+    square1 = other.square1;
+    square2 = other.square2;
+    wave = other.wave;
+    noise = other.noise;
+    sequencer_countdown = other.sequencer_countdown;
+    sequencer_step = other.sequencer_step;
+    time = other.time;
+    frame_time = other.frame_time;
+    left_level = other.left_level;
+    right_level = other.right_level;
+    return *this;
+}
+
+void apu::connect_cpu(cpu *c)
+{
+    gb_cpu = c;
+    time = c->get_timestamp();
+}
+
+void apu::connect(audio_sink *s)
+{
+    sink = s != nullptr ? s : &silent;
+    sample_rate = sink->sample_rate();
+    synthesize = sample_rate != 0;
+    set_rate_ratio(1.0);
+}
+
+void apu::set_rate_ratio(double ratio)
+{
+    if (!synthesize)
+    {
+        return;
+    }
+    double rate = sample_rate * ratio;
+    size_t max_samples = static_cast<size_t>(rate * (max_frame_clocks / clock_rate)) + 2;
+    left.set_rates(clock_rate, rate, max_samples);
+    right.set_rates(clock_rate, rate, max_samples);
+    samples.resize(2 * max_samples);
+}
+
+std::uint8_t &apu::reg(std::uint16_t address)
+{
+    return registers[address - 0xff10];
+}
+
+void apu::catch_up()
+{
+    run(gb_cpu->get_timestamp());
+}
+
+void apu::run(std::uint64_t until)
+{
+    while (time < until)
+    {
+        std::uint64_t step = until - time;
+        if (powered)
+        {
+            step = std::min<std::uint64_t>(step, sequencer_countdown);
+        }
+        if (synthesize)
+        {
+            step = std::min<std::uint64_t>(step, max_frame_clocks - frame_time);
+            if (square1.enabled)
+            {
+                step = std::min<std::uint64_t>(step, square1.countdown);
+            }
+            if (square2.enabled)
+            {
+                step = std::min<std::uint64_t>(step, square2.countdown);
+            }
+            if (wave.enabled)
+            {
+                step = std::min<std::uint64_t>(step, wave.countdown);
+            }
+            if (noise.enabled)
+            {
+                step = std::min<std::uint64_t>(step, noise.countdown);
+            }
+        }
+        time += step;
+
+        // Without a listener only the sequencer matters: it drives the
+        // length counters, sweep and envelopes that software can observe.
+        if (synthesize)
+        {
+            frame_time += step;
+            for (square_channel *channel : {&square1, &square2})
+            {
+                if (channel->enabled && (channel->countdown -= step) == 0)
+                {
+                    channel->countdown = (2048 - channel->frequency) * 4;
+                    channel->step = (channel->step + 1) & 7;
+                }
+            }
+            if (wave.enabled && (wave.countdown -= step) == 0)
+            {
+                wave.countdown = (2048 - wave.frequency) * 2;
+                wave.position = (wave.position + 1) & 31;
+                std::uint8_t byte = registers[0x20 + wave.position / 2];
+                wave.sample = (wave.position & 1) ? (byte & 0x0f) : (byte >> 4);
+            }
+            if (noise.enabled && (noise.countdown -= step) == 0)
+            {
+                noise.countdown = noise_period();
+                std::uint16_t bit = (noise.lfsr ^ (noise.lfsr >> 1)) & 1;
+                noise.lfsr = (noise.lfsr >> 1) | (bit << 14);
+                if (reg(0xff22) & (1 << 3))
+                {
+                    noise.lfsr = (noise.lfsr & ~(1 << 6)) | (bit << 6);
+                }
+            }
+        }
+        if (powered && (sequencer_countdown -= step) == 0)
+        {
+            sequencer_countdown = sequencer_period;
+            clock_sequencer();
+        }
+        if (synthesize)
+        {
+            update_output();
+            if (frame_time == max_frame_clocks)
+            {
+                deliver();
+            }
+        }
+    }
+}
+
+void apu::clock_sequencer()
+{
+    if ((sequencer_step & 1) == 0)
+    {
+        clock_length();
+    }
+    if (sequencer_step == 2 || sequencer_step == 6)
+    {
+        clock_sweep();
+    }
+    if (sequencer_step == 7)
+    {
+        square1.env.clock();
+        square2.env.clock();
+        noise.env.clock();
+    }
+    sequencer_step = (sequencer_step + 1) & 7;
+}
+
+void apu::clock_length()
+{
+    auto clock = [](bool &enabled, std::uint16_t &length, std::uint8_t nrx4)
+    {
+        if ((nrx4 & (1 << 6)) && length > 0 && --length == 0)
+        {
+            enabled = false;
+        }
+    };
+    clock(square1.enabled, square1.length, reg(0xff14));
+    clock(square2.enabled, square2.length, reg(0xff19));
+    clock(wave.enabled, wave.length, reg(0xff1e));
+    clock(noise.enabled, noise.length, reg(0xff23));
+}
+
+std::uint16_t apu::sweep_target()
+{
+    std::uint8_t nr10 = reg(0xff10);
+    std::uint16_t delta = square1.sweep_shadow >> (nr10 & 0x07);
+    return (nr10 & (1 << 3)) ? square1.sweep_shadow - delta : square1.sweep_shadow + delta;
+}
+
+void apu::clock_sweep()
+{
+    std::uint8_t nr10 = reg(0xff10);
+    std::uint8_t period = (nr10 >> 4) & 0x07;
+    if (--square1.sweep_timer != 0)
+    {
+        return;
+    }
+    square1.sweep_timer = period != 0 ? period : 8;
+    if (!square1.sweep_enabled || period == 0)
+    {
+        return;
+    }
+    std::uint16_t target = sweep_target();
+    if (target > 2047)
+    {
+        square1.enabled = false;
+    }
+    else if ((nr10 & 0x07) != 0)
+    {
+        square1.sweep_shadow = target;
+        square1.frequency = target;
+        reg(0xff13) = target & 0xff;
+        reg(0xff14) = (reg(0xff14) & ~0x07) | (target >> 8);
+        if (sweep_target() > 2047)
+        {
+            square1.enabled = false;
+        }
+    }
+}
+
+std::uint32_t apu::noise_period()
+{
+    std::uint8_t nr43 = reg(0xff22);
+    return noise_divisors[nr43 & 0x07] << (nr43 >> 4);
+}
+
+void apu::update_output()
+{
+    std::array<std::int32_t, 4> levels = {
+        square1.enabled && ((duty_patterns[square1.duty] >> square1.step) & 1) ? square1.env.volume : 0,
+        square2.enabled && ((duty_patterns[square2.duty] >> square2.step) & 1) ? square2.env.volume : 0,
+        wave.enabled ? wave.sample >> wave_shifts[(reg(0xff1c) >> 5) & 0x03] : 0,
+        noise.enabled && (~noise.lfsr & 1) ? noise.env.volume : 0};
+
+    std::uint8_t nr50 = reg(0xff24);
+    std::uint8_t nr51 = reg(0xff25);
+    std::int32_t l = 0;
+    std::int32_t r = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        l += (nr51 & (0x10 << i)) ? levels[i] : 0;
+        r += (nr51 & (0x01 << i)) ? levels[i] : 0;
+    }
+    l *= (((nr50 >> 4) & 0x07) + 1) * volume_scale;
+    r *= ((nr50 & 0x07) + 1) * volume_scale;
+
+    if (l != left_level)
+    {
+        left.add_delta(frame_time, l - left_level);
+        left_level = l;
+    }
+    if (r != right_level)
+    {
+        right.add_delta(frame_time, r - right_level);
+        right_level = r;
+    }
+}
+
+void apu::trigger_square(square_channel &channel, std::uint16_t base)
+{
+    channel.enabled = (reg(base + 2) & 0xf8) != 0;
+    if (channel.length == 0)
+    {
+        channel.length = 64;
+    }
+    channel.countdown = (2048 - channel.frequency) * 4;
+    channel.env.trigger(reg(base + 2));
+    if (&channel == &square1)
+    {
+        std::uint8_t nr10 = reg(0xff10);
+        std::uint8_t period = (nr10 >> 4) & 0x07;
+        square1.sweep_shadow = square1.frequency;
+        square1.sweep_timer = period != 0 ? period : 8;
+        square1.sweep_enabled = period != 0 || (nr10 & 0x07) != 0;
+        if ((nr10 & 0x07) != 0 && sweep_target() > 2047)
+        {
+            square1.enabled = false;
+        }
+    }
+}
+
+void apu::trigger_wave()
+{
+    wave.enabled = (reg(0xff1a) & (1 << 7)) != 0;
+    if (wave.length == 0)
+    {
+        wave.length = 256;
+    }
+    wave.countdown = (2048 - wave.frequency) * 2;
+    wave.position = 0;
+}
+
+void apu::trigger_noise()
+{
+    noise.enabled = (reg(0xff21) & 0xf8) != 0;
+    if (noise.length == 0)
+    {
+        noise.length = 64;
+    }
+    noise.countdown = noise_period();
+    noise.lfsr = 0x7fff;
+    noise.env.trigger(reg(0xff21));
+}
+
+void apu::power_off()
+{
+    std::fill(registers.begin(), registers.begin() + 0x16, 0);
+    square1.enabled = false;
+    square2.enabled = false;
+    wave.enabled = false;
+    noise.enabled = false;
+    powered = false;
+}
+
+std::uint8_t apu::read(std::uint16_t address)
+{
+    catch_up();
+    if (address >= 0xff30)
+    {
+        return reg(address);
+    }
+    if (address == 0xff26)
+    {
+        return (powered << 7) | 0x70 | (noise.enabled << 3) | (wave.enabled << 2) | (square2.enabled << 1) | square1.enabled;
+    }
+    if (address > 0xff26)
+    {
+        return 0xff;
+    }
+    return reg(address) | read_masks[address - 0xff10];
+}
+
+void apu::write(std::uint16_t address, std::uint8_t data)
+{
+    catch_up();
+    if (address >= 0xff30)
+    {
+        reg(address) = data;
+        return;
+    }
+    if (address == 0xff26)
+    {
+        if (powered && !(data & (1 << 7)))
+        {
+            power_off();
+        }
+        else if (!powered && (data & (1 << 7)))
+        {
+            powered = true;
+            sequencer_step = 0;
+            sequencer_countdown = sequencer_period;
+        }
+        reg(address) = data & (1 << 7);
+        if (synthesize)
+        {
+            update_output();
+        }
+        return;
+    }
+    if (!powered || address > 0xff26)
+    {
+        return;
+    }
+    reg(address) = data;
+
+    switch (address)
+    {
+    case 0xff11:
+    case 0xff16:
+    {
+        square_channel &channel = address == 0xff11 ? square1 : square2;
+        channel.duty = data >> 6;
+        channel.length = 64 - (data & 0x3f);
+        break;
+    }
+    case 0xff12:
+    case 0xff17:
+        if ((data & 0xf8) == 0)
+        {
+            (address == 0xff12 ? square1 : square2).enabled = false;
+        }
+        break;
+    case 0xff13:
+    case 0xff18:
+    {
+        square_channel &channel = address == 0xff13 ? square1 : square2;
+        channel.frequency = (channel.frequency & 0x700) | data;
+        break;
+    }
+    case 0xff14:
+    case 0xff19:
+    {
+        square_channel &channel = address == 0xff14 ? square1 : square2;
+        channel.frequency = (channel.frequency & 0xff) | ((data & 0x07) << 8);
+        if (data & (1 << 7))
+        {
+            trigger_square(channel, address - 4);
+        }
+        break;
+    }
+    case 0xff1a:
+        if (!(data & (1 << 7)))
+        {
+            wave.enabled = false;
+        }
+        break;
+    case 0xff1b:
+        wave.length = 256 - data;
+        break;
+    case 0xff1d:
+        wave.frequency = (wave.frequency & 0x700) | data;
+        break;
+    case 0xff1e:
+        wave.frequency = (wave.frequency & 0xff) | ((data & 0x07) << 8);
+        if (data & (1 << 7))
+        {
+            trigger_wave();
+        }
+        break;
+    case 0xff20:
+        noise.length = 64 - (data & 0x3f);
+        break;
+    case 0xff21:
+        if ((data & 0xf8) == 0)
+        {
+            noise.enabled = false;
+        }
+        break;
+    case 0xff23:
+        if (data & (1 << 7))
+        {
+            trigger_noise();
+        }
+        break;
+    }
+
+    if (synthesize)
+    {
+        update_output();
+    }
+}
+
+void apu::deliver()
+{
+    left.end_frame(frame_time);
+    right.end_frame(frame_time);
+    frame_time = 0;
+    size_t frames = left.read(samples.data(), samples.size() / 2, 2);
+    right.read(samples.data() + 1, frames, 2);
+    sink->write(samples.data(), frames);
+}
+
+void apu::end_frame()
+{
+    catch_up();
+    if (synthesize)
+    {
+        deliver();
+    }
+}
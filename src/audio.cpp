@@ -0,0 +1,91 @@
+#include <cstdint>
+#include <cstring>
+#include <SDL.h>
+
+#include "audio.h"
+
+std::uint32_t null_audio_sink::sample_rate()
+{
+    return 0;
+}
+
+void null_audio_sink::write(const std::int16_t *, size_t)
+{
+}
+
+// About 170 ms of stereo at 48 kHz.
+sdl_audio_sink::sdl_audio_sink() : ring(16384)
+{
+    device = 0;
+    rate = 0;
+    underrun_count.store(0);
+}
+
+sdl_audio_sink::~sdl_audio_sink()
+{
+    if (device != 0)
+    {
+        SDL_CloseAudioDevice(device);
+    }
+}
+
+bool sdl_audio_sink::open(std::uint32_t requested_rate)
+{
+    SDL_AudioSpec want;
+    SDL_AudioSpec have;
+    std::memset(&want, 0, sizeof(want));
+    want.freq = requested_rate;
+    want.format = AUDIO_S16SYS;
+    want.channels = 2;
+    want.samples = 512;
+    want.callback = callback;
+    want.userdata = this;
+    device = SDL_OpenAudioDevice(NULL, 0, &want, &have, 0);
+    if (device == 0)
+    {
+        return false;
+    }
+    rate = have.freq;
+    SDL_PauseAudioDevice(device, 0);
+    return true;
+}
+
+void sdl_audio_sink::callback(void *userdata, Uint8 *stream, int length)
+{
+    sdl_audio_sink *sink = static_cast<sdl_audio_sink *>(userdata);
+    std::int16_t *samples = reinterpret_cast<std::int16_t *>(stream);
+    size_t count = length / sizeof(std::int16_t);
+    size_t read = sink->ring.pop(samples, count);
+    if (read < count)
+    {
+        sink->underrun_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::memset(samples + read, 0, (count - read) * sizeof(std::int16_t));
+}
+
+std::uint32_t sdl_audio_sink::sample_rate()
+{
+    return rate;
+}
+
+void sdl_audio_sink::write(const std::int16_t *samples, size_t frames)
+{
+    // the emulator runs ahead of the device when the ring is full; the
+    // excess is dropped
+    ring.push(samples, frames * 2);
+}
+
+size_t sdl_audio_sink::queued_frames()
+{
+    return ring.size() / 2;
+}
+
+size_t sdl_audio_sink::capacity_frames()
+{
+    return ring.capacity() / 2;
+}
+
+std::uint64_t sdl_audio_sink::underruns()
+{
+    return underrun_count.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,81 @@
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "blip.h"
+
+// Blackman-windowed sinc, cut off a little below the output Nyquist rate.
+// Each phase is normalised to exactly 1 << kernel_bits so a step always
+// settles at its full height.
+const std::array<std::array<std::int32_t, blip_buffer::taps>, blip_buffer::phases> blip_buffer::kernel = []()
+{
+    std::array<std::array<std::int32_t, taps>, phases> table;
+    const double pi = 3.14159265358979323846;
+    const double cutoff = 0.9;
+    for (int phase = 0; phase < phases; ++phase)
+    {
+        std::array<double, taps> h;
+        double sum = 0;
+        for (int i = 0; i < taps; ++i)
+        {
+            double t = i - (taps / 2 - 1) - static_cast<double>(phase) / phases;
+            double x = pi * cutoff * t;
+            double sinc = x == 0 ? 1.0 : std::sin(x) / x;
+            double window = 0.42 + 0.5 * std::cos(2 * pi * t / taps) + 0.08 * std::cos(4 * pi * t / taps);
+            h[i] = sinc * window;
+            sum += h[i];
+        }
+        std::int32_t total = 0;
+        for (int i = 0; i < taps; ++i)
+        {
+            table[phase][i] = std::lround(h[i] / sum * (1 << kernel_bits));
+            total += table[phase][i];
+        }
+        table[phase][taps / 2 - 1] += (1 << kernel_bits) - total;
+    }
+    return table;
+}();
+
+blip_buffer::blip_buffer()
+{
+    factor = 0;
+    offset = 0;
+    integrator = 0;
+}
+
+void blip_buffer::set_rates(double clock_rate, double sample_rate, size_t max_samples)
+{
+    factor = static_cast<std::uint64_t>(sample_rate / clock_rate * 4294967296.0 + 0.5);
+    if (deltas.size() < 2 * max_samples + taps)
+    {
+        deltas.resize(2 * max_samples + taps, 0);
+    }
+}
+
+void blip_buffer::end_frame(std::uint32_t time)
+{
+    offset += time * factor;
+}
+
+size_t blip_buffer::available()
+{
+    return offset >> frac_bits;
+}
+
+size_t blip_buffer::read(std::int16_t *out, size_t count, size_t stride)
+{
+    count = std::min(count, available());
+    for (size_t i = 0; i < count; ++i)
+    {
+        integrator += deltas[i];
+        std::int64_t sample = integrator >> kernel_bits;
+        out[i * stride] = static_cast<std::int16_t>(std::clamp<std::int64_t>(sample, -32768, 32767));
+        integrator -= integrator >> 9;
+    }
+    std::copy(deltas.begin() + count, deltas.begin() + available() + taps, deltas.begin());
+    std::fill(deltas.begin() + available() - count + taps, deltas.begin() + available() + taps, 0);
+    offset -= static_cast<std::uint64_t>(count) << frac_bits;
+    return count;
+}
@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "block_index.h"
+
+block_index::block_index()
+{
+    rom_checksum = 0;
+}
+
+bool block_index::load(const std::string &path)
+{
+    std::ifstream input(path, std::ios::binary);
+    block_index_header header;
+    if (!input.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != block_index_magic ||
+        header.record_size != sizeof(block_record))
+    {
+        return false;
+    }
+    blocks.resize(header.count);
+    rom_checksum = header.rom_checksum;
+    return static_cast<bool>(
+        input.read(reinterpret_cast<char *>(blocks.data()), blocks.size() * sizeof(block_record)));
+}
+
+bool block_index::save(const std::string &path)
+{
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    block_index_header header = {};
+    header.magic = block_index_magic;
+    header.version = 1;
+    header.record_size = sizeof(block_record);
+    header.rom_checksum = rom_checksum;
+    header.count = blocks.size();
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char *>(blocks.data()), blocks.size() * sizeof(block_record));
+    return static_cast<bool>(output);
+}
+
+const block_record *block_index::find(std::uint16_t bank, std::uint16_t address) const
+{
+    auto found = std::lower_bound(blocks.begin(), blocks.end(), std::make_pair(bank, address),
+                                  [](const block_record &block, const std::pair<std::uint16_t, std::uint16_t> &key) {
+                                      return std::make_pair(block.bank, block.address) < key;
+                                  });
+    if (found == blocks.end() || found->bank != bank || found->address != address)
+    {
+        return nullptr;
+    }
+    return &*found;
+}
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "breakpoints.h"
+
+breakpoint_map::breakpoint_map() : rom(rom_banks * bank_words, 0)
+{
+    ram.fill(0);
+    resuming = false;
+    stepping = false;
+    pending = false;
+    stopped = false;
+}
+
+std::uint64_t &breakpoint_map::word(std::uint16_t address, std::uint16_t bank)
+{
+    if (address >= 0x8000)
+    {
+        return ram[(address - 0x8000) >> 6];
+    }
+    return rom[(bank & (rom_banks - 1)) * bank_words + ((address & 0x3fff) >> 6)];
+}
+
+bool breakpoint_map::arrive(bool set)
+{
+    if (resuming)
+    {
+        resuming = false;
+        pending = stepping;
+        return false;
+    }
+    if (!set && !stepping)
+    {
+        return false;
+    }
+    stepping = false;
+    pending = false;
+    stopped = true;
+    return true;
+}
+
+void breakpoint_map::set(std::uint16_t address, std::uint16_t bank)
+{
+    if (address < 0x8000 && bank == any_bank)
+    {
+        for (std::uint16_t b = 0; b < rom_banks; ++b)
+        {
+            set(address, b);
+        }
+        return;
+    }
+    word(address, bank) |= std::uint64_t(1) << (address & 63);
+}
+
+void breakpoint_map::clear(std::uint16_t address, std::uint16_t bank)
+{
+    if (address < 0x8000 && bank == any_bank)
+    {
+        for (std::uint16_t b = 0; b < rom_banks; ++b)
+        {
+            clear(address, b);
+        }
+        return;
+    }
+    word(address, bank) &= ~(std::uint64_t(1) << (address & 63));
+}
+
+void breakpoint_map::clear_all()
+{
+    std::fill(rom.begin(), rom.end(), 0);
+    ram.fill(0);
+}
+
+void breakpoint_map::resume()
+{
+    resuming = stopped;
+    stepping = false;
+    pending = resuming;
+    stopped = false;
+}
+
+void breakpoint_map::step()
+{
+    resume();
+    // the instruction at PC runs even when nothing stopped in front of it,
+    // e.g. at the start of a session or after a frame
+    resuming = true;
+    stepping = true;
+    pending = true;
+}
+
+bool breakpoint_map::is_stopped()
+{
+    return stopped;
+}
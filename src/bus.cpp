@@ -13,144 +13,452 @@
 #include <bitset>
 
 #include "bus.h"
+#include "serial.h"
+#include "apu.h"
+#include "cpu.h"
+
+// IO registers as the DMG boot ROM hands them over
+static constexpr std::array<std::uint8_t, 0x80> post_boot_io = []
+{
+    std::array<std::uint8_t, 0x80> io = {};
+    io[0x00] = 0xcf;
+    io[0x02] = 0x7e;
+    io[0x04] = 0xab;
+    io[0x07] = 0xf8;
+    io[0x0f] = 0xe1;
+    io[0x40] = 0x91;
+    io[0x41] = 0x85;
+    io[0x46] = 0xff;
+    io[0x47] = 0xfc;
+    io[0x48] = 0xff;
+    io[0x49] = 0xff;
+    io[0x4d] = 0xff;
+    io[0x4f] = 0xff;
+    io[0x51] = 0xff;
+    io[0x52] = 0xff;
+    io[0x53] = 0xff;
+    io[0x54] = 0xff;
+    io[0x55] = 0xff;
+    io[0x56] = 0xff;
+    io[0x68] = 0xff;
+    io[0x69] = 0xff;
+    io[0x6a] = 0xff;
+    io[0x6b] = 0xff;
+    io[0x70] = 0xff;
+    return io;
+}();
+
+// and as they power up, for a boot ROM to set up; it turns the LCD on and
+// sets the palette itself
+static constexpr std::array<std::uint8_t, 0x80> power_on_io = []
+{
+    std::array<std::uint8_t, 0x80> io = post_boot_io;
+    io[0x04] = 0x00;
+    io[0x0f] = 0xe0;
+    io[0x40] = 0x00;
+    io[0x41] = 0x80;
+    io[0x47] = 0x00;
+    return io;
+}();
+
+bus::bus(bus_state &s, std::array<std::uint8_t, 0x80> &io, memory_arena &memory)
+    : state(s), io_registers(io), arena(memory)
+{
+    rom_image = std::make_shared<const std::vector<std::uint8_t>>(0x8000, 0xff);
+    rom = rom_image->data();
+    arena.vram.assign(0x4000, 0);
+    arena.wram.assign(0x8000, 0);
+    arena.ext_ram.assign(0x2000, 0);
 
-bus::bus()
-{
-    vram.fill(0);
-    wram.fill(0);
-    oam.fill(0);
-    hram.fill(0);
-    for (size_t i = 0; i < 0x2000; ++i)
-    {
-        ext_ram.push_back(0);
-    }
-    io_registers.fill(0);
-    io_registers[0x00] = 0xcf;
-    io_registers[0x01] = 0x00;
-    io_registers[0x02] = 0x7e;
-    io_registers[0x04] = 0xAB;
-    io_registers[0x05] = 0x00;
-    io_registers[0x06] = 0x00;
-    io_registers[0x07] = 0xf8;
-    io_registers[0x0f] = 0xe1;
-    io_registers[0x10] = 0x80;
-    io_registers[0x11] = 0xbf;
-    io_registers[0x12] = 0xf3;
-    io_registers[0x13] = 0xff;
-    io_registers[0x14] = 0xbf;
-    io_registers[0x16] = 0x3f;
-    io_registers[0x17] = 0x00;
-    io_registers[0x18] = 0xff;
-    io_registers[0x19] = 0xbf;
-    io_registers[0x1a] = 0x7f;
-    io_registers[0x1b] = 0xff;
-    io_registers[0x1c] = 0x9f;
-    io_registers[0x1d] = 0xff;
-    io_registers[0x1e] = 0xbf;
-    io_registers[0x20] = 0xff;
-    io_registers[0x21] = 0x00;
-    io_registers[0x22] = 0x00;
-    io_registers[0x23] = 0xbf;
-    io_registers[0x24] = 0x77;
-    io_registers[0x25] = 0xf3;
-    io_registers[0x26] = 0xf1;
-    io_registers[0x40] = 0x91;
-    io_registers[0x41] = 0x85;
-    io_registers[0x42] = 0x00;
-    io_registers[0x43] = 0x00;
-    io_registers[0x44] = 0x00;
-    io_registers[0x45] = 0x00;
-    io_registers[0x46] = 0xff;
-    io_registers[0x47] = 0xfc;
-    io_registers[0x48] = 0xff;
-    io_registers[0x49] = 0xff;
-    io_registers[0x4a] = 0x00;
-    io_registers[0x4b] = 0x00;
-    io_registers[0x4d] = 0xff;
-    io_registers[0x4f] = 0xff;
-    io_registers[0x51] = 0xff;
-    io_registers[0x52] = 0xff;
-    io_registers[0x53] = 0xff;
-    io_registers[0x54] = 0xff;
-    io_registers[0x55] = 0xff;
-    io_registers[0x56] = 0xff;
-    io_registers[0x68] = 0xff;
-    io_registers[0x69] = 0xff;
-    io_registers[0x6a] = 0xff;
-    io_registers[0x6b] = 0xff;
-    io_registers[0x70] = 0xff;
-    ie_register = 0x00;
-
-    rom_bank_index = 1;
-    rom_bank_0_index = 0;
-    ext_ram_bank_index = 0;
     n_rom_banks = 2;
     n_ram_banks = 0;
-    ram_enabled = false;
-    banking_mode = 0;
-
     cartridge_type = 0x00;
+    cgb_mode = false;
+
+    gb_serial = nullptr;
+    gb_apu = nullptr;
+    gb_cpu = nullptr;
+
+    watched_pages.fill(false);
+    next_watch_id = 1;
+
+#ifdef GB_INSTRUMENT
+    profile = nullptr;
+#endif
+    reset();
+}
+
+bus &bus::operator=(const bus &other)
+{
+    rom_image = other.rom_image;
+    rom = other.rom;
+    boot_image = other.boot_image;
+    n_rom_banks = other.n_rom_banks;
+    n_ram_banks = other.n_ram_banks;
+    cartridge_type = other.cartridge_type;
+    cgb_mode = other.cgb_mode;
+    bg_palettes = other.bg_palettes;
+    obj_palettes = other.obj_palettes;
+    bg_palette_index = other.bg_palette_index;
+    obj_palette_index = other.obj_palette_index;
+    pages = other.pages;
+    return *this;
+}
+
+void bus::reset()
+{
+    state.boot_mapped = boot_image != nullptr;
+    arena.vram.fill(0);
+    arena.wram.fill(0);
+    arena.oam.fill(0);
+    arena.hram.fill(0);
+    io_registers = state.boot_mapped ? power_on_io : post_boot_io;
+    state.ie_register = 0x00;
+
+    state.rom_bank_index = 1;
+    state.rom_bank_0_index = 0;
+    state.ext_ram_bank_index = 0;
+    state.ram_enabled = false;
+    state.banking_mode = 0;
+
+    state.dma_cycle = 0;
 
-    dma_cycle = 0;
+    state.vram_bank = 0;
+    state.wram_bank = 1;
+    state.double_speed = false;
+    state.speed_switch_armed = false;
+    bg_palettes.fill(0xff);
+    obj_palettes.fill(0xff);
+    bg_palette_index = 0;
+    obj_palette_index = 0;
+    state.hdma_source = 0;
+    state.hdma_destination = 0;
+    state.hdma_blocks = 0;
+
+    state.buttons = 0;
+    watch_paused = false;
+    remap();
 }
 
 void bus::dma_clock()
 {
-    if (dma_cycle > 0)
+    if (state.dma_cycle > 0)
     {
-        --dma_cycle;
+        --state.dma_cycle;
     }
 }
 
 std::uint8_t bus::read(std::uint16_t address)
+{
+#ifdef GB_INSTRUMENT
+    if (profile != nullptr)
+    {
+        std::uint64_t start = host_ticks();
+        std::uint8_t data = read_memory(address);
+        profile->read_ticks += host_ticks() - start;
+        ++profile->read_calls;
+        return data;
+    }
+#endif
+    return read_memory(address);
+}
+
+void bus::write(std::uint16_t address, std::uint8_t data)
+{
+#ifdef GB_INSTRUMENT
+    if (profile != nullptr)
+    {
+        std::uint64_t start = host_ticks();
+        write_memory(address, data);
+        profile->write_ticks += host_ticks() - start;
+        ++profile->write_calls;
+        return;
+    }
+#endif
+    write_memory(address, data);
+}
+
+bus::page_map::page_map() : copies(0)
+{
+    read.fill(nullptr);
+    write.fill(nullptr);
+    copies_seen = 0;
+}
+
+bus::page_map::page_map(const page_map &other) : copies(0)
+{
+    read = other.read;
+    write.fill(nullptr);
+    copies_seen = 0;
+    other.copies.fetch_add(1, std::memory_order_relaxed);
+}
+
+bus::page_map &bus::page_map::operator=(const page_map &other)
+{
+    read = other.read;
+    write.fill(nullptr);
+    other.copies.fetch_add(1, std::memory_order_relaxed);
+    return *this;
+}
+
+void bus::map(std::uint8_t first_page, std::uint8_t count, const std::uint8_t *read, std::uint8_t *write)
+{
+    for (std::uint8_t i = 0; i < count; ++i)
+    {
+        std::uint8_t page = first_page + i;
+        bool direct = !watched_pages[page];
+        pages.read[page] = direct && read != nullptr ? read + i * 0x100 : nullptr;
+        pages.write[page] = direct && write != nullptr ? write + i * 0x100 : nullptr;
+    }
+}
+
+// Shared pages are only mapped for reading; the first write takes the slow
+// path, which clones the page and maps it again.
+template <size_t n>
+void bus::map_ram(std::uint8_t first_page, std::uint8_t count, ram<n> &memory, size_t index)
+{
+    if (index >= memory.size())
+    {
+        map(first_page, count, nullptr, nullptr);
+        return;
+    }
+    map(first_page, count, memory.data(index), memory.owns(index) ? &memory.writable(index) : nullptr);
+}
+
+void bus::map_rom()
+{
+    size_t bank_0 = state.banking_mode == 0 ? 0 : state.rom_bank_0_index * 0x4000;
+    size_t bank = state.rom_bank_index * 0x4000;
+    map(0x00, 0x40, bank_0 + 0x4000 <= rom_image->size() ? rom + bank_0 : nullptr, nullptr);
+    map(0x40, 0x40, bank + 0x4000 <= rom_image->size() ? rom + bank : nullptr, nullptr);
+    if (state.boot_mapped)
+    {
+        // the cartridge header at 0x0100-0x01ff stays visible
+        map(0x00, 0x01, boot_image->data(), nullptr);
+        if (boot_image->size() > 0x200)
+        {
+            map(0x02, (boot_image->size() - 0x200) >> 8, boot_image->data() + 0x200, nullptr);
+        }
+    }
+}
+
+void bus::map_vram()
+{
+    map_ram(0x80, 0x10, arena.vram, state.vram_bank << 13);
+    map_ram(0x90, 0x10, arena.vram, (state.vram_bank << 13) + 0x1000);
+}
+
+void bus::map_ext_ram()
+{
+    size_t base = state.banking_mode == 0 ? 0 : state.ext_ram_bank_index * 0x2000;
+    if (!state.ram_enabled)
+    {
+        map(0xa0, 0x20, nullptr, nullptr);
+        return;
+    }
+    map_ram(0xa0, 0x10, arena.ext_ram, base);
+    map_ram(0xb0, 0x10, arena.ext_ram, base + 0x1000);
+}
+
+void bus::map_wram()
+{
+    map_ram(0xc0, 0x10, arena.wram, 0);
+    map_ram(0xd0, 0x10, arena.wram, state.wram_bank << 12);
+    // echo RAM up to OAM
+    map_ram(0xe0, 0x10, arena.wram, 0);
+    map_ram(0xf0, 0x0e, arena.wram, state.wram_bank << 12);
+}
+
+void bus::remap()
+{
+    map_rom();
+    map_vram();
+    map_ext_ram();
+    map_wram();
+}
+
+// Maps the page again if it was just cloned, or has become private since it
+// was last mapped (its copies are gone).
+template <size_t n>
+void bus::write_ram(ram<n> &memory, size_t index, std::uint16_t address, std::uint8_t data)
+{
+    memory.writable(index) = data;
+    if (pages.write[address >> 8] == nullptr && !watched_pages[address >> 8])
+    {
+        remap();
+    }
+}
+
+std::uint32_t bus::add_watchpoint(const watchpoint &w)
+{
+    watchpoints.push_back({next_watch_id, w});
+    for (unsigned page = w.first >> 8; page <= static_cast<unsigned>(w.last >> 8); ++page)
+    {
+        watched_pages[page] = true;
+    }
+    remap();
+    return next_watch_id++;
+}
+
+void bus::remove_watchpoint(std::uint32_t id)
+{
+    watchpoints.erase(std::remove_if(watchpoints.begin(), watchpoints.end(),
+                                     [id](const watch_entry &entry) { return entry.id == id; }),
+                      watchpoints.end());
+    watched_pages.fill(false);
+    for (const watch_entry &entry : watchpoints)
+    {
+        for (unsigned page = entry.point.first >> 8; page <= static_cast<unsigned>(entry.point.last >> 8); ++page)
+        {
+            watched_pages[page] = true;
+        }
+    }
+    remap();
+}
+
+void bus::clear_watchpoints()
+{
+    watchpoints.clear();
+    watched_pages.fill(false);
+    remap();
+}
+
+bool bus::watching()
+{
+    return !watchpoints.empty();
+}
+
+bool bus::paused()
+{
+    return watch_paused;
+}
+
+void bus::resume()
+{
+    watch_paused = false;
+}
+
+void bus::check_watchpoints(std::uint16_t address, std::uint8_t access, std::uint8_t value, std::uint8_t previous)
+{
+    watch_hit hit = {address, access, value, previous};
+    for (watch_entry &entry : watchpoints)
+    {
+        const watchpoint &w = entry.point;
+        if (!(w.access & access) || address < w.first || address > w.last)
+        {
+            continue;
+        }
+        if (w.condition && !w.condition(hit))
+        {
+            continue;
+        }
+        if (!w.callback || w.callback(hit))
+        {
+            watch_paused = true;
+        }
+    }
+}
+
+// 0xc000-0xcfff is always bank 0; 0xd000-0xdfff is the SVBK bank (1 on DMG).
+// Echo RAM at 0xe000 mirrors both.
+std::uint16_t bus::wram_index(std::uint16_t address)
+{
+    address &= 0x1fff;
+    return address < 0x1000 ? address : (state.wram_bank << 12) | (address - 0x1000);
+}
+
+std::uint8_t bus::peek(std::uint16_t address)
+{
+    return read_region(address);
+}
+
+void bus::poke(std::uint16_t address, std::uint8_t data)
+{
+    write_region(address, data);
+}
+
+std::uint8_t bus::read_unmapped(std::uint16_t address)
+{
+    if (!watched_pages[address >> 8])
+    {
+        return read_region(address);
+    }
+    std::uint8_t data = read_region(address);
+    check_watchpoints(address, watch_access::read, data, data);
+    return data;
+}
+
+void bus::write_unmapped(std::uint16_t address, std::uint8_t data)
+{
+    if (!pages.current())
+    {
+        // copied since the write pages were mapped; they may be shared now
+        pages.copies_seen = pages.copies.load(std::memory_order_relaxed);
+        remap();
+    }
+    if (!watched_pages[address >> 8])
+    {
+        write_region(address, data);
+        return;
+    }
+    std::uint8_t previous = read_region(address);
+    write_region(address, data);
+    check_watchpoints(address, watch_access::write, data, previous);
+}
+
+std::uint8_t bus::read_region(std::uint16_t address)
 {
     if (0x0000 <= address && address <= 0x3fff)
     {
-        if (banking_mode == 0)
+        if (state.boot_mapped && (address < 0x0100 || (0x0200 <= address && address < boot_image->size())))
+        {
+            return (*boot_image)[address];
+        }
+        if (state.banking_mode == 0)
         {
             return rom[address];
         }
         else
         {
-            return rom[rom_bank_0_index * 0x4000 + address];
+            return rom[state.rom_bank_0_index * 0x4000 + address];
         }
     }
 
     else if (0x4000 <= address && address <= 0x7fff)
     {
-        return rom[rom_bank_index * 0x4000 + (address - 0x4000)];
+        return rom[state.rom_bank_index * 0x4000 + (address - 0x4000)];
     }
 
     else if (0x8000 <= address && address <= 0x9fff)
     {
-        return vram[address - 0x8000];
+        return arena.vram[(state.vram_bank << 13) | (address - 0x8000)];
     }
 
-    else if (0xa000 <= address && address <= 0xbfff && ram_enabled)
+    else if (0xa000 <= address && address <= 0xbfff && state.ram_enabled)
     {
-        if (banking_mode == 0)
+        if (state.banking_mode == 0)
         {
-            return ext_ram[address - 0xa000];
+            return arena.ext_ram[address - 0xa000];
         }
         else
         {
-            return ext_ram[ext_ram_bank_index * 0x2000 + (address - 0xa000)];
+            return arena.ext_ram[state.ext_ram_bank_index * 0x2000 + (address - 0xa000)];
         }
     }
 
     else if (0xc000 <= address && address <= 0xdfff)
     {
-        return wram[address - 0xc000];
+        return arena.wram[wram_index(address)];
     }
 
     else if (0xe000 <= address && address <= 0xfdff)
     {
-        return wram[address - 0xe000];
+        return arena.wram[wram_index(address)];
     }
 
     else if (0xfe00 <= address && address <= 0xfe9f)
     {
-        return oam[address - 0xfe00];
+        return arena.oam[address - 0xfe00];
     }
 
     else if (0xfea0 <= address && address <= 0xfeff)
@@ -158,6 +466,26 @@ std::uint8_t bus::read(std::uint16_t address)
         return 0x00;
     }
 
+    else if (address == 0xff01 || address == 0xff02)
+    {
+        return gb_serial->read(address);
+    }
+
+    else if (0xff10 <= address && address <= 0xff3f)
+    {
+        return gb_apu->read(address);
+    }
+
+    else if (0xff4d <= address && address <= 0xff70 && cgb_mode)
+    {
+        return read_cgb_register(address);
+    }
+
+    else if (address == 0xff00)
+    {
+        return (io_registers[0] & 0xf0) | joypad_lines();
+    }
+
     else if (0xff00 <= address && address <= 0xff7f)
     {
         return io_registers[address - 0xff00];
@@ -165,26 +493,28 @@ std::uint8_t bus::read(std::uint16_t address)
 
     else if (0xff80 <= address && address <= 0xfffe)
     {
-        return hram[address - 0xff80];
+        return arena.hram[address - 0xff80];
     }
 
     else if (address == 0xffff)
     {
-        return ie_register;
+        return state.ie_register;
     }
+
+    return 0xff;
 }
 
-void bus::write(std::uint16_t address, std::uint8_t data)
+void bus::write_region(std::uint16_t address, std::uint8_t data)
 {
     if (0x0000 <= address && address <= 0x1fff)
     {
         if ((data & 0xf) == 0x0a)
         {
-            ram_enabled = true;
+            state.ram_enabled = true;
         }
         else
         {
-            ram_enabled = false;
+            state.ram_enabled = false;
         }
     }
 
@@ -200,11 +530,11 @@ void bus::write(std::uint16_t address, std::uint8_t data)
             data = data & (0b11111 >> (5 - n_relevant_bits));
             if (data == 0)
             {
-                rom_bank_index = 1;
+                state.rom_bank_index = 1;
             }
             else
             {
-                rom_bank_index = data;
+                state.rom_bank_index = data;
             }
         }
         else
@@ -212,11 +542,11 @@ void bus::write(std::uint16_t address, std::uint8_t data)
             data = data & 0b11111;
             if (data == 0)
             {
-                rom_bank_index = (rom_bank_index & (11 << 5)) | 1;
+                state.rom_bank_index = (state.rom_bank_index & (11 << 5)) | 1;
             }
             else
             {
-                rom_bank_index = (rom_bank_index & (11 << 5)) | data;
+                state.rom_bank_index = (state.rom_bank_index & (11 << 5)) | data;
             }
         }
     }
@@ -226,51 +556,51 @@ void bus::write(std::uint16_t address, std::uint8_t data)
         data = data & 0b11;
         if (n_rom_banks >= 64)
         {
-            rom_bank_index = (rom_bank_index & 0b11111) | (data << 5);
-            rom_bank_0_index = (data << 5);
+            state.rom_bank_index = (state.rom_bank_index & 0b11111) | (data << 5);
+            state.rom_bank_0_index = (data << 5);
         }
         if (n_ram_banks >= 4)
         {
-            ext_ram_bank_index = data;
+            state.ext_ram_bank_index = data;
         }
     }
 
     else if (0x6000 <= address && address <= 0x7fff)
     {
         data = data & 0b1;
-        banking_mode = data;
+        state.banking_mode = data;
     }
 
     else if (0x8000 <= address && address <= 0x9fff)
     {
-        vram[address - 0x8000] = data;
+        write_ram(arena.vram, (state.vram_bank << 13) | (address - 0x8000), address, data);
     }
 
-    else if (0xa000 <= address && address <= 0xbfff && ram_enabled)
+    else if (0xa000 <= address && address <= 0xbfff && state.ram_enabled)
     {
-        if (banking_mode == 0)
+        if (state.banking_mode == 0)
         {
-            ext_ram[address - 0xa000] = data;
+            write_ram(arena.ext_ram, address - 0xa000, address, data);
         }
         else
         {
-            ext_ram[ext_ram_bank_index * 0x2000 + (address - 0xa000)] = data;
+            write_ram(arena.ext_ram, state.ext_ram_bank_index * 0x2000 + (address - 0xa000), address, data);
         }
     }
 
     else if (0xc000 <= address && address <= 0xdfff)
     {
-        wram[address - 0xc000] = data;
+        write_ram(arena.wram, wram_index(address), address, data);
     }
 
     else if (0xe000 <= address && address <= 0xfdff)
     {
-        wram[address - 0xe000] = data;
+        write_ram(arena.wram, wram_index(address), address, data);
     }
 
     else if (0xfe00 <= address && address <= 0xfe9f)
     {
-        oam[address - 0xfe00] = data;
+        arena.oam[address - 0xfe00] = data;
     }
 
     else if (0xfea0 <= address && address <= 0xfeff)
@@ -282,89 +612,83 @@ void bus::write(std::uint16_t address, std::uint8_t data)
     {
         if (address == 0xff00)
         {
-            bool action = data & (1 << 5);
-            bool direction = data & (1 << 4);
-            if (!action)
-            {
-                io_registers[0] = io_registers[0] & ~(1 << 5);
-                for (int i = 0; i < 4; ++i)
-                {
-                    if (action_buttons[i])
-                    {
-                        io_registers[0] = io_registers[0] & ~(1 << i);
-                    }
-                    else
-                    {
-                        io_registers[0] = io_registers[0] | (1 << i);
-                    }
-                }
-            }
-            else
-            {
-                io_registers[0] = io_registers[0] | (1 << 5);
-            }
-            if (!direction)
-            {
-                io_registers[0] = io_registers[0] & ~(1 << 4);
-                for (int i = 0; i < 4; ++i)
-                {
-                    if (direction_buttons[i])
-                    {
-                        io_registers[0] = io_registers[0] & ~(1 << i);
-                    }
-                    else
-                    {
-                        io_registers[0] = io_registers[0] | (1 << i);
-                    }
-                }
-            }
-            else
+            // only the select bits are writable; selecting a group with a
+            // button held pulls its line low just like a press would
+            std::uint8_t lines = joypad_lines();
+            io_registers[0] = 0xc0 | (data & 0x30) | (io_registers[0] & 0x0f);
+            request_joypad_interrupt(lines);
+        }
+        else if (address == 0xff01 || address == 0xff02)
+        {
+            gb_serial->write(address, data);
+        }
+        else if (0xff10 <= address && address <= 0xff3f)
+        {
+            gb_apu->write(address, data);
+        }
+        else if (address == 0xff50)
+        {
+            io_registers[0x50] = data;
+            if ((data & 0x01) && state.boot_mapped)
             {
-                io_registers[0] = io_registers[0] | (1 << 4);
+                state.boot_mapped = false;
+                map_rom();
             }
         }
+        else if (0xff4d <= address && address <= 0xff70 && cgb_mode)
+        {
+            write_cgb_register(address, data);
+        }
         else if (address == 0xff04)
         {
             io_registers[address - 0xff00] = 0x00;
         }
-        else if (address == 0xff46 && dma_cycle == 0)
+        else if (address == 0xff46 && state.dma_cycle == 0)
         {
-            dma_cycle += 160;
+            state.dma_cycle += 160;
             io_registers[address - 0xff00] = data;
             std::uint16_t source = (data << 8);
             if (0x0000 <= source && source <= 0x3fff)
             {
-                if (banking_mode == 0)
+                if (state.banking_mode == 0)
                 {
-                    std::copy(rom.begin() + source, rom.begin() + source + 0x9f, oam.begin());
+                    std::copy(rom + source, rom + source + 0x9f, arena.oam.begin());
                 }
                 else
                 {
-                    std::copy(rom.begin() + (rom_bank_0_index * 0x4000 + source), rom.begin() + (rom_bank_0_index * 0x4000 + source) + 0x9f, oam.begin());
+                    std::copy(rom + (state.rom_bank_0_index * 0x4000 + source), rom + (state.rom_bank_0_index * 0x4000 + source) + 0x9f, arena.oam.begin());
                 }
             }
             else if (0x4000 <= source && source <= 0x7fff)
             {
-                std::copy(rom.begin() + (rom_bank_index * 0x4000 + (source - 0x4000)), rom.begin() + (rom_bank_index * 0x4000 + (source - 0x4000)) + 0x9f, oam.begin());
+                std::copy(rom + (state.rom_bank_index * 0x4000 + (source - 0x4000)), rom + (state.rom_bank_index * 0x4000 + (source - 0x4000)) + 0x9f, arena.oam.begin());
             }
             else if (0x8000 <= source && source <= 0x9fff)
             {
-                std::copy(vram.begin() + (source - 0x8000), vram.begin() + (source - 0x8000) + 0x9f, oam.begin());
+                std::copy(arena.vram.data((state.vram_bank << 13) | (source - 0x8000)), arena.vram.data((state.vram_bank << 13) | (source - 0x8000)) + 0x9f, arena.oam.begin());
             }
             else if (0xa000 <= source && source <= 0xbfff)
             {
-                if (banking_mode == 0)
+                if (state.banking_mode == 0)
                 {
-                    std::copy(ext_ram.begin() + (source - 0xa000), ext_ram.begin() + (source - 0xa000) + 0x9f, oam.begin());
+                    std::copy(arena.ext_ram.data(source - 0xa000), arena.ext_ram.data(source - 0xa000) + 0x9f, arena.oam.begin());
                 }
                 else
                 {
-                    std::copy(ext_ram.begin() + (ext_ram_bank_index * 0x2000 + (source - 0xa000)), ext_ram.begin() + (ext_ram_bank_index * 0x2000 + (source - 0xa000)) + 0x9f, oam.begin());
+                    std::copy(arena.ext_ram.data(state.ext_ram_bank_index * 0x2000 + (source - 0xa000)), arena.ext_ram.data(state.ext_ram_bank_index * 0x2000 + (source - 0xa000)) + 0x9f, arena.oam.begin());
                 }
             }
             else if (0xc000 <= source && source <= 0xdfff)
             {
-                std::copy(wram.begin() + (source - 0xc000), wram.begin() + (source - 0xc000) + 0x9f, oam.begin());
+                std::copy(arena.wram.data(wram_index(source)), arena.wram.data(wram_index(source)) + 0x9f, arena.oam.begin());
+            }
+            // the copies above go straight to memory; the source is one page
+            if (source <= 0xdfff && watched_pages[data])
+            {
+                for (std::uint16_t i = 0; i < 0x9f; ++i)
+                {
+                    check_watchpoints(source + i, watch_access::read, arena.oam[i], arena.oam[i]);
+                }
             }
         }
         else
@@ -375,12 +699,19 @@ void bus::write(std::uint16_t address, std::uint8_t data)
 
     else if (0xff80 <= address && address <= 0xfffe)
     {
-        hram[address - 0xff80] = data;
+        arena.hram[address - 0xff80] = data;
     }
 
     else if (address == 0xffff)
     {
-        ie_register = data;
+        state.ie_register = data;
+    }
+
+    if (address <= 0x7fff)
+    {
+        // an MBC register changed
+        map_rom();
+        map_ext_ram();
     }
 }
 
@@ -390,12 +721,32 @@ void bus::increment_div()
     io_registers[0x04] = ++div;
 }
 
+std::uint16_t bus::current_rom_bank(std::uint16_t address)
+{
+    if (address <= 0x3fff)
+    {
+        return state.banking_mode == 0 ? 0 : state.rom_bank_0_index;
+    }
+    else if (address <= 0x7fff)
+    {
+        return state.rom_bank_index;
+    }
+    return 0;
+}
+
+std::uint16_t bus::rom_banks()
+{
+    return n_rom_banks;
+}
+
 void bus::load_rom(std::string path)
 {
     std::ifstream input(path, std::ios::binary);
-    std::vector<uint8_t> buffer(std::istreambuf_iterator<char>(input), {});
-    rom = buffer;
+    rom_image = std::make_shared<const std::vector<std::uint8_t>>(std::istreambuf_iterator<char>(input),
+                                                                   std::istreambuf_iterator<char>());
+    rom = rom_image->data();
     std::uint8_t cartridge_type = rom[0x0147];
+    cgb_mode = (rom[0x0143] & 0x80) != 0;
     std::uint8_t rom_size_code = rom[0x0148];
     std::uint8_t ram_size_code = rom[0x0149];
 
@@ -451,21 +802,335 @@ void bus::load_rom(std::string path)
         n_ram_banks = 8;
         break;
     }
+    arena.ext_ram.assign(std::max<size_t>(n_ram_banks, 1) * 0x2000, 0);
+    remap();
+}
+
+bool bus::load_boot_rom(std::string path)
+{
+    std::ifstream input(path, std::ios::binary);
+    auto image = std::make_shared<const std::vector<std::uint8_t>>(std::istreambuf_iterator<char>(input),
+                                                                    std::istreambuf_iterator<char>());
+    if (image->size() != 0x100 && image->size() != 0x900)
+    {
+        return false;
+    }
+    boot_image = image;
+    state.boot_mapped = true;
+    io_registers = power_on_io;
+    map_rom();
+    return true;
+}
+
+bool bus::boot_rom_mapped()
+{
+    return state.boot_mapped;
 }
 
 void bus::load_ext_ram(std::string path)
 {
     std::ifstream input(path, std::ios::binary);
     std::vector<uint8_t> buffer(std::istreambuf_iterator<char>(input), {});
-    ext_ram = buffer;
+    arena.ext_ram.assign(buffer);
+    map_ext_ram();
+}
+
+void bus::randomize_ram(std::uint64_t seed)
+{
+    std::uint64_t state = seed;
+    // splitmix64
+    auto next = [&state]()
+    {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return static_cast<std::uint8_t>(z ^ (z >> 31));
+    };
+    for (size_t i = 0; i < arena.wram.size(); ++i)
+    {
+        arena.wram.writable(i) = seed != 0 ? next() : 0;
+    }
+    for (uint8_t &byte : arena.hram)
+    {
+        byte = seed != 0 ? next() : 0;
+    }
+    map_wram();
+}
+
+void bus::connect_serial(serial *s)
+{
+    gb_serial = s;
+}
+
+void bus::connect_apu(apu *a)
+{
+    gb_apu = a;
+}
+
+void bus::connect_cpu(cpu *c)
+{
+    gb_cpu = c;
+}
+
+void bus::set_buttons(std::uint8_t mask)
+{
+    std::uint8_t lines = joypad_lines();
+    state.buttons = mask;
+    request_joypad_interrupt(lines);
+}
+
+std::uint8_t bus::get_buttons()
+{
+    return state.buttons;
+}
+
+std::uint8_t bus::joypad_lines()
+{
+    std::uint8_t pressed = 0;
+    if (!(io_registers[0] & (1 << 5)))
+    {
+        pressed |= state.buttons & 0x0f;
+    }
+    if (!(io_registers[0] & (1 << 4)))
+    {
+        pressed |= state.buttons >> 4;
+    }
+    return ~pressed & 0x0f;
+}
+
+void bus::request_joypad_interrupt(std::uint8_t previous_lines)
+{
+    if (previous_lines & ~joypad_lines())
+    {
+        io_registers[0x0f] |= 1 << 4;
+    }
+}
+std::uint8_t bus::read_cgb_register(std::uint16_t address)
+{
+    switch (address)
+    {
+    case 0xff4d:
+        return (state.double_speed << 7) | 0x7e | state.speed_switch_armed;
+    case 0xff4f:
+        return 0xfe | state.vram_bank;
+    case 0xff51:
+    case 0xff52:
+    case 0xff53:
+    case 0xff54:
+        return 0xff;
+    case 0xff55:
+        return state.hdma_blocks != 0 ? state.hdma_blocks - 1 : io_registers[0x55];
+    case 0xff68:
+        return bg_palette_index | 0x40;
+    case 0xff69:
+        return bg_palettes[bg_palette_index & 0x3f];
+    case 0xff6a:
+        return obj_palette_index | 0x40;
+    case 0xff6b:
+        return obj_palettes[obj_palette_index & 0x3f];
+    case 0xff70:
+        return 0xf8 | state.wram_bank;
+    }
+    return io_registers[address - 0xff00];
 }
 
-void bus::set_action_button(std::uint8_t index, bool value)
+void bus::write_cgb_register(std::uint16_t address, std::uint8_t data)
 {
-    action_buttons[index] = value;
+    switch (address)
+    {
+    case 0xff4d:
+        state.speed_switch_armed = data & 0x01;
+        break;
+    case 0xff4f:
+        state.vram_bank = data & 0x01;
+        map_vram();
+        break;
+    case 0xff51:
+        state.hdma_source = (state.hdma_source & 0x00ff) | (data << 8);
+        break;
+    case 0xff52:
+        state.hdma_source = (state.hdma_source & 0xff00) | (data & 0xf0);
+        break;
+    case 0xff53:
+        state.hdma_destination = (state.hdma_destination & 0x00ff) | ((data & 0x1f) << 8);
+        break;
+    case 0xff54:
+        state.hdma_destination = (state.hdma_destination & 0xff00) | (data & 0xf0);
+        break;
+    case 0xff55:
+        if (state.hdma_blocks != 0 && !(data & 0x80))
+        {
+            // cancels the HBlank transfer in progress
+            io_registers[0x55] = 0x80 | (state.hdma_blocks - 1);
+            state.hdma_blocks = 0;
+        }
+        else if (data & 0x80)
+        {
+            state.hdma_blocks = (data & 0x7f) + 1;
+        }
+        else
+        {
+            // general-purpose DMA: the CPU is held for 32 ticks per block
+            hdma_copy((data & 0x7f) + 1);
+            gb_cpu->stall(((data & 0x7f) + 1) * 32);
+            io_registers[0x55] = 0xff;
+        }
+        break;
+    case 0xff68:
+        bg_palette_index = data & 0xbf;
+        break;
+    case 0xff69:
+        bg_palettes[bg_palette_index & 0x3f] = data;
+        if (bg_palette_index & 0x80)
+        {
+            bg_palette_index = 0x80 | ((bg_palette_index + 1) & 0x3f);
+        }
+        break;
+    case 0xff6a:
+        obj_palette_index = data & 0xbf;
+        break;
+    case 0xff6b:
+        obj_palettes[obj_palette_index & 0x3f] = data;
+        if (obj_palette_index & 0x80)
+        {
+            obj_palette_index = 0x80 | ((obj_palette_index + 1) & 0x3f);
+        }
+        break;
+    case 0xff70:
+        state.wram_bank = (data & 0x07) != 0 ? (data & 0x07) : 1;
+        map_wram();
+        break;
+    default:
+        io_registers[address - 0xff00] = data;
+    }
+}
+
+// Backing storage for a DMA source address, with the number of bytes that
+// stay contiguous from there (at most to the end of a RAM page). nullptr for regions that are not plain memory
+// (VRAM, disabled cartridge RAM, 0xe000 and up).
+const std::uint8_t *bus::dma_source(std::uint16_t address, std::uint16_t &length)
+{
+    size_t offset;
+    if (address <= 0x3fff)
+    {
+        offset = state.banking_mode == 0 ? address : state.rom_bank_0_index * 0x4000 + address;
+        length = 0x4000 - address;
+        return offset + length <= rom_image->size() ? &rom[offset] : nullptr;
+    }
+    if (address <= 0x7fff)
+    {
+        offset = state.rom_bank_index * 0x4000 + (address - 0x4000);
+        length = 0x8000 - address;
+        return offset + length <= rom_image->size() ? &rom[offset] : nullptr;
+    }
+    if (0xa000 <= address && address <= 0xbfff && state.ram_enabled)
+    {
+        offset = state.banking_mode == 0 ? address - 0xa000 : state.ext_ram_bank_index * 0x2000 + (address - 0xa000);
+        if (offset >= arena.ext_ram.size())
+        {
+            return nullptr;
+        }
+        length = std::min<size_t>(0xc000 - address, arena.ext_ram.contiguous(offset));
+        return arena.ext_ram.data(offset);
+    }
+    if (0xc000 <= address && address <= 0xdfff)
+    {
+        length = 0x1000 - (address & 0x0fff);
+        return arena.wram.data(wram_index(address));
+    }
+    length = 0;
+    return nullptr;
 }
 
-void bus::set_direction_button(std::uint8_t index, bool value)
+// Copies whole runs at once: a run ends at a source region or page boundary,
+// or where the destination crosses a page or wraps around the VRAM bank. Sources and destinations are
+// 16-byte aligned, so runs are always whole blocks. While watchpoints are set,
+// runs also end at 256-byte source pages, and watched ones are read byte by
+// byte through the checked path.
+void bus::hdma_copy(std::uint16_t blocks)
 {
-    direction_buttons[index] = value;
-}
\ No newline at end of file
+    std::uint16_t remaining = blocks * 16;
+    while (remaining != 0)
+    {
+        std::uint16_t destination = state.hdma_destination & 0x1fff;
+        std::uint16_t contiguous;
+        const std::uint8_t *source = dma_source(state.hdma_source, contiguous);
+        if (source != nullptr && watching())
+        {
+            // a watched page takes the byte-wise path below, which checks
+            contiguous = std::min<std::uint16_t>(contiguous, 0x100 - (state.hdma_source & 0xff));
+            if (watched_pages[state.hdma_source >> 8])
+            {
+                source = nullptr;
+            }
+        }
+        std::uint16_t index = (state.vram_bank << 13) | destination;
+        std::uint16_t run = std::min<size_t>({remaining, arena.vram.contiguous(index), 0x2000u - destination});
+        std::uint8_t *target = &arena.vram.writable(index);
+        if (source != nullptr)
+        {
+            run = std::min(run, contiguous);
+            std::copy(source, source + run, target);
+        }
+        else
+        {
+            run = std::min<std::uint16_t>(run, 16);
+            for (std::uint16_t i = 0; i < run; ++i)
+            {
+                target[i] = read_memory(state.hdma_source + i);
+            }
+        }
+        state.hdma_source += run;
+        state.hdma_destination += run;
+        remaining -= run;
+    }
+    // the copy may have taken pages over from a fork
+    map_vram();
+}
+
+void bus::hblank()
+{
+    if (state.hdma_blocks == 0)
+    {
+        return;
+    }
+    hdma_copy(1);
+    gb_cpu->stall(32);
+    if (--state.hdma_blocks == 0)
+    {
+        io_registers[0x55] = 0xff;
+    }
+}
+
+bool bus::is_cgb()
+{
+    return cgb_mode;
+}
+
+bool bus::is_double_speed()
+{
+    return state.double_speed;
+}
+
+bool bus::switch_speed()
+{
+    if (!cgb_mode || !state.speed_switch_armed)
+    {
+        return false;
+    }
+    state.double_speed = !state.double_speed;
+    state.speed_switch_armed = false;
+    return true;
+}
+
+std::uint16_t bus::bg_color(std::uint8_t palette, std::uint8_t index)
+{
+    std::uint8_t offset = palette * 8 + index * 2;
+    return (bg_palettes[offset] | (bg_palettes[offset + 1] << 8)) & 0x7fff;
+}
+
+std::uint16_t bus::obj_color(std::uint8_t palette, std::uint8_t index)
+{
+    std::uint8_t offset = palette * 8 + index * 2;
+    return (obj_palettes[offset] | (obj_palettes[offset + 1] << 8)) & 0x7fff;
+}
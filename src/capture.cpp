@@ -0,0 +1,158 @@
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "capture.h"
+#include "renderer.h"
+
+// Frames handed to one write() call; large writes keep the writer off the
+// syscall path.
+static constexpr size_t batch_frames = 8;
+
+video_capture::video_capture(size_t queue_frames) : queue(queue_frames * frame_pixels)
+{
+    container = format::raw;
+    color = false;
+    stopping.store(false);
+    dropped_frames.store(0);
+    written_frames.store(0);
+}
+
+video_capture::~video_capture()
+{
+    close();
+}
+
+bool video_capture::open(const std::string &path, format f, bool color)
+{
+    close();
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        return false;
+    }
+    container = f;
+    this->color = color;
+    if (container == format::y4m)
+    {
+        // 4194304 Hz / 70224 T-cycles per frame
+        out << "YUV4MPEG2 W160 H144 F4194304:70224 Ip A1:1 C444\n";
+    }
+    stopping.store(false);
+    writer = std::thread(&video_capture::run, this);
+    return true;
+}
+
+void video_capture::close()
+{
+    if (writer.joinable())
+    {
+        stopping.store(true);
+        writer.join();
+    }
+    if (out.is_open())
+    {
+        out.close();
+    }
+}
+
+void video_capture::frame(const std::array<std::uint16_t, 160 * 144> &pixels)
+{
+    if (!writer.joinable() || queue.capacity() - queue.size() < frame_pixels)
+    {
+        dropped_frames.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    queue.push(pixels.data(), frame_pixels);
+}
+
+void video_capture::run()
+{
+    std::vector<std::uint16_t> pixels(frame_pixels);
+    std::vector<char> buffer;
+    while (true)
+    {
+        // read before checking the queue so the final frames are not lost
+        bool last = stopping.load();
+        size_t frames = 0;
+        buffer.clear();
+        while (frames < batch_frames && queue.size() >= frame_pixels)
+        {
+            queue.pop(pixels.data(), frame_pixels);
+            encode(pixels.data(), buffer);
+            ++frames;
+        }
+        if (frames != 0)
+        {
+            out.write(buffer.data(), buffer.size());
+            written_frames.fetch_add(frames, std::memory_order_relaxed);
+            continue;
+        }
+        if (last)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(4));
+    }
+    out.flush();
+}
+
+void video_capture::encode(const std::uint16_t *pixels, std::vector<char> &buffer)
+{
+    if (container == format::y4m)
+    {
+        static const std::string frame_header = "FRAME\n";
+        size_t start = buffer.size() + frame_header.size();
+        buffer.insert(buffer.end(), frame_header.begin(), frame_header.end());
+        buffer.resize(start + 3 * frame_pixels);
+        char *y = buffer.data() + start;
+        char *u = y + frame_pixels;
+        char *v = u + frame_pixels;
+        for (size_t i = 0; i < frame_pixels; ++i)
+        {
+            int r = (pixels[i] & 0x1f) << 3 | (pixels[i] & 0x1f) >> 2;
+            int g = ((pixels[i] >> 5) & 0x1f) << 3 | ((pixels[i] >> 5) & 0x1f) >> 2;
+            int b = ((pixels[i] >> 10) & 0x1f) << 3 | ((pixels[i] >> 10) & 0x1f) >> 2;
+            // BT.601, studio range
+            y[i] = static_cast<char>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+            u[i] = static_cast<char>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            v[i] = static_cast<char>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+    else if (color)
+    {
+        for (size_t i = 0; i < frame_pixels; ++i)
+        {
+            buffer.push_back(static_cast<char>(pixels[i] & 0xff));
+            buffer.push_back(static_cast<char>(pixels[i] >> 8));
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < frame_pixels; i += 4)
+        {
+            std::uint8_t packed = 0;
+            for (size_t j = 0; j < 4; ++j)
+            {
+                std::uint8_t shade = 3;
+                while (shade > 0 && dmg_colors[shade] != pixels[i + j])
+                {
+                    --shade;
+                }
+                packed = (packed << 2) | shade;
+            }
+            buffer.push_back(static_cast<char>(packed));
+        }
+    }
+}
+
+std::uint64_t video_capture::dropped()
+{
+    return dropped_frames.load(std::memory_order_relaxed);
+}
+
+std::uint64_t video_capture::written()
+{
+    return written_frames.load(std::memory_order_relaxed);
+}
@@ -3,42 +3,96 @@
 #include <iomanip>
 #include <chrono>
 #include <thread>
+#include <algorithm>
 
 #include "cpu.h"
 #include "bus.h"
-
-cpu::cpu()
-{
-    cycle = 0;
-    ime_flag = false;
-    halted = false;
-
-    a = 0x01;
-    f = 0xb0;
-    b = 0x00;
-    c = 0x13;
-    d = 0x00;
-    e = 0xd8;
-    h = 0x01;
-    l = 0x4d;
-
-    sp = 0xfffe;
-    pc = 0x0100;
+#include "profiler.h"
+#include "trace.h"
+
+cpu::cpu(cpu_state &s) : state(s)
+{
+    state.cycle = 0;
+    state.speed = 1;
+    state.stall_cycles = 0;
+    state.ime_flag = false;
+    state.halted = false;
+    state.instruction_count = 0;
+    state.timestamp = 0;
+    profiler = nullptr;
+    tracer = nullptr;
+    comparator = nullptr;
+    fusion = false;
+
+    state.a = 0x01;
+    state.f = 0xb0;
+    state.b = 0x00;
+    state.c = 0x13;
+    state.d = 0x00;
+    state.e = 0xd8;
+    state.h = 0x01;
+    state.l = 0x4d;
+
+    state.sp = 0xfffe;
+    state.pc = 0x0100;
 }
 
 void cpu::connect_bus(bus *b)
 {
     gb_bus = b;
+}
+
+void cpu::reset()
+{
+    state.cycle = 0;
+    state.speed = 1;
+    state.stall_cycles = 0;
+    state.ime_flag = false;
+    state.halted = false;
+    state.instruction_count = 0;
+    state.timestamp = 0;
+    power_on();
+}
+
+void cpu::power_on()
+{
+    if (gb_bus->boot_rom_mapped())
+    {
+        state.a = state.f = state.b = state.c = state.d = state.e = state.h = state.l = 0x00;
+        state.sp = 0x0000;
+        state.pc = 0x0000;
+        return;
+    }
+    state.sp = 0xfffe;
+    state.pc = 0x0100;
+    if (gb_bus->is_cgb())
+    {
+        // CGB boot ROM hand-off; A = 0x11 is how games detect the CGB
+        state.a = 0x11;
+        state.f = 0x80;
+        state.b = 0x00;
+        state.c = 0x00;
+        state.d = 0xff;
+        state.e = 0x56;
+        state.h = 0x00;
+        state.l = 0x0d;
+        return;
+    }
+    state.a = 0x01;
+    state.b = 0x00;
+    state.c = 0x13;
+    state.d = 0x00;
+    state.e = 0xd8;
+    state.h = 0x01;
+    state.l = 0x4d;
     std::uint8_t header_cheksum = read(0x014d);
     if (header_cheksum == 0x00)
     {
-        f = f & ~(1 << 4);
-        f = f & ~(1 << 5);
+        state.f = 0x80;
     }
     else
     {
-        f = f | (1 << 4);
-        f = f | (1 << 5);
+        state.f = 0xb0;
     }
 }
 
@@ -52,13 +106,37 @@ void cpu::write(std::uint16_t address, std::uint8_t data)
     return gb_bus->write(address, data);
 }
 
+std::uint64_t cpu::get_instruction_count()
+{
+    return state.instruction_count;
+}
+
+cpu_registers cpu::get_registers()
+{
+    return {state.a, state.f, state.b, state.c, state.d, state.e, state.h, state.l, state.sp, state.pc};
+}
+
+void cpu::set_registers(const cpu_registers &r)
+{
+    state.a = r.a;
+    state.f = r.f & 0xf0;
+    state.b = r.b;
+    state.c = r.c;
+    state.d = r.d;
+    state.e = r.e;
+    state.h = r.h;
+    state.l = r.l;
+    state.sp = r.sp;
+    state.pc = r.pc;
+}
+
 void cpu::handle_interrupt()
 {
-    std::uint8_t ie_register = read(0xffff);
-    std::uint8_t if_register = read(0xff0f);
+    std::uint8_t ie_register = gb_bus->interrupt_enable();
+    std::uint8_t if_register = gb_bus->read_io(0x0f);
     if (ie_register & if_register)
     {
-        if (ime_flag)
+        if (state.ime_flag)
         {
             bool vblank = ((ie_register & (1 << 0)) & (if_register & (1 << 0)));
             bool lcd_stat = ((ie_register & (1 << 1)) & (if_register & (1 << 1)));
@@ -68,2323 +146,2535 @@ void cpu::handle_interrupt()
 
             if (vblank)
             {
-                std::uint8_t high = pc >> 8;
-                std::uint8_t low = pc;
-                --sp;
-                write(sp, high);
-                --sp;
-                write(sp, low);
-                pc = 0x0000 + 0x40;
-                ime_flag = false;
+                std::uint8_t high = state.pc >> 8;
+                std::uint8_t low = state.pc;
+                --state.sp;
+                write(state.sp, high);
+                --state.sp;
+                write(state.sp, low);
+                state.pc = 0x0000 + 0x40;
+                state.ime_flag = false;
                 write(0xff0f, if_register & ~(1 << 0));
-                cycle += 20;
+                state.cycle += 20;
             }
 
             else if (lcd_stat)
             {
-                std::uint8_t high = pc >> 8;
-                std::uint8_t low = pc;
-                --sp;
-                write(sp, high);
-                --sp;
-                write(sp, low);
-                pc = 0x0000 + 0x48;
-                ime_flag = false;
+                std::uint8_t high = state.pc >> 8;
+                std::uint8_t low = state.pc;
+                --state.sp;
+                write(state.sp, high);
+                --state.sp;
+                write(state.sp, low);
+                state.pc = 0x0000 + 0x48;
+                state.ime_flag = false;
                 write(0xff0f, if_register & ~(1 << 1));
-                cycle += 20;
+                state.cycle += 20;
             }
 
             else if (timer)
             {
-                std::uint8_t high = pc >> 8;
-                std::uint8_t low = pc;
-                --sp;
-                write(sp, high);
-                --sp;
-                write(sp, low);
-                pc = 0x0000 + 0x50;
-                ime_flag = false;
+                std::uint8_t high = state.pc >> 8;
+                std::uint8_t low = state.pc;
+                --state.sp;
+                write(state.sp, high);
+                --state.sp;
+                write(state.sp, low);
+                state.pc = 0x0000 + 0x50;
+                state.ime_flag = false;
                 write(0xff0f, if_register & ~(1 << 2));
-                cycle += 20;
+                state.cycle += 20;
             }
 
             else if (serial)
             {
-                std::uint8_t high = pc >> 8;
-                std::uint8_t low = pc;
-                --sp;
-                write(sp, high);
-                --sp;
-                write(sp, low);
-                pc = 0x0000 + 0x58;
-                ime_flag = false;
+                std::uint8_t high = state.pc >> 8;
+                std::uint8_t low = state.pc;
+                --state.sp;
+                write(state.sp, high);
+                --state.sp;
+                write(state.sp, low);
+                state.pc = 0x0000 + 0x58;
+                state.ime_flag = false;
                 write(0xff0f, if_register & ~(1 << 3));
-                cycle += 20;
+                state.cycle += 20;
             }
 
             else if (joypad)
             {
-                std::uint8_t high = pc >> 8;
-                std::uint8_t low = pc;
-                --sp;
-                write(sp, high);
-                --sp;
-                write(sp, low);
-                pc = 0x0000 + 0x60;
-                ime_flag = false;
+                std::uint8_t high = state.pc >> 8;
+                std::uint8_t low = state.pc;
+                --state.sp;
+                write(state.sp, high);
+                --state.sp;
+                write(state.sp, low);
+                state.pc = 0x0000 + 0x60;
+                state.ime_flag = false;
                 write(0xff0f, if_register & ~(1 << 4));
-                cycle += 20;
+                state.cycle += 20;
             }
         }
         else
         {
-            cycle += 8;
+            state.cycle += 8;
         }
-        halted = false;
+        state.halted = false;
     }
 }
 
+template <std::uint8_t flags>
+void cpu::record_trace()
+{
+    trace_record &record = tracer->next();
+    record.cycle = state.timestamp;
+    record.pc = state.pc;
+    record.bank = gb_bus->current_rom_bank(state.pc);
+    record.sp = state.sp;
+    record.a = state.a;
+    record.f = state.f;
+    record.b = state.b;
+    record.c = state.c;
+    record.d = state.d;
+    record.e = state.e;
+    record.h = state.h;
+    record.l = state.l;
+    // PCMEM is looked at, not read: no watchpoints, no I/O side effects
+    for (int i = 0; i < 4; ++i)
+    {
+        int byte = gb_bus->peek_mapped(state.pc + i);
+        record.memory[i] = byte >= 0 ? byte : gb_bus->peek(state.pc + i);
+    }
+    tracer->commit();
+    if constexpr ((flags & instrumentation::compare) != 0)
+    {
+        comparator->check(record);
+    }
+}
+
+template <std::uint8_t flags>
 void cpu::clock()
 {
-    if (cycle == 0 && !halted)
+    if (state.cycle == 0 && state.stall_cycles != 0)
+    {
+        // one branch per slice instead of one per stalled tick
+        state.cycle = std::min<std::uint16_t>(state.stall_cycles, 240);
+        state.stall_cycles -= state.cycle;
+    }
+    else if (state.cycle == 0 && !state.halted)
     {
-        std::uint8_t byte_1 = read(pc);
-        ++pc;
-        switch (byte_1)
+        if constexpr ((flags & instrumentation::trace) != 0)
+        {
+            record_trace<flags>();
+        }
+        std::uint16_t opcode_pc = state.pc;
+        std::uint8_t byte_1 = read(state.pc);
+        ++state.pc;
+        ++state.instruction_count;
+        std::uint8_t cb_opcode = 0x00;
+        if constexpr ((flags & instrumentation::profile) != 0)
+        {
+            // before the instruction can overwrite it
+            cb_opcode = byte_1 == 0xcb ? gb_bus->peek(state.pc) : 0x00;
+        }
+        std::uint8_t fused_cycles = 0;
+        if constexpr (flags == instrumentation::none)
+        {
+            fused_cycles = fuse(byte_1);
+        }
+        if (fused_cycles != 0)
+        {
+            state.cycle += fused_cycles;
+        }
+        else switch (byte_1)
         {
         case 0x00:
-            cycle += nop();
+            state.cycle += nop();
             break;
         case 0x01:
-            cycle += ld_bc_d16();
+            state.cycle += ld_bc_d16();
             break;
         case 0x02:
-            cycle += ld_addr_bc_a();
+            state.cycle += ld_addr_bc_a();
             break;
         case 0x03:
-            cycle += inc_bc();
+            state.cycle += inc_bc();
             break;
         case 0x04:
-            cycle += inc_b();
+            state.cycle += inc_b();
             break;
         case 0x05:
-            cycle += dec_b();
+            state.cycle += dec_b();
             break;
         case 0x06:
-            cycle += ld_b_d8();
+            state.cycle += ld_b_d8();
             break;
         case 0x07:
-            cycle += rlca();
+            state.cycle += rlca();
             break;
         case 0x08:
-            cycle += ld_a16_sp();
+            state.cycle += ld_a16_sp();
             break;
         case 0x09:
-            cycle += add_hl_bc();
+            state.cycle += add_hl_bc();
             break;
         case 0x0a:
-            cycle += ld_a_addr_bc();
+            state.cycle += ld_a_addr_bc();
             break;
         case 0x0b:
-            cycle += dec_bc();
+            state.cycle += dec_bc();
             break;
         case 0x0c:
-            cycle += inc_c();
+            state.cycle += inc_c();
             break;
         case 0x0d:
-            cycle += dec_c();
+            state.cycle += dec_c();
             break;
         case 0x0e:
-            cycle += ld_c_d8();
+            state.cycle += ld_c_d8();
             break;
         case 0x0f:
-            cycle += rrca();
+            state.cycle += rrca();
             break;
         case 0x10:
-            cycle += stop();
+            state.cycle += stop();
             break;
         case 0x11:
-            cycle += ld_de_d16();
+            state.cycle += ld_de_d16();
             break;
         case 0x12:
-            cycle += ld_addr_de_a();
+            state.cycle += ld_addr_de_a();
             break;
         case 0x13:
-            cycle += inc_de();
+            state.cycle += inc_de();
             break;
         case 0x14:
-            cycle += inc_d();
+            state.cycle += inc_d();
             break;
         case 0x15:
-            cycle += dec_d();
+            state.cycle += dec_d();
             break;
         case 0x16:
-            cycle += ld_d_d8();
+            state.cycle += ld_d_d8();
             break;
         case 0x17:
-            cycle += rla();
+            state.cycle += rla();
             break;
         case 0x18:
-            cycle += jr_r8();
+            state.cycle += jr_r8();
             break;
         case 0x19:
-            cycle += add_hl_de();
+            state.cycle += add_hl_de();
             break;
         case 0x1a:
-            cycle += ld_a_addr_de();
+            state.cycle += ld_a_addr_de();
             break;
         case 0x1b:
-            cycle += dec_de();
+            state.cycle += dec_de();
             break;
         case 0x1c:
-            cycle += inc_e();
+            state.cycle += inc_e();
             break;
         case 0x1d:
-            cycle += dec_e();
+            state.cycle += dec_e();
             break;
         case 0x1e:
-            cycle += ld_e_d8();
+            state.cycle += ld_e_d8();
             break;
         case 0x1f:
-            cycle += rra();
+            state.cycle += rra();
             break;
         case 0x20:
-            cycle += jr_nz_r8();
+            state.cycle += jr_nz_r8();
             break;
         case 0x21:
-            cycle += ld_hl_d16();
+            state.cycle += ld_hl_d16();
             break;
         case 0x22:
-            cycle += ldi_addr_hl_a();
+            state.cycle += ldi_addr_hl_a();
             break;
         case 0x23:
-            cycle += inc_hl();
+            state.cycle += inc_hl();
             break;
         case 0x24:
-            cycle += inc_h();
+            state.cycle += inc_h();
             break;
         case 0x25:
-            cycle += dec_h();
+            state.cycle += dec_h();
             break;
         case 0x26:
-            cycle += ld_h_d8();
+            state.cycle += ld_h_d8();
             break;
         case 0x27:
-            cycle += daa();
+            state.cycle += daa();
             break;
         case 0x28:
-            cycle += jr_z_r8();
+            state.cycle += jr_z_r8();
             break;
         case 0x29:
-            cycle += add_hl_hl();
+            state.cycle += add_hl_hl();
             break;
         case 0x2a:
-            cycle += ldi_a_addr_hl();
+            state.cycle += ldi_a_addr_hl();
             break;
         case 0x2b:
-            cycle += dec_hl();
+            state.cycle += dec_hl();
             break;
         case 0x2c:
-            cycle += inc_l();
+            state.cycle += inc_l();
             break;
         case 0x2d:
-            cycle += dec_l();
+            state.cycle += dec_l();
             break;
         case 0x2e:
-            cycle += ld_l_d8();
+            state.cycle += ld_l_d8();
             break;
         case 0x2f:
-            cycle += cpl();
+            state.cycle += cpl();
             break;
         case 0x30:
-            cycle += jr_nc_r8();
+            state.cycle += jr_nc_r8();
             break;
         case 0x31:
-            cycle += ld_sp_d16();
+            state.cycle += ld_sp_d16();
             break;
         case 0x32:
-            cycle += ldd_addr_hl_a();
+            state.cycle += ldd_addr_hl_a();
             break;
         case 0x33:
-            cycle += inc_sp();
+            state.cycle += inc_sp();
             break;
         case 0x34:
-            cycle += inc_addr_hl();
+            state.cycle += inc_addr_hl();
             break;
         case 0x35:
-            cycle += dec_addr_hl();
+            state.cycle += dec_addr_hl();
             break;
         case 0x36:
-            cycle += ld_addr_hl_d8();
+            state.cycle += ld_addr_hl_d8();
             break;
         case 0x37:
-            cycle += scf();
+            state.cycle += scf();
             break;
         case 0x38:
-            cycle += jr_c_r8();
+            state.cycle += jr_c_r8();
             break;
         case 0x39:
-            cycle += add_hl_sp();
+            state.cycle += add_hl_sp();
             break;
         case 0x3a:
-            cycle += ldd_a_addr_hl();
+            state.cycle += ldd_a_addr_hl();
             break;
         case 0x3b:
-            cycle += dec_sp();
+            state.cycle += dec_sp();
             break;
         case 0x3c:
-            cycle += inc_a();
+            state.cycle += inc_a();
             break;
         case 0x3d:
-            cycle += dec_a();
+            state.cycle += dec_a();
             break;
         case 0x3e:
-            cycle += ld_a_d8();
+            state.cycle += ld_a_d8();
             break;
         case 0x3f:
-            cycle += ccf();
+            state.cycle += ccf();
             break;
         case 0x40:
-            cycle += ld_b_b();
+            state.cycle += ld_b_b();
             break;
         case 0x41:
-            cycle += ld_b_c();
+            state.cycle += ld_b_c();
             break;
         case 0x42:
-            cycle += ld_b_d();
+            state.cycle += ld_b_d();
             break;
         case 0x43:
-            cycle += ld_b_e();
+            state.cycle += ld_b_e();
             break;
         case 0x44:
-            cycle += ld_b_h();
+            state.cycle += ld_b_h();
             break;
         case 0x45:
-            cycle += ld_b_l();
+            state.cycle += ld_b_l();
             break;
         case 0x46:
-            cycle += ld_b_addr_hl();
+            state.cycle += ld_b_addr_hl();
             break;
         case 0x47:
-            cycle += ld_b_a();
+            state.cycle += ld_b_a();
             break;
         case 0x48:
-            cycle += ld_c_b();
+            state.cycle += ld_c_b();
             break;
         case 0x49:
-            cycle += ld_c_c();
+            state.cycle += ld_c_c();
             break;
         case 0x4a:
-            cycle += ld_c_d();
+            state.cycle += ld_c_d();
             break;
         case 0x4b:
-            cycle += ld_c_e();
+            state.cycle += ld_c_e();
             break;
         case 0x4c:
-            cycle += ld_c_h();
+            state.cycle += ld_c_h();
             break;
         case 0x4d:
-            cycle += ld_c_l();
+            state.cycle += ld_c_l();
             break;
         case 0x4e:
-            cycle += ld_c_addr_hl();
+            state.cycle += ld_c_addr_hl();
             break;
         case 0x4f:
-            cycle += ld_c_a();
+            state.cycle += ld_c_a();
             break;
         case 0x50:
-            cycle += ld_d_b();
+            state.cycle += ld_d_b();
             break;
         case 0x51:
-            cycle += ld_d_c();
+            state.cycle += ld_d_c();
             break;
         case 0x52:
-            cycle += ld_d_d();
+            state.cycle += ld_d_d();
             break;
         case 0x53:
-            cycle += ld_d_e();
+            state.cycle += ld_d_e();
             break;
         case 0x54:
-            cycle += ld_d_h();
+            state.cycle += ld_d_h();
             break;
         case 0x55:
-            cycle += ld_d_l();
+            state.cycle += ld_d_l();
             break;
         case 0x56:
-            cycle += ld_d_addr_hl();
+            state.cycle += ld_d_addr_hl();
             break;
         case 0x57:
-            cycle += ld_d_a();
+            state.cycle += ld_d_a();
             break;
         case 0x58:
-            cycle += ld_e_b();
+            state.cycle += ld_e_b();
             break;
         case 0x59:
-            cycle += ld_e_c();
+            state.cycle += ld_e_c();
             break;
         case 0x5a:
-            cycle += ld_e_d();
+            state.cycle += ld_e_d();
             break;
         case 0x5b:
-            cycle += ld_e_e();
+            state.cycle += ld_e_e();
             break;
         case 0x5c:
-            cycle += ld_e_h();
+            state.cycle += ld_e_h();
             break;
         case 0x5d:
-            cycle += ld_e_l();
+            state.cycle += ld_e_l();
             break;
         case 0x5e:
-            cycle += ld_e_addr_hl();
+            state.cycle += ld_e_addr_hl();
             break;
         case 0x5f:
-            cycle += ld_e_a();
+            state.cycle += ld_e_a();
             break;
         case 0x60:
-            cycle += ld_h_b();
+            state.cycle += ld_h_b();
             break;
         case 0x61:
-            cycle += ld_h_c();
+            state.cycle += ld_h_c();
             break;
         case 0x62:
-            cycle += ld_h_d();
+            state.cycle += ld_h_d();
             break;
         case 0x63:
-            cycle += ld_h_e();
+            state.cycle += ld_h_e();
             break;
         case 0x64:
-            cycle += ld_h_h();
+            state.cycle += ld_h_h();
             break;
         case 0x65:
-            cycle += ld_h_l();
+            state.cycle += ld_h_l();
             break;
         case 0x66:
-            cycle += ld_h_addr_hl();
+            state.cycle += ld_h_addr_hl();
             break;
         case 0x67:
-            cycle += ld_h_a();
+            state.cycle += ld_h_a();
             break;
         case 0x68:
-            cycle += ld_l_b();
+            state.cycle += ld_l_b();
             break;
         case 0x69:
-            cycle += ld_l_c();
+            state.cycle += ld_l_c();
             break;
         case 0x6a:
-            cycle += ld_l_d();
+            state.cycle += ld_l_d();
             break;
         case 0x6b:
-            cycle += ld_l_e();
+            state.cycle += ld_l_e();
             break;
         case 0x6c:
-            cycle += ld_l_h();
+            state.cycle += ld_l_h();
             break;
         case 0x6d:
-            cycle += ld_l_l();
+            state.cycle += ld_l_l();
             break;
         case 0x6e:
-            cycle += ld_l_addr_hl();
+            state.cycle += ld_l_addr_hl();
             break;
         case 0x6f:
-            cycle += ld_l_a();
+            state.cycle += ld_l_a();
             break;
         case 0x70:
-            cycle += ld_addr_hl_b();
+            state.cycle += ld_addr_hl_b();
             break;
         case 0x71:
-            cycle += ld_addr_hl_c();
+            state.cycle += ld_addr_hl_c();
             break;
         case 0x72:
-            cycle += ld_addr_hl_d();
+            state.cycle += ld_addr_hl_d();
             break;
         case 0x73:
-            cycle += ld_addr_hl_e();
+            state.cycle += ld_addr_hl_e();
             break;
         case 0x74:
-            cycle += ld_addr_hl_h();
+            state.cycle += ld_addr_hl_h();
             break;
         case 0x75:
-            cycle += ld_addr_hl_l();
+            state.cycle += ld_addr_hl_l();
             break;
         case 0x76:
-            cycle += halt();
+            state.cycle += halt();
             break;
         case 0x77:
-            cycle += ld_addr_hl_a();
+            state.cycle += ld_addr_hl_a();
             break;
         case 0x78:
-            cycle += ld_a_b();
+            state.cycle += ld_a_b();
             break;
         case 0x79:
-            cycle += ld_a_c();
+            state.cycle += ld_a_c();
             break;
         case 0x7a:
-            cycle += ld_a_d();
+            state.cycle += ld_a_d();
             break;
         case 0x7b:
-            cycle += ld_a_e();
+            state.cycle += ld_a_e();
             break;
         case 0x7c:
-            cycle += ld_a_h();
+            state.cycle += ld_a_h();
             break;
         case 0x7d:
-            cycle += ld_a_l();
+            state.cycle += ld_a_l();
             break;
         case 0x7e:
-            cycle += ld_a_addr_hl();
+            state.cycle += ld_a_addr_hl();
             break;
         case 0x7f:
-            cycle += ld_a_a();
+            state.cycle += ld_a_a();
             break;
         case 0x80:
-            cycle += add_a_b();
+            state.cycle += add_a_b();
             break;
         case 0x81:
-            cycle += add_a_c();
+            state.cycle += add_a_c();
             break;
         case 0x82:
-            cycle += add_a_d();
+            state.cycle += add_a_d();
             break;
         case 0x83:
-            cycle += add_a_e();
+            state.cycle += add_a_e();
             break;
         case 0x84:
-            cycle += add_a_h();
+            state.cycle += add_a_h();
             break;
         case 0x85:
-            cycle += add_a_l();
+            state.cycle += add_a_l();
             break;
         case 0x86:
-            cycle += add_a_addr_hl();
+            state.cycle += add_a_addr_hl();
             break;
         case 0x87:
-            cycle += add_a_a();
+            state.cycle += add_a_a();
             break;
         case 0x88:
-            cycle += adc_a_b();
+            state.cycle += adc_a_b();
             break;
         case 0x89:
-            cycle += adc_a_c();
+            state.cycle += adc_a_c();
             break;
         case 0x8a:
-            cycle += adc_a_d();
+            state.cycle += adc_a_d();
             break;
         case 0x8b:
-            cycle += adc_a_e();
+            state.cycle += adc_a_e();
             break;
         case 0x8c:
-            cycle += adc_a_h();
+            state.cycle += adc_a_h();
             break;
         case 0x8d:
-            cycle += adc_a_l();
+            state.cycle += adc_a_l();
             break;
         case 0x8e:
-            cycle += adc_a_addr_hl();
+            state.cycle += adc_a_addr_hl();
             break;
         case 0x8f:
-            cycle += adc_a_a();
+            state.cycle += adc_a_a();
             break;
         case 0x90:
-            cycle += sub_b();
+            state.cycle += sub_b();
             break;
         case 0x91:
-            cycle += sub_c();
+            state.cycle += sub_c();
             break;
         case 0x92:
-            cycle += sub_d();
+            state.cycle += sub_d();
             break;
         case 0x93:
-            cycle += sub_e();
+            state.cycle += sub_e();
             break;
         case 0x94:
-            cycle += sub_h();
+            state.cycle += sub_h();
             break;
         case 0x95:
-            cycle += sub_l();
+            state.cycle += sub_l();
             break;
         case 0x96:
-            cycle += sub_addr_hl();
+            state.cycle += sub_addr_hl();
             break;
         case 0x97:
-            cycle += sub_a();
+            state.cycle += sub_a();
             break;
         case 0x98:
-            cycle += sbc_a_b();
+            state.cycle += sbc_a_b();
             break;
         case 0x99:
-            cycle += sbc_a_c();
+            state.cycle += sbc_a_c();
             break;
         case 0x9a:
-            cycle += sbc_a_d();
+            state.cycle += sbc_a_d();
             break;
         case 0x9b:
-            cycle += sbc_a_e();
+            state.cycle += sbc_a_e();
             break;
         case 0x9c:
-            cycle += sbc_a_h();
+            state.cycle += sbc_a_h();
             break;
         case 0x9d:
-            cycle += sbc_a_l();
+            state.cycle += sbc_a_l();
             break;
         case 0x9e:
-            cycle += sbc_a_addr_hl();
+            state.cycle += sbc_a_addr_hl();
             break;
         case 0x9f:
-            cycle += sbc_a_a();
+            state.cycle += sbc_a_a();
             break;
         case 0xa0:
-            cycle += and_b();
+            state.cycle += and_b();
             break;
         case 0xa1:
-            cycle += and_c();
+            state.cycle += and_c();
             break;
         case 0xa2:
-            cycle += and_d();
+            state.cycle += and_d();
             break;
         case 0xa3:
-            cycle += and_e();
+            state.cycle += and_e();
             break;
         case 0xa4:
-            cycle += and_h();
+            state.cycle += and_h();
             break;
         case 0xa5:
-            cycle += and_l();
+            state.cycle += and_l();
             break;
         case 0xa6:
-            cycle += and_addr_hl();
+            state.cycle += and_addr_hl();
             break;
         case 0xa7:
-            cycle += and_a();
+            state.cycle += and_a();
             break;
         case 0xa8:
-            cycle += xor_b();
+            state.cycle += xor_b();
             break;
         case 0xa9:
-            cycle += xor_c();
+            state.cycle += xor_c();
             break;
         case 0xaa:
-            cycle += xor_d();
+            state.cycle += xor_d();
             break;
         case 0xab:
-            cycle += xor_e();
+            state.cycle += xor_e();
             break;
         case 0xac:
-            cycle += xor_h();
+            state.cycle += xor_h();
             break;
         case 0xad:
-            cycle += xor_l();
+            state.cycle += xor_l();
             break;
         case 0xae:
-            cycle += xor_addr_hl();
+            state.cycle += xor_addr_hl();
             break;
         case 0xaf:
-            cycle += xor_a();
+            state.cycle += xor_a();
             break;
         case 0xb0:
-            cycle += or_b();
+            state.cycle += or_b();
             break;
         case 0xb1:
-            cycle += or_c();
+            state.cycle += or_c();
             break;
         case 0xb2:
-            cycle += or_d();
+            state.cycle += or_d();
             break;
         case 0xb3:
-            cycle += or_e();
+            state.cycle += or_e();
             break;
         case 0xb4:
-            cycle += or_h();
+            state.cycle += or_h();
             break;
         case 0xb5:
-            cycle += or_l();
+            state.cycle += or_l();
             break;
         case 0xb6:
-            cycle += or_addr_hl();
+            state.cycle += or_addr_hl();
             break;
         case 0xb7:
-            cycle += or_a();
+            state.cycle += or_a();
             break;
         case 0xb8:
-            cycle += cp_b();
+            state.cycle += cp_b();
             break;
         case 0xb9:
-            cycle += cp_c();
+            state.cycle += cp_c();
             break;
         case 0xba:
-            cycle += cp_d();
+            state.cycle += cp_d();
             break;
         case 0xbb:
-            cycle += cp_e();
+            state.cycle += cp_e();
             break;
         case 0xbc:
-            cycle += cp_h();
+            state.cycle += cp_h();
             break;
         case 0xbd:
-            cycle += cp_l();
+            state.cycle += cp_l();
             break;
         case 0xbe:
-            cycle += cp_addr_hl();
+            state.cycle += cp_addr_hl();
             break;
         case 0xbf:
-            cycle += cp_a();
+            state.cycle += cp_a();
             break;
         case 0xc0:
-            cycle += ret_nz();
+            state.cycle += ret_nz();
             break;
         case 0xc1:
-            cycle += pop_bc();
+            state.cycle += pop_bc();
             break;
         case 0xc2:
-            cycle += jp_nz_a16();
+            state.cycle += jp_nz_a16();
             break;
         case 0xc3:
-            cycle += jp_a16();
+            state.cycle += jp_a16();
             break;
         case 0xc4:
-            cycle += call_nz_a16();
+            state.cycle += call_nz_a16();
             break;
         case 0xc5:
-            cycle += push_bc();
+            state.cycle += push_bc();
             break;
         case 0xc6:
-            cycle += add_a_d8();
+            state.cycle += add_a_d8();
             break;
         case 0xc7:
-            cycle += rst_00h();
+            state.cycle += rst_00h();
             break;
         case 0xc8:
-            cycle += ret_z();
+            state.cycle += ret_z();
             break;
         case 0xc9:
-            cycle += ret();
+            state.cycle += ret();
             break;
         case 0xca:
-            cycle += jp_z_a16();
+            state.cycle += jp_z_a16();
             break;
         case 0xcc:
-            cycle += call_z_a16();
+            state.cycle += call_z_a16();
             break;
         case 0xcd:
-            cycle += call_a16();
+            state.cycle += call_a16();
             break;
         case 0xce:
-            cycle += adc_a_d8();
+            state.cycle += adc_a_d8();
             break;
         case 0xcf:
-            cycle += rst_08h();
+            state.cycle += rst_08h();
             break;
         case 0xd0:
-            cycle += ret_nc();
+            state.cycle += ret_nc();
             break;
         case 0xd1:
-            cycle += pop_de();
+            state.cycle += pop_de();
             break;
         case 0xd2:
-            cycle += jp_nc_a16();
+            state.cycle += jp_nc_a16();
             break;
         case 0xd3:
-            cycle += invalid();
+            state.cycle += invalid();
             break;
         case 0xd4:
-            cycle += call_nc_a16();
+            state.cycle += call_nc_a16();
             break;
         case 0xd5:
-            cycle += push_de();
+            state.cycle += push_de();
             break;
         case 0xd6:
-            cycle += sub_d8();
+            state.cycle += sub_d8();
             break;
         case 0xd7:
-            cycle += rst_10h();
+            state.cycle += rst_10h();
             break;
         case 0xd8:
-            cycle += ret_c();
+            state.cycle += ret_c();
             break;
         case 0xd9:
-            cycle += reti();
+            state.cycle += reti();
             break;
         case 0xda:
-            cycle += jp_c_a16();
+            state.cycle += jp_c_a16();
             break;
         case 0xdb:
-            cycle += invalid();
+            state.cycle += invalid();
             break;
         case 0xdc:
-            cycle += call_c_a16();
+            state.cycle += call_c_a16();
             break;
         case 0xdd:
-            cycle += invalid();
+            state.cycle += invalid();
             break;
         case 0xde:
-            cycle += sbc_a_d8();
+            state.cycle += sbc_a_d8();
             break;
         case 0xdf:
-            cycle += rst_18h();
+            state.cycle += rst_18h();
             break;
         case 0xe0:
-            cycle += ldh_a8_a();
+            state.cycle += ldh_a8_a();
             break;
         case 0xe1:
-            cycle += pop_hl();
+            state.cycle += pop_hl();
             break;
         case 0xe2:
-            cycle += ld_addr_c_a();
+            state.cycle += ld_addr_c_a();
             break;
         case 0xe3:
-            cycle += invalid();
+            state.cycle += invalid();
             break;
         case 0xe4:
-            cycle += invalid();
+            state.cycle += invalid();
             break;
         case 0xe5:
-            cycle += push_hl();
+            state.cycle += push_hl();
             break;
         case 0xe6:
-            cycle += and_d8();
+            state.cycle += and_d8();
             break;
         case 0xe7:
-            cycle += rst_20h();
+            state.cycle += rst_20h();
             break;
         case 0xe8:
-            cycle += add_sp_r8();
+            state.cycle += add_sp_r8();
             break;
         case 0xe9:
-            cycle += jp_hl();
+            state.cycle += jp_hl();
             break;
         case 0xea:
-            cycle += ld_a16_a();
+            state.cycle += ld_a16_a();
             break;
         case 0xeb:
-            cycle += invalid();
+            state.cycle += invalid();
             break;
         case 0xec:
-            cycle += invalid();
+            state.cycle += invalid();
             break;
         case 0xed:
-            cycle += invalid();
+            state.cycle += invalid();
             break;
         case 0xee:
-            cycle += xor_d8();
+            state.cycle += xor_d8();
             break;
         case 0xef:
-            cycle += rst_28h();
+            state.cycle += rst_28h();
             break;
         case 0xf0:
-            cycle += ldh_a_a8();
+            state.cycle += ldh_a_a8();
             break;
         case 0xf1:
-            cycle += pop_af();
+            state.cycle += pop_af();
             break;
         case 0xf2:
-            cycle += ld_a_addr_c();
+            state.cycle += ld_a_addr_c();
             break;
         case 0xf3:
-            cycle += di();
+            state.cycle += di();
             break;
         case 0xf4:
-            cycle += invalid();
+            state.cycle += invalid();
             break;
         case 0xf5:
-            cycle += push_af();
+            state.cycle += push_af();
             break;
         case 0xf6:
-            cycle += or_d8();
+            state.cycle += or_d8();
             break;
         case 0xf7:
-            cycle += rst_30h();
+            state.cycle += rst_30h();
             break;
         case 0xf8:
-            cycle += ld_hl_sp_plus_r8();
+            state.cycle += ld_hl_sp_plus_r8();
             break;
         case 0xf9:
-            cycle += ld_sp_hl();
+            state.cycle += ld_sp_hl();
             break;
         case 0xfa:
-            cycle += ld_a_a16();
+            state.cycle += ld_a_a16();
             break;
         case 0xfb:
-            cycle += ei();
+            state.cycle += ei();
             break;
         case 0xfc:
-            cycle += invalid();
+            state.cycle += invalid();
             break;
         case 0xfd:
-            cycle = invalid();
+            state.cycle = invalid();
             break;
         case 0xfe:
-            cycle += cp_d8();
+            state.cycle += cp_d8();
             break;
         case 0xff:
-            cycle += rst_38h();
+            state.cycle += rst_38h();
             break;
 
         case 0xcb:
-            std::uint8_t byte_2 = read(pc);
-            ++pc;
+            std::uint8_t byte_2 = read(state.pc);
+            ++state.pc;
 
             switch (byte_2)
             {
             case 0x00:
-                cycle += rlc_b();
+                state.cycle += rlc_b();
                 break;
             case 0x01:
-                cycle += rlc_c();
+                state.cycle += rlc_c();
                 break;
             case 0x02:
-                cycle += rlc_d();
+                state.cycle += rlc_d();
                 break;
             case 0x03:
-                cycle += rlc_e();
+                state.cycle += rlc_e();
                 break;
             case 0x04:
-                cycle += rlc_h();
+                state.cycle += rlc_h();
                 break;
             case 0x05:
-                cycle += rlc_l();
+                state.cycle += rlc_l();
                 break;
             case 0x06:
-                cycle += rlc_addr_hl();
+                state.cycle += rlc_addr_hl();
                 break;
             case 0x07:
-                cycle += rlc_a();
+                state.cycle += rlc_a();
                 break;
             case 0x08:
-                cycle += rrc_b();
+                state.cycle += rrc_b();
                 break;
             case 0x09:
-                cycle += rrc_c();
+                state.cycle += rrc_c();
                 break;
             case 0x0a:
-                cycle += rrc_d();
+                state.cycle += rrc_d();
                 break;
             case 0x0b:
-                cycle += rrc_e();
+                state.cycle += rrc_e();
                 break;
             case 0x0c:
-                cycle += rrc_h();
+                state.cycle += rrc_h();
                 break;
             case 0x0d:
-                cycle += rrc_l();
+                state.cycle += rrc_l();
                 break;
             case 0x0e:
-                cycle += rrc_addr_hl();
+                state.cycle += rrc_addr_hl();
                 break;
             case 0x0f:
-                cycle += rrc_a();
+                state.cycle += rrc_a();
                 break;
             case 0x10:
-                cycle += rl_b();
+                state.cycle += rl_b();
                 break;
             case 0x11:
-                cycle += rl_c();
+                state.cycle += rl_c();
                 break;
             case 0x12:
-                cycle += rl_d();
+                state.cycle += rl_d();
                 break;
             case 0x13:
-                cycle += rl_e();
+                state.cycle += rl_e();
                 break;
             case 0x14:
-                cycle += rl_h();
+                state.cycle += rl_h();
                 break;
             case 0x15:
-                cycle += rl_l();
+                state.cycle += rl_l();
                 break;
             case 0x16:
-                cycle += rl_addr_hl();
+                state.cycle += rl_addr_hl();
                 break;
             case 0x17:
-                cycle += rl_a();
+                state.cycle += rl_a();
                 break;
             case 0x18:
-                cycle += rr_b();
+                state.cycle += rr_b();
                 break;
             case 0x19:
-                cycle += rr_c();
+                state.cycle += rr_c();
                 break;
             case 0x1a:
-                cycle += rr_d();
+                state.cycle += rr_d();
                 break;
             case 0x1b:
-                cycle += rr_e();
+                state.cycle += rr_e();
                 break;
             case 0x1c:
-                cycle += rr_h();
+                state.cycle += rr_h();
                 break;
             case 0x1d:
-                cycle += rr_l();
+                state.cycle += rr_l();
                 break;
             case 0x1e:
-                cycle += rr_addr_hl();
+                state.cycle += rr_addr_hl();
                 break;
             case 0x1f:
-                cycle += rr_a();
+                state.cycle += rr_a();
                 break;
             case 0x20:
-                cycle += sla_b();
+                state.cycle += sla_b();
                 break;
             case 0x21:
-                cycle += sla_c();
+                state.cycle += sla_c();
                 break;
             case 0x22:
-                cycle += sla_d();
+                state.cycle += sla_d();
                 break;
             case 0x23:
-                cycle += sla_e();
+                state.cycle += sla_e();
                 break;
             case 0x24:
-                cycle += sla_h();
+                state.cycle += sla_h();
                 break;
             case 0x25:
-                cycle += sla_l();
+                state.cycle += sla_l();
                 break;
             case 0x26:
-                cycle += sla_addr_hl();
+                state.cycle += sla_addr_hl();
                 break;
             case 0x27:
-                cycle += sla_a();
+                state.cycle += sla_a();
                 break;
             case 0x28:
-                cycle += sra_b();
+                state.cycle += sra_b();
                 break;
             case 0x29:
-                cycle += sra_c();
+                state.cycle += sra_c();
                 break;
             case 0x2a:
-                cycle += sra_d();
+                state.cycle += sra_d();
                 break;
             case 0x2b:
-                cycle += sra_e();
+                state.cycle += sra_e();
                 break;
             case 0x2c:
-                cycle += sra_h();
+                state.cycle += sra_h();
                 break;
             case 0x2d:
-                cycle += sra_l();
+                state.cycle += sra_l();
                 break;
             case 0x2e:
-                cycle += sra_addr_hl();
+                state.cycle += sra_addr_hl();
                 break;
             case 0x2f:
-                cycle += sra_a();
+                state.cycle += sra_a();
                 break;
             case 0x30:
-                cycle += swap_b();
+                state.cycle += swap_b();
                 break;
             case 0x31:
-                cycle += swap_c();
+                state.cycle += swap_c();
                 break;
             case 0x32:
-                cycle += swap_d();
+                state.cycle += swap_d();
                 break;
             case 0x33:
-                cycle += swap_e();
+                state.cycle += swap_e();
                 break;
             case 0x34:
-                cycle += swap_h();
+                state.cycle += swap_h();
                 break;
             case 0x35:
-                cycle += swap_l();
+                state.cycle += swap_l();
                 break;
             case 0x36:
-                cycle += swap_addr_hl();
+                state.cycle += swap_addr_hl();
                 break;
             case 0x37:
-                cycle += swap_a();
+                state.cycle += swap_a();
                 break;
             case 0x38:
-                cycle += srl_b();
+                state.cycle += srl_b();
                 break;
             case 0x39:
-                cycle += srl_c();
+                state.cycle += srl_c();
                 break;
             case 0x3a:
-                cycle += srl_d();
+                state.cycle += srl_d();
                 break;
             case 0x3b:
-                cycle += srl_e();
+                state.cycle += srl_e();
                 break;
             case 0x3c:
-                cycle += srl_h();
+                state.cycle += srl_h();
                 break;
             case 0x3d:
-                cycle += srl_l();
+                state.cycle += srl_l();
                 break;
             case 0x3e:
-                cycle += srl_addr_hl();
+                state.cycle += srl_addr_hl();
                 break;
             case 0x3f:
-                cycle += srl_a();
+                state.cycle += srl_a();
                 break;
             case 0x40:
-                cycle += bit_0_b();
+                state.cycle += bit_0_b();
                 break;
             case 0x41:
-                cycle += bit_0_c();
+                state.cycle += bit_0_c();
                 break;
             case 0x42:
-                cycle += bit_0_d();
+                state.cycle += bit_0_d();
                 break;
             case 0x43:
-                cycle += bit_0_e();
+                state.cycle += bit_0_e();
                 break;
             case 0x44:
-                cycle += bit_0_h();
+                state.cycle += bit_0_h();
                 break;
             case 0x45:
-                cycle += bit_0_l();
+                state.cycle += bit_0_l();
                 break;
             case 0x46:
-                cycle += bit_0_addr_hl();
+                state.cycle += bit_0_addr_hl();
                 break;
             case 0x47:
-                cycle += bit_0_a();
+                state.cycle += bit_0_a();
                 break;
             case 0x48:
-                cycle += bit_1_b();
+                state.cycle += bit_1_b();
                 break;
             case 0x49:
-                cycle += bit_1_c();
+                state.cycle += bit_1_c();
                 break;
             case 0x4a:
-                cycle += bit_1_d();
+                state.cycle += bit_1_d();
                 break;
             case 0x4b:
-                cycle += bit_1_e();
+                state.cycle += bit_1_e();
                 break;
             case 0x4c:
-                cycle += bit_1_h();
+                state.cycle += bit_1_h();
                 break;
             case 0x4d:
-                cycle += bit_1_l();
+                state.cycle += bit_1_l();
                 break;
             case 0x4e:
-                cycle += bit_1_addr_hl();
+                state.cycle += bit_1_addr_hl();
                 break;
             case 0x4f:
-                cycle += bit_1_a();
+                state.cycle += bit_1_a();
                 break;
             case 0x50:
-                cycle += bit_2_b();
+                state.cycle += bit_2_b();
                 break;
             case 0x51:
-                cycle += bit_2_c();
+                state.cycle += bit_2_c();
                 break;
             case 0x52:
-                cycle += bit_2_d();
+                state.cycle += bit_2_d();
                 break;
             case 0x53:
-                cycle += bit_2_e();
+                state.cycle += bit_2_e();
                 break;
             case 0x54:
-                cycle += bit_2_h();
+                state.cycle += bit_2_h();
                 break;
             case 0x55:
-                cycle += bit_2_l();
+                state.cycle += bit_2_l();
                 break;
             case 0x56:
-                cycle += bit_2_addr_hl();
+                state.cycle += bit_2_addr_hl();
                 break;
             case 0x57:
-                cycle += bit_2_a();
+                state.cycle += bit_2_a();
                 break;
             case 0x58:
-                cycle += bit_3_b();
+                state.cycle += bit_3_b();
                 break;
             case 0x59:
-                cycle += bit_3_c();
+                state.cycle += bit_3_c();
                 break;
             case 0x5a:
-                cycle += bit_3_d();
+                state.cycle += bit_3_d();
                 break;
             case 0x5b:
-                cycle += bit_3_e();
+                state.cycle += bit_3_e();
                 break;
             case 0x5c:
-                cycle += bit_3_h();
+                state.cycle += bit_3_h();
                 break;
             case 0x5d:
-                cycle += bit_3_l();
+                state.cycle += bit_3_l();
                 break;
             case 0x5e:
-                cycle += bit_3_addr_hl();
+                state.cycle += bit_3_addr_hl();
                 break;
             case 0x5f:
-                cycle += bit_3_a();
+                state.cycle += bit_3_a();
                 break;
             case 0x60:
-                cycle += bit_4_b();
+                state.cycle += bit_4_b();
                 break;
             case 0x61:
-                cycle += bit_4_c();
+                state.cycle += bit_4_c();
                 break;
             case 0x62:
-                cycle += bit_4_d();
+                state.cycle += bit_4_d();
                 break;
             case 0x63:
-                cycle += bit_4_e();
+                state.cycle += bit_4_e();
                 break;
             case 0x64:
-                cycle += bit_4_h();
+                state.cycle += bit_4_h();
                 break;
             case 0x65:
-                cycle += bit_4_l();
+                state.cycle += bit_4_l();
                 break;
             case 0x66:
-                cycle += bit_4_addr_hl();
+                state.cycle += bit_4_addr_hl();
                 break;
             case 0x67:
-                cycle += bit_4_a();
+                state.cycle += bit_4_a();
                 break;
             case 0x68:
-                cycle += bit_5_b();
+                state.cycle += bit_5_b();
                 break;
             case 0x69:
-                cycle += bit_5_c();
+                state.cycle += bit_5_c();
                 break;
             case 0x6a:
-                cycle += bit_5_d();
+                state.cycle += bit_5_d();
                 break;
             case 0x6b:
-                cycle += bit_5_e();
+                state.cycle += bit_5_e();
                 break;
             case 0x6c:
-                cycle += bit_5_h();
+                state.cycle += bit_5_h();
                 break;
             case 0x6d:
-                cycle += bit_5_l();
+                state.cycle += bit_5_l();
                 break;
             case 0x6e:
-                cycle += bit_5_addr_hl();
+                state.cycle += bit_5_addr_hl();
                 break;
             case 0x6f:
-                cycle += bit_5_a();
+                state.cycle += bit_5_a();
                 break;
             case 0x70:
-                cycle += bit_6_b();
+                state.cycle += bit_6_b();
                 break;
             case 0x71:
-                cycle += bit_6_c();
+                state.cycle += bit_6_c();
                 break;
             case 0x72:
-                cycle += bit_6_d();
+                state.cycle += bit_6_d();
                 break;
             case 0x73:
-                cycle += bit_6_e();
+                state.cycle += bit_6_e();
                 break;
             case 0x74:
-                cycle += bit_6_h();
+                state.cycle += bit_6_h();
                 break;
             case 0x75:
-                cycle += bit_6_l();
+                state.cycle += bit_6_l();
                 break;
             case 0x76:
-                cycle += bit_6_addr_hl();
+                state.cycle += bit_6_addr_hl();
                 break;
             case 0x77:
-                cycle += bit_6_a();
+                state.cycle += bit_6_a();
                 break;
             case 0x78:
-                cycle += bit_7_b();
+                state.cycle += bit_7_b();
                 break;
             case 0x79:
-                cycle += bit_7_c();
+                state.cycle += bit_7_c();
                 break;
             case 0x7a:
-                cycle += bit_7_d();
+                state.cycle += bit_7_d();
                 break;
             case 0x7b:
-                cycle += bit_7_e();
+                state.cycle += bit_7_e();
                 break;
             case 0x7c:
-                cycle += bit_7_h();
+                state.cycle += bit_7_h();
                 break;
             case 0x7d:
-                cycle += bit_7_l();
+                state.cycle += bit_7_l();
                 break;
             case 0x7e:
-                cycle += bit_7_addr_hl();
+                state.cycle += bit_7_addr_hl();
                 break;
             case 0x7f:
-                cycle += bit_7_a();
+                state.cycle += bit_7_a();
                 break;
             case 0x80:
-                cycle += res_0_b();
+                state.cycle += res_0_b();
                 break;
             case 0x81:
-                cycle += res_0_c();
+                state.cycle += res_0_c();
                 break;
             case 0x82:
-                cycle += res_0_d();
+                state.cycle += res_0_d();
                 break;
             case 0x83:
-                cycle += res_0_e();
+                state.cycle += res_0_e();
                 break;
             case 0x84:
-                cycle += res_0_h();
+                state.cycle += res_0_h();
                 break;
             case 0x85:
-                cycle += res_0_l();
+                state.cycle += res_0_l();
                 break;
             case 0x86:
-                cycle += res_0_addr_hl();
+                state.cycle += res_0_addr_hl();
                 break;
             case 0x87:
-                cycle += res_0_a();
+                state.cycle += res_0_a();
                 break;
             case 0x88:
-                cycle += res_1_b();
+                state.cycle += res_1_b();
                 break;
             case 0x89:
-                cycle += res_1_c();
+                state.cycle += res_1_c();
                 break;
             case 0x8a:
-                cycle += res_1_d();
+                state.cycle += res_1_d();
                 break;
             case 0x8b:
-                cycle += res_1_e();
+                state.cycle += res_1_e();
                 break;
             case 0x8c:
-                cycle += res_1_h();
+                state.cycle += res_1_h();
                 break;
             case 0x8d:
-                cycle += res_1_l();
+                state.cycle += res_1_l();
                 break;
             case 0x8e:
-                cycle += res_1_addr_hl();
+                state.cycle += res_1_addr_hl();
                 break;
             case 0x8f:
-                cycle += res_1_a();
+                state.cycle += res_1_a();
                 break;
             case 0x90:
-                cycle += res_2_b();
+                state.cycle += res_2_b();
                 break;
             case 0x91:
-                cycle += res_2_c();
+                state.cycle += res_2_c();
                 break;
             case 0x92:
-                cycle += res_2_d();
+                state.cycle += res_2_d();
                 break;
             case 0x93:
-                cycle += res_2_e();
+                state.cycle += res_2_e();
                 break;
             case 0x94:
-                cycle += res_2_h();
+                state.cycle += res_2_h();
                 break;
             case 0x95:
-                cycle += res_2_l();
+                state.cycle += res_2_l();
                 break;
             case 0x96:
-                cycle += res_2_addr_hl();
+                state.cycle += res_2_addr_hl();
                 break;
             case 0x97:
-                cycle += res_2_a();
+                state.cycle += res_2_a();
                 break;
             case 0x98:
-                cycle += res_3_b();
+                state.cycle += res_3_b();
                 break;
             case 0x99:
-                cycle += res_3_c();
+                state.cycle += res_3_c();
                 break;
             case 0x9a:
-                cycle += res_3_d();
+                state.cycle += res_3_d();
                 break;
             case 0x9b:
-                cycle += res_3_e();
+                state.cycle += res_3_e();
                 break;
             case 0x9c:
-                cycle += res_3_h();
+                state.cycle += res_3_h();
                 break;
             case 0x9d:
-                cycle += res_3_l();
+                state.cycle += res_3_l();
                 break;
             case 0x9e:
-                cycle += res_3_addr_hl();
+                state.cycle += res_3_addr_hl();
                 break;
             case 0x9f:
-                cycle += res_3_a();
+                state.cycle += res_3_a();
                 break;
             case 0xa0:
-                cycle += res_4_b();
+                state.cycle += res_4_b();
                 break;
             case 0xa1:
-                cycle += res_4_c();
+                state.cycle += res_4_c();
                 break;
             case 0xa2:
-                cycle += res_4_d();
+                state.cycle += res_4_d();
                 break;
             case 0xa3:
-                cycle += res_4_e();
+                state.cycle += res_4_e();
                 break;
             case 0xa4:
-                cycle += res_4_h();
+                state.cycle += res_4_h();
                 break;
             case 0xa5:
-                cycle += res_4_l();
+                state.cycle += res_4_l();
                 break;
             case 0xa6:
-                cycle += res_4_addr_hl();
+                state.cycle += res_4_addr_hl();
                 break;
             case 0xa7:
-                cycle += res_4_a();
+                state.cycle += res_4_a();
                 break;
             case 0xa8:
-                cycle += res_5_b();
+                state.cycle += res_5_b();
                 break;
             case 0xa9:
-                cycle += res_5_c();
+                state.cycle += res_5_c();
                 break;
             case 0xaa:
-                cycle += res_5_d();
+                state.cycle += res_5_d();
                 break;
             case 0xab:
-                cycle += res_5_e();
+                state.cycle += res_5_e();
                 break;
             case 0xac:
-                cycle += res_5_h();
+                state.cycle += res_5_h();
                 break;
             case 0xad:
-                cycle += res_5_l();
+                state.cycle += res_5_l();
                 break;
             case 0xae:
-                cycle += res_5_addr_hl();
+                state.cycle += res_5_addr_hl();
                 break;
             case 0xaf:
-                cycle += res_5_a();
+                state.cycle += res_5_a();
                 break;
             case 0xb0:
-                cycle += res_6_b();
+                state.cycle += res_6_b();
                 break;
             case 0xb1:
-                cycle += res_6_c();
+                state.cycle += res_6_c();
                 break;
             case 0xb2:
-                cycle += res_6_d();
+                state.cycle += res_6_d();
                 break;
             case 0xb3:
-                cycle += res_6_e();
+                state.cycle += res_6_e();
                 break;
             case 0xb4:
-                cycle += res_6_h();
+                state.cycle += res_6_h();
                 break;
             case 0xb5:
-                cycle += res_6_l();
+                state.cycle += res_6_l();
                 break;
             case 0xb6:
-                cycle += res_6_addr_hl();
+                state.cycle += res_6_addr_hl();
                 break;
             case 0xb7:
-                cycle += res_6_a();
+                state.cycle += res_6_a();
                 break;
             case 0xb8:
-                cycle += res_7_b();
+                state.cycle += res_7_b();
                 break;
             case 0xb9:
-                cycle += res_7_c();
+                state.cycle += res_7_c();
                 break;
             case 0xba:
-                cycle += res_7_d();
+                state.cycle += res_7_d();
                 break;
             case 0xbb:
-                cycle += res_7_e();
+                state.cycle += res_7_e();
                 break;
             case 0xbc:
-                cycle += res_7_h();
+                state.cycle += res_7_h();
                 break;
             case 0xbd:
-                cycle += res_7_l();
+                state.cycle += res_7_l();
                 break;
             case 0xbe:
-                cycle += res_7_addr_hl();
+                state.cycle += res_7_addr_hl();
                 break;
             case 0xbf:
-                cycle += res_7_a();
+                state.cycle += res_7_a();
                 break;
             case 0xc0:
-                cycle += set_0_b();
+                state.cycle += set_0_b();
                 break;
             case 0xc1:
-                cycle += set_0_c();
+                state.cycle += set_0_c();
                 break;
             case 0xc2:
-                cycle += set_0_d();
+                state.cycle += set_0_d();
                 break;
             case 0xc3:
-                cycle += set_0_e();
+                state.cycle += set_0_e();
                 break;
             case 0xc4:
-                cycle += set_0_h();
+                state.cycle += set_0_h();
                 break;
             case 0xc5:
-                cycle += set_0_l();
+                state.cycle += set_0_l();
                 break;
             case 0xc6:
-                cycle += set_0_addr_hl();
+                state.cycle += set_0_addr_hl();
                 break;
             case 0xc7:
-                cycle += set_0_a();
+                state.cycle += set_0_a();
                 break;
             case 0xc8:
-                cycle += set_1_b();
+                state.cycle += set_1_b();
                 break;
             case 0xc9:
-                cycle += set_1_c();
+                state.cycle += set_1_c();
                 break;
             case 0xca:
-                cycle += set_1_d();
+                state.cycle += set_1_d();
                 break;
             case 0xcb:
-                cycle += set_1_e();
+                state.cycle += set_1_e();
                 break;
             case 0xcc:
-                cycle += set_1_h();
+                state.cycle += set_1_h();
                 break;
             case 0xcd:
-                cycle += set_1_l();
+                state.cycle += set_1_l();
                 break;
             case 0xce:
-                cycle += set_1_addr_hl();
+                state.cycle += set_1_addr_hl();
                 break;
             case 0xcf:
-                cycle += set_1_a();
+                state.cycle += set_1_a();
                 break;
             case 0xd0:
-                cycle += set_2_b();
+                state.cycle += set_2_b();
                 break;
             case 0xd1:
-                cycle += set_2_c();
+                state.cycle += set_2_c();
                 break;
             case 0xd2:
-                cycle += set_2_d();
+                state.cycle += set_2_d();
                 break;
             case 0xd3:
-                cycle += set_2_e();
+                state.cycle += set_2_e();
                 break;
             case 0xd4:
-                cycle += set_2_h();
+                state.cycle += set_2_h();
                 break;
             case 0xd5:
-                cycle += set_2_l();
+                state.cycle += set_2_l();
                 break;
             case 0xd6:
-                cycle += set_2_addr_hl();
+                state.cycle += set_2_addr_hl();
                 break;
             case 0xd7:
-                cycle += set_2_a();
+                state.cycle += set_2_a();
                 break;
             case 0xd8:
-                cycle += set_3_b();
+                state.cycle += set_3_b();
                 break;
             case 0xd9:
-                cycle += set_3_c();
+                state.cycle += set_3_c();
                 break;
             case 0xda:
-                cycle += set_3_d();
+                state.cycle += set_3_d();
                 break;
             case 0xdb:
-                cycle += set_3_e();
+                state.cycle += set_3_e();
                 break;
             case 0xdc:
-                cycle += set_3_h();
+                state.cycle += set_3_h();
                 break;
             case 0xdd:
-                cycle += set_3_l();
+                state.cycle += set_3_l();
                 break;
             case 0xde:
-                cycle += set_3_addr_hl();
+                state.cycle += set_3_addr_hl();
                 break;
             case 0xdf:
-                cycle += set_3_a();
+                state.cycle += set_3_a();
                 break;
             case 0xe0:
-                cycle += set_4_b();
+                state.cycle += set_4_b();
                 break;
             case 0xe1:
-                cycle += set_4_c();
+                state.cycle += set_4_c();
                 break;
             case 0xe2:
-                cycle += set_4_d();
+                state.cycle += set_4_d();
                 break;
             case 0xe3:
-                cycle += set_4_e();
+                state.cycle += set_4_e();
                 break;
             case 0xe4:
-                cycle += set_4_h();
+                state.cycle += set_4_h();
                 break;
             case 0xe5:
-                cycle += set_4_l();
+                state.cycle += set_4_l();
                 break;
             case 0xe6:
-                cycle += set_4_addr_hl();
+                state.cycle += set_4_addr_hl();
                 break;
             case 0xe7:
-                cycle += set_4_a();
+                state.cycle += set_4_a();
                 break;
             case 0xe8:
-                cycle += set_5_b();
+                state.cycle += set_5_b();
                 break;
             case 0xe9:
-                cycle += set_5_c();
+                state.cycle += set_5_c();
                 break;
             case 0xea:
-                cycle += set_5_d();
+                state.cycle += set_5_d();
                 break;
             case 0xeb:
-                cycle += set_5_e();
+                state.cycle += set_5_e();
                 break;
             case 0xec:
-                cycle += set_5_h();
+                state.cycle += set_5_h();
                 break;
             case 0xed:
-                cycle += set_5_l();
+                state.cycle += set_5_l();
                 break;
             case 0xee:
-                cycle += set_5_addr_hl();
+                state.cycle += set_5_addr_hl();
                 break;
             case 0xef:
-                cycle += set_5_a();
+                state.cycle += set_5_a();
                 break;
             case 0xf0:
-                cycle += set_6_b();
+                state.cycle += set_6_b();
                 break;
             case 0xf1:
-                cycle += set_6_c();
+                state.cycle += set_6_c();
                 break;
             case 0xf2:
-                cycle += set_6_d();
+                state.cycle += set_6_d();
                 break;
             case 0xf3:
-                cycle += set_6_e();
+                state.cycle += set_6_e();
                 break;
             case 0xf4:
-                cycle += set_6_h();
+                state.cycle += set_6_h();
                 break;
             case 0xf5:
-                cycle += set_6_l();
+                state.cycle += set_6_l();
                 break;
             case 0xf6:
-                cycle += set_6_addr_hl();
+                state.cycle += set_6_addr_hl();
                 break;
             case 0xf7:
-                cycle += set_6_a();
+                state.cycle += set_6_a();
                 break;
             case 0xf8:
-                cycle += set_7_b();
+                state.cycle += set_7_b();
                 break;
             case 0xf9:
-                cycle += set_7_c();
+                state.cycle += set_7_c();
                 break;
             case 0xfa:
-                cycle += set_7_d();
+                state.cycle += set_7_d();
                 break;
             case 0xfb:
-                cycle += set_7_e();
+                state.cycle += set_7_e();
                 break;
             case 0xfc:
-                cycle += set_7_h();
+                state.cycle += set_7_h();
                 break;
             case 0xfd:
-                cycle += set_7_l();
+                state.cycle += set_7_l();
                 break;
             case 0xfe:
-                cycle += set_7_addr_hl();
+                state.cycle += set_7_addr_hl();
                 break;
             case 0xff:
-                cycle += set_7_a();
+                state.cycle += set_7_a();
                 break;
             }
             break;
         }
+
+        if constexpr ((flags & instrumentation::profile) != 0)
+        {
+            profiler->record(gb_bus->current_rom_bank(opcode_pc), opcode_pc, byte_1, cb_opcode, state.cycle);
+        }
     }
-    --cycle;
+    // In double-speed mode an instruction takes half as many ticks; every
+    // cycle count is a multiple of 4, so this always lands on 0.
+    state.cycle -= state.speed;
+    ++state.timestamp;
+}
+
+template void cpu::clock<instrumentation::none>();
+template void cpu::clock<instrumentation::profile>();
+template void cpu::clock<instrumentation::trace>();
+template void cpu::clock<instrumentation::profile | instrumentation::trace>();
+template void cpu::clock<instrumentation::trace | instrumentation::compare>();
+template void cpu::clock<instrumentation::profile | instrumentation::trace | instrumentation::compare>();
+#ifdef GB_DEBUGGER
+template void cpu::clock<instrumentation::debug>();
+#endif
+
+
+// VRAM, WRAM and its echo, HRAM: plain memory with no side effects.
+// Cartridge RAM is left out, since its accesses may reach an MBC register.
+static bool fusible_data(std::uint16_t address)
+{
+    return (0x8000 <= address && address <= 0x9fff) || (0xc000 <= address && address <= 0xfdff) ||
+           (0xff80 <= address && address <= 0xfffe);
+}
+
+// Checked only once the opcode starts a known sequence.
+bool cpu::may_fuse()
+{
+    return fusion && (gb_bus->interrupt_enable() & gb_bus->read_io(0x0f) & 0x1f) == 0 && !gb_bus->watching();
+}
+
+// Superinstructions: hot sequences are run back to back as one group and
+// charged the summed cycle count. A group is built from the regular handlers,
+// is only entered while no interrupt is pending and no watchpoint is set, and
+// only its first instruction may touch I/O registers or the cartridge.
+//
+// It is not cycle-exact: the group is dispatched like a single long
+// instruction, so an interrupt raised while it runs is taken after the whole
+// group rather than after the instruction that was executing, and the later
+// instructions' memory accesses happen up to a dozen cycles early. That is
+// why it only runs when cpu::fusion is set (--fuse); gb_bench
+// --check-fusion compares frame hashes against a run without it.
+// Returns 0 if nothing fused.
+std::uint8_t cpu::fuse(std::uint8_t opcode)
+{
+    std::uint8_t cycles = 0;
+    switch (opcode)
+    {
+    case 0x2a: // ld a,(hl+); ld (de),a; inc de
+        if (gb_bus->peek_mapped(state.pc) == 0x12 && gb_bus->peek_mapped(state.pc + 1) == 0x13 &&
+            fusible_data((state.d << 8) | state.e) && may_fuse())
+        {
+            cycles = ldi_a_addr_hl();
+            ++state.pc;
+            cycles += ld_addr_de_a();
+            ++state.pc;
+            cycles += inc_de();
+            state.instruction_count += 2;
+        }
+        break;
+    case 0x1a: // ld a,(de); ld (hl+),a; inc de
+        if (gb_bus->peek_mapped(state.pc) == 0x22 && gb_bus->peek_mapped(state.pc + 1) == 0x13 &&
+            fusible_data((state.h << 8) | state.l) && may_fuse())
+        {
+            cycles = ld_a_addr_de();
+            ++state.pc;
+            cycles += ldi_addr_hl_a();
+            ++state.pc;
+            cycles += inc_de();
+            state.instruction_count += 2;
+        }
+        break;
+    case 0x05: // dec b; jr nz,r8
+    case 0x0d: // dec c; jr nz,r8
+    case 0x3d: // dec a; jr nz,r8
+        if (gb_bus->peek_mapped(state.pc) == 0x20 && gb_bus->peek_mapped(state.pc + 1) >= 0 && may_fuse())
+        {
+            cycles = opcode == 0x05 ? dec_b() : opcode == 0x0d ? dec_c() : dec_a();
+            ++state.pc;
+            cycles += jr_nz_r8();
+            state.instruction_count += 1;
+        }
+        break;
+    case 0xf0: // ldh a,(a8); and d8; jr z/nz,r8
+    {
+        int branch = gb_bus->peek_mapped(state.pc + 3);
+        // five bytes span at most two pages, so checking both ends covers them
+        if (gb_bus->peek_mapped(state.pc) >= 0 && gb_bus->peek_mapped(state.pc + 1) == 0xe6 && (branch == 0x28 || branch == 0x20) &&
+            gb_bus->peek_mapped(state.pc + 4) >= 0 && may_fuse())
+        {
+            cycles = ldh_a_a8();
+            ++state.pc;
+            cycles += and_d8();
+            ++state.pc;
+            cycles += branch == 0x28 ? jr_z_r8() : jr_nz_r8();
+            state.instruction_count += 2;
+        }
+        break;
+    }
+    case 0xc5: // push rr; pop rr
+    case 0xd5:
+    case 0xe5:
+    case 0xf5:
+    {
+        int next = gb_bus->peek_mapped(state.pc);
+        if (next >= 0 && (next & 0xcf) == 0xc1 && fusible_data(state.sp - 1) && fusible_data(state.sp - 2) && may_fuse())
+        {
+            ++state.pc;
+            cycles = push_pop(opcode, next);
+            state.instruction_count += 1;
+        }
+        break;
+    }
+    }
+    return cycles;
+}
+
+std::uint8_t cpu::push_pop(std::uint8_t push_opcode, std::uint8_t pop_opcode)
+{
+    std::uint8_t cycles;
+    switch (push_opcode)
+    {
+    case 0xc5:
+        cycles = push_bc();
+        break;
+    case 0xd5:
+        cycles = push_de();
+        break;
+    case 0xe5:
+        cycles = push_hl();
+        break;
+    default:
+        cycles = push_af();
+        break;
+    }
+    switch (pop_opcode)
+    {
+    case 0xc1:
+        cycles += pop_bc();
+        break;
+    case 0xd1:
+        cycles += pop_de();
+        break;
+    case 0xe1:
+        cycles += pop_hl();
+        break;
+    default:
+        cycles += pop_af();
+        break;
+    }
+    return cycles;
 }
 
 std::uint8_t cpu::ld_b_b()
 {
-    b = b;
+    state.b = state.b;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_b_c()
 {
-    b = c;
+    state.b = state.c;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_b_d()
 {
-    b = d;
+    state.b = state.d;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_b_e()
 {
-    b = e;
+    state.b = state.e;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_b_h()
 {
-    b = h;
+    state.b = state.h;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_b_l()
 {
-    b = l;
+    state.b = state.l;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_b_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    b = read(ahl);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    state.b = read(ahl);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_b_a()
 {
-    b = a;
+    state.b = state.a;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_c_b()
 {
-    c = b;
+    state.c = state.b;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_c_c()
 {
-    c = c;
+    state.c = state.c;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_c_d()
 {
-    c = d;
+    state.c = state.d;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_c_e()
 {
-    c = e;
+    state.c = state.e;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_c_h()
 {
-    c = h;
+    state.c = state.h;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_c_l()
 {
-    c = l;
+    state.c = state.l;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_c_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    c = read(ahl);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    state.c = read(ahl);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_c_a()
 {
-    c = a;
+    state.c = state.a;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_d_b()
 {
-    d = b;
+    state.d = state.b;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_d_c()
 {
-    d = c;
+    state.d = state.c;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_d_d()
 {
-    d = d;
+    state.d = state.d;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_d_e()
 {
-    d = e;
+    state.d = state.e;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_d_h()
 {
-    d = h;
+    state.d = state.h;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_d_l()
 {
-    d = l;
+    state.d = state.l;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_d_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    d = read(ahl);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    state.d = read(ahl);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_d_a()
 {
-    d = a;
+    state.d = state.a;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_e_b()
 {
-    e = b;
+    state.e = state.b;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_e_c()
 {
-    e = c;
+    state.e = state.c;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_e_d()
 {
-    e = d;
+    state.e = state.d;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_e_e()
 {
-    e = e;
+    state.e = state.e;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_e_h()
 {
-    e = h;
+    state.e = state.h;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_e_l()
 {
-    e = l;
+    state.e = state.l;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_e_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    e = read(ahl);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    state.e = read(ahl);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_e_a()
 {
-    e = a;
+    state.e = state.a;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_h_b()
 {
-    h = b;
+    state.h = state.b;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_h_c()
 {
-    h = c;
+    state.h = state.c;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_h_d()
 {
-    h = d;
+    state.h = state.d;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_h_e()
 {
-    h = e;
+    state.h = state.e;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_h_h()
 {
-    h = h;
+    state.h = state.h;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_h_l()
 {
-    h = l;
+    state.h = state.l;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_h_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    h = read(ahl);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    state.h = read(ahl);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_h_a()
 {
-    h = a;
+    state.h = state.a;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_l_b()
 {
-    l = b;
+    state.l = state.b;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_l_c()
 {
-    l = c;
+    state.l = state.c;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_l_d()
 {
-    l = d;
+    state.l = state.d;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_l_e()
 {
-    l = e;
+    state.l = state.e;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_l_h()
 {
-    l = h;
+    state.l = state.h;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_l_l()
 {
-    l = l;
+    state.l = state.l;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_l_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    l = read(ahl);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    state.l = read(ahl);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_l_a()
 {
-    l = a;
+    state.l = state.a;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_addr_hl_b()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    write(ahl, b);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    write(ahl, state.b);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_addr_hl_c()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    write(ahl, c);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    write(ahl, state.c);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_addr_hl_d()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    write(ahl, d);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    write(ahl, state.d);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_addr_hl_e()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    write(ahl, e);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    write(ahl, state.e);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_addr_hl_h()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    write(ahl, h);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    write(ahl, state.h);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_addr_hl_l()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    write(ahl, l);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    write(ahl, state.l);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_addr_hl_a()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    write(ahl, a);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    write(ahl, state.a);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_a_b()
 {
-    a = b;
+    state.a = state.b;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_a_c()
 {
-    a = c;
+    state.a = state.c;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_a_d()
 {
-    a = d;
+    state.a = state.d;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_a_e()
 {
-    a = e;
+    state.a = state.e;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_a_h()
 {
-    a = h;
+    state.a = state.h;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_a_l()
 {
-    a = l;
+    state.a = state.l;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_a_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    a = read(ahl);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    state.a = read(ahl);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_a_a()
 {
-    a = a;
+    state.a = state.a;
 
     return 4;
 }
 
 std::uint8_t cpu::ld_b_d8()
 {
-    b = read(pc);
-    ++pc;
+    state.b = read(state.pc);
+    ++state.pc;
 
     return 8;
 }
 
 std::uint8_t cpu::ld_c_d8()
 {
-    c = read(pc);
-    ++pc;
+    state.c = read(state.pc);
+    ++state.pc;
 
     return 8;
 }
 
 std::uint8_t cpu::ld_d_d8()
 {
-    d = read(pc);
-    ++pc;
+    state.d = read(state.pc);
+    ++state.pc;
 
     return 8;
 }
 
 std::uint8_t cpu::ld_e_d8()
 {
-    e = read(pc);
-    ++pc;
+    state.e = read(state.pc);
+    ++state.pc;
 
     return 8;
 }
 
 std::uint8_t cpu::ld_h_d8()
 {
-    h = read(pc);
-    ++pc;
+    state.h = read(state.pc);
+    ++state.pc;
 
     return 8;
 }
 
 std::uint8_t cpu::ld_l_d8()
 {
-    l = read(pc);
-    ++pc;
+    state.l = read(state.pc);
+    ++state.pc;
 
     return 8;
 }
 
 std::uint8_t cpu::ld_addr_hl_d8()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    write(ahl, read(pc));
-    ++pc;
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    write(ahl, read(state.pc));
+    ++state.pc;
 
     return 12;
 }
 
 std::uint8_t cpu::ld_a_d8()
 {
-    a = read(pc);
-    ++pc;
+    state.a = read(state.pc);
+    ++state.pc;
 
     return 8;
 }
 
 std::uint8_t cpu::ld_addr_bc_a()
 {
-    std::uint16_t abc = (b << 8) | c;
-    write(abc, a);
+    std::uint16_t abc = (state.b << 8) | state.c;
+    write(abc, state.a);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_addr_de_a()
 {
-    std::uint16_t ade = (d << 8) | e;
-    write(ade, a);
+    std::uint16_t ade = (state.d << 8) | state.e;
+    write(ade, state.a);
 
     return 8;
 }
 
 std::uint8_t cpu::ldi_addr_hl_a()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    write(ahl, a);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    write(ahl, state.a);
     ++ahl;
-    h = ahl >> 8;
-    l = ahl;
+    state.h = ahl >> 8;
+    state.l = ahl;
 
     return 8;
 }
 
 std::uint8_t cpu::ldd_addr_hl_a()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    write(ahl, a);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    write(ahl, state.a);
     --ahl;
-    h = ahl >> 8;
-    l = ahl;
+    state.h = ahl >> 8;
+    state.l = ahl;
 
     return 8;
 }
 
 std::uint8_t cpu::ld_a_addr_bc()
 {
-    std::uint16_t abc = (b << 8) | c;
-    a = read(abc);
+    std::uint16_t abc = (state.b << 8) | state.c;
+    state.a = read(abc);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_a_addr_de()
 {
-    std::uint16_t ade = (d << 8) | e;
-    a = read(ade);
+    std::uint16_t ade = (state.d << 8) | state.e;
+    state.a = read(ade);
 
     return 8;
 }
 
 std::uint8_t cpu::ldi_a_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    a = read(ahl);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    state.a = read(ahl);
     ++ahl;
-    h = ahl >> 8;
-    l = ahl;
+    state.h = ahl >> 8;
+    state.l = ahl;
 
     return 8;
 }
 
 std::uint8_t cpu::ldd_a_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
-    a = read(ahl);
+    std::uint16_t ahl = (state.h << 8) | state.l;
+    state.a = read(ahl);
     --ahl;
-    h = ahl >> 8;
-    l = ahl;
+    state.h = ahl >> 8;
+    state.l = ahl;
 
     return 8;
 }
 
 std::uint8_t cpu::ldh_a8_a()
 {
-    write(0xff00 + read(pc), a);
-    ++pc;
+    write(0xff00 + read(state.pc), state.a);
+    ++state.pc;
 
     return 12;
 }
 
 std::uint8_t cpu::ldh_a_a8()
 {
-    a = read(0xff00 + read(pc));
-    ++pc;
+    state.a = read(0xff00 + read(state.pc));
+    ++state.pc;
 
     return 12;
 }
 
 std::uint8_t cpu::ld_addr_c_a()
 {
-    write(0xff00 + c, a);
+    write(0xff00 + state.c, state.a);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_a_addr_c()
 {
-    a = read(0xff00 + c);
+    state.a = read(0xff00 + state.c);
 
     return 8;
 }
 
 std::uint8_t cpu::ld_a16_a()
 {
-    std::uint16_t a16 = read(pc) | (read(++pc) << 8);
-    ++pc;
-    write(a16, a);
+    std::uint16_t a16 = read(state.pc) | (read(++state.pc) << 8);
+    ++state.pc;
+    write(a16, state.a);
 
     return 16;
 }
 
 std::uint8_t cpu::ld_a_a16()
 {
-    std::uint16_t a16 = read(pc) | (read(++pc) << 8);
-    ++pc;
-    a = read(a16);
+    std::uint16_t a16 = read(state.pc) | (read(++state.pc) << 8);
+    ++state.pc;
+    state.a = read(a16);
 
     return 16;
 }
 
 std::uint8_t cpu::ld_bc_d16()
 {
-    c = read(pc);
-    b = read(++pc);
-    ++pc;
+    state.c = read(state.pc);
+    state.b = read(++state.pc);
+    ++state.pc;
 
     return 12;
 }
 
 std::uint8_t cpu::ld_de_d16()
 {
-    e = read(pc);
-    d = read(++pc);
-    ++pc;
+    state.e = read(state.pc);
+    state.d = read(++state.pc);
+    ++state.pc;
 
     return 12;
 }
 
 std::uint8_t cpu::ld_hl_d16()
 {
-    l = read(pc);
-    h = read(++pc);
-    ++pc;
+    state.l = read(state.pc);
+    state.h = read(++state.pc);
+    ++state.pc;
 
     return 12;
 }
 
 std::uint8_t cpu::ld_sp_d16()
 {
-    std::uint16_t d16 = read(pc) | (read(++pc) << 8);
-    ++pc;
-    sp = d16;
+    std::uint16_t d16 = read(state.pc) | (read(++state.pc) << 8);
+    ++state.pc;
+    state.sp = d16;
 
     return 12;
 }
 
 std::uint8_t cpu::ld_a16_sp()
 {
-    std::uint16_t a16 = read(pc) | (read(++pc) << 8);
-    ++pc;
-    std::uint8_t high = sp >> 8;
-    std::uint8_t low = sp;
+    std::uint16_t a16 = read(state.pc) | (read(++state.pc) << 8);
+    ++state.pc;
+    std::uint8_t high = state.sp >> 8;
+    std::uint8_t low = state.sp;
     write(a16, low);
     write(++a16, high);
 
@@ -2393,142 +2683,142 @@ std::uint8_t cpu::ld_a16_sp()
 
 std::uint8_t cpu::ld_sp_hl()
 {
-    std::uint16_t hl = (h << 8) | l;
-    sp = hl;
+    std::uint16_t hl = (state.h << 8) | state.l;
+    state.sp = hl;
 
     return 8;
 }
 
 std::uint8_t cpu::ld_hl_sp_plus_r8()
 {
-    std::uint16_t hl = (h << 8) | l;
-    std::uint8_t r8 = read(pc);
-    ++pc;
-    f = f & ~(1 << 7);
-    f = f & ~(1 << 6);
-    if (((sp & 0xf) + (r8 & 0xf)) > 0xf)
+    std::uint16_t hl = (state.h << 8) | state.l;
+    std::uint8_t r8 = read(state.pc);
+    ++state.pc;
+    state.f = state.f & ~(1 << 7);
+    state.f = state.f & ~(1 << 6);
+    if (((state.sp & 0xf) + (r8 & 0xf)) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (((sp & 0xff) + r8) > 0xff)
+    if (((state.sp & 0xff) + r8) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    hl = sp + (std::int8_t)r8;
-    h = hl >> 8;
-    l = hl;
+    hl = state.sp + (std::int8_t)r8;
+    state.h = hl >> 8;
+    state.l = hl;
 
     return 12;
 }
 
 std::uint8_t cpu::pop_bc()
 {
-    c = read(sp);
-    ++sp;
-    b = read(sp);
-    ++sp;
+    state.c = read(state.sp);
+    ++state.sp;
+    state.b = read(state.sp);
+    ++state.sp;
 
     return 12;
 }
 
 std::uint8_t cpu::pop_de()
 {
-    e = read(sp);
-    ++sp;
-    d = read(sp);
-    ++sp;
+    state.e = read(state.sp);
+    ++state.sp;
+    state.d = read(state.sp);
+    ++state.sp;
 
     return 12;
 }
 
 std::uint8_t cpu::pop_hl()
 {
-    l = read(sp);
-    ++sp;
-    h = read(sp);
-    ++sp;
+    state.l = read(state.sp);
+    ++state.sp;
+    state.h = read(state.sp);
+    ++state.sp;
 
     return 12;
 }
 
 std::uint8_t cpu::pop_af()
 {
-    f = read(sp);
-    f = f & 0xf0;
-    ++sp;
-    a = read(sp);
-    ++sp;
+    state.f = read(state.sp);
+    state.f = state.f & 0xf0;
+    ++state.sp;
+    state.a = read(state.sp);
+    ++state.sp;
 
     return 12;
 }
 
 std::uint8_t cpu::push_bc()
 {
-    --sp;
-    write(sp, b);
-    --sp;
-    write(sp, c);
+    --state.sp;
+    write(state.sp, state.b);
+    --state.sp;
+    write(state.sp, state.c);
 
     return 16;
 }
 
 std::uint8_t cpu::push_de()
 {
-    --sp;
-    write(sp, d);
-    --sp;
-    write(sp, e);
+    --state.sp;
+    write(state.sp, state.d);
+    --state.sp;
+    write(state.sp, state.e);
 
     return 16;
 }
 
 std::uint8_t cpu::push_hl()
 {
-    --sp;
-    write(sp, h);
-    --sp;
-    write(sp, l);
+    --state.sp;
+    write(state.sp, state.h);
+    --state.sp;
+    write(state.sp, state.l);
 
     return 16;
 }
 
 std::uint8_t cpu::push_af()
 {
-    --sp;
-    write(sp, a);
-    --sp;
-    write(sp, f);
+    --state.sp;
+    write(state.sp, state.a);
+    --state.sp;
+    write(state.sp, state.f);
 
     return 16;
 }
 
 std::uint8_t cpu::inc_b()
 {
-    f = f & ~(1 << 6);
-    if ((b & 0xf) + (1 & 0xf) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if ((state.b & 0xf) + (1 & 0xf) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    ++b;
-    if (b == 0)
+    ++state.b;
+    if (state.b == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2536,23 +2826,23 @@ std::uint8_t cpu::inc_b()
 
 std::uint8_t cpu::inc_c()
 {
-    f = f & ~(1 << 6);
-    if ((c & 0xf) + (1 & 0xf) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if ((state.c & 0xf) + (1 & 0xf) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    ++c;
-    if (c == 0)
+    ++state.c;
+    if (state.c == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2560,23 +2850,23 @@ std::uint8_t cpu::inc_c()
 
 std::uint8_t cpu::inc_d()
 {
-    f = f & ~(1 << 6);
-    if ((d & 0xf) + (1 & 0xf) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if ((state.d & 0xf) + (1 & 0xf) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    ++d;
-    if (d == 0)
+    ++state.d;
+    if (state.d == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2584,23 +2874,23 @@ std::uint8_t cpu::inc_d()
 
 std::uint8_t cpu::inc_e()
 {
-    f = f & ~(1 << 6);
-    if ((e & 0xf) + (1 & 0xf) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if ((state.e & 0xf) + (1 & 0xf) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    ++e;
-    if (e == 0)
+    ++state.e;
+    if (state.e == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2608,23 +2898,23 @@ std::uint8_t cpu::inc_e()
 
 std::uint8_t cpu::inc_h()
 {
-    f = f & ~(1 << 6);
-    if ((h & 0xf) + (1 & 0xf) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if ((state.h & 0xf) + (1 & 0xf) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    ++h;
-    if (h == 0)
+    ++state.h;
+    if (state.h == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2632,23 +2922,23 @@ std::uint8_t cpu::inc_h()
 
 std::uint8_t cpu::inc_l()
 {
-    f = f & ~(1 << 6);
-    if ((l & 0xf) + (1 & 0xf) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if ((state.l & 0xf) + (1 & 0xf) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    ++l;
-    if (l == 0)
+    ++state.l;
+    if (state.l == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2656,26 +2946,26 @@ std::uint8_t cpu::inc_l()
 
 std::uint8_t cpu::inc_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
-    f = f & ~(1 << 6);
+    state.f = state.f & ~(1 << 6);
     if ((memory & 0xf) + (1 & 0xf) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
     ++memory;
     write(ahl, memory);
     if (memory == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 12;
@@ -2683,23 +2973,23 @@ std::uint8_t cpu::inc_addr_hl()
 
 std::uint8_t cpu::inc_a()
 {
-    f = f & ~(1 << 6);
-    if ((a & 0xf) + (1 & 0xf) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if ((state.a & 0xf) + (1 & 0xf) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    ++a;
-    if (a == 0)
+    ++state.a;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2707,23 +2997,23 @@ std::uint8_t cpu::inc_a()
 
 std::uint8_t cpu::dec_b()
 {
-    f = f | (1 << 6);
-    if ((b & 0xf) < (1 & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.b & 0xf) < (1 & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    --b;
-    if (b == 0)
+    --state.b;
+    if (state.b == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2731,23 +3021,23 @@ std::uint8_t cpu::dec_b()
 
 std::uint8_t cpu::dec_c()
 {
-    f = f | (1 << 6);
-    if ((c & 0xf) < (1 & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.c & 0xf) < (1 & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    --c;
-    if (c == 0)
+    --state.c;
+    if (state.c == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2755,23 +3045,23 @@ std::uint8_t cpu::dec_c()
 
 std::uint8_t cpu::dec_d()
 {
-    f = f | (1 << 6);
-    if ((d & 0xf) < (1 & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.d & 0xf) < (1 & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    --d;
-    if (d == 0)
+    --state.d;
+    if (state.d == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2779,23 +3069,23 @@ std::uint8_t cpu::dec_d()
 
 std::uint8_t cpu::dec_e()
 {
-    f = f | (1 << 6);
-    if ((e & 0xf) < (1 & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.e & 0xf) < (1 & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    --e;
-    if (e == 0)
+    --state.e;
+    if (state.e == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2803,23 +3093,23 @@ std::uint8_t cpu::dec_e()
 
 std::uint8_t cpu::dec_h()
 {
-    f = f | (1 << 6);
-    if ((h & 0xf) < (1 & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.h & 0xf) < (1 & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    --h;
-    if (h == 0)
+    --state.h;
+    if (state.h == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2827,23 +3117,23 @@ std::uint8_t cpu::dec_h()
 
 std::uint8_t cpu::dec_l()
 {
-    f = f | (1 << 6);
-    if ((l & 0xf) < (1 & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.l & 0xf) < (1 & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    --l;
-    if (l == 0)
+    --state.l;
+    if (state.l == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2851,26 +3141,26 @@ std::uint8_t cpu::dec_l()
 
 std::uint8_t cpu::dec_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
-    f = f | (1 << 6);
+    state.f = state.f | (1 << 6);
     if ((memory & 0xf) < (1 & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
     --memory;
     write(ahl, memory);
     if (memory == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 12;
@@ -2878,23 +3168,23 @@ std::uint8_t cpu::dec_addr_hl()
 
 std::uint8_t cpu::dec_a()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (1 & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (1 & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    --a;
-    if (a == 0)
+    --state.a;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2902,31 +3192,31 @@ std::uint8_t cpu::dec_a()
 
 std::uint8_t cpu::add_a_b()
 {
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (b & 0xf)) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (state.b & 0xf)) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + b) > 0xff)
+    if ((state.a + state.b) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += b;
-    if (a == 0)
+    state.a += state.b;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2934,31 +3224,31 @@ std::uint8_t cpu::add_a_b()
 
 std::uint8_t cpu::add_a_c()
 {
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (c & 0xf)) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (state.c & 0xf)) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + c) > 0xff)
+    if ((state.a + state.c) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += c;
-    if (a == 0)
+    state.a += state.c;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2966,31 +3256,31 @@ std::uint8_t cpu::add_a_c()
 
 std::uint8_t cpu::add_a_d()
 {
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (d & 0xf)) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (state.d & 0xf)) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + d) > 0xff)
+    if ((state.a + state.d) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += d;
-    if (a == 0)
+    state.a += state.d;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -2998,31 +3288,31 @@ std::uint8_t cpu::add_a_d()
 
 std::uint8_t cpu::add_a_e()
 {
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (e & 0xf)) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (state.e & 0xf)) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + e) > 0xff)
+    if ((state.a + state.e) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += e;
-    if (a == 0)
+    state.a += state.e;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3030,31 +3320,31 @@ std::uint8_t cpu::add_a_e()
 
 std::uint8_t cpu::add_a_h()
 {
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (h & 0xf)) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (state.h & 0xf)) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + h) > 0xff)
+    if ((state.a + state.h) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += h;
-    if (a == 0)
+    state.a += state.h;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3062,31 +3352,31 @@ std::uint8_t cpu::add_a_h()
 
 std::uint8_t cpu::add_a_l()
 {
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (l & 0xf)) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (state.l & 0xf)) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + l) > 0xff)
+    if ((state.a + state.l) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += l;
-    if (a == 0)
+    state.a += state.l;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3094,33 +3384,33 @@ std::uint8_t cpu::add_a_l()
 
 std::uint8_t cpu::add_a_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (memory & 0xf)) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (memory & 0xf)) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + memory) > 0xff)
+    if ((state.a + memory) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += memory;
-    if (a == 0)
+    state.a += memory;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -3128,31 +3418,31 @@ std::uint8_t cpu::add_a_addr_hl()
 
 std::uint8_t cpu::add_a_a()
 {
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (a & 0xf)) > 0xf)
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (state.a & 0xf)) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + a) > 0xff)
+    if ((state.a + state.a) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += a;
-    if (a == 0)
+    state.a += state.a;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3160,32 +3450,32 @@ std::uint8_t cpu::add_a_a()
 
 std::uint8_t cpu::adc_a_b()
 {
-    bool carry_flag = f & (1 << 4);
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (b & 0xf) + carry_flag) > 0xf)
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (state.b & 0xf) + carry_flag) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + b + carry_flag) > 0xff)
+    if ((state.a + state.b + carry_flag) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += b + carry_flag;
-    if (a == 0)
+    state.a += state.b + carry_flag;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3193,32 +3483,32 @@ std::uint8_t cpu::adc_a_b()
 
 std::uint8_t cpu::adc_a_c()
 {
-    bool carry_flag = f & (1 << 4);
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (c & 0xf) + carry_flag) > 0xf)
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (state.c & 0xf) + carry_flag) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + c + carry_flag) > 0xff)
+    if ((state.a + state.c + carry_flag) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += c + carry_flag;
-    if (a == 0)
+    state.a += state.c + carry_flag;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3226,32 +3516,32 @@ std::uint8_t cpu::adc_a_c()
 
 std::uint8_t cpu::adc_a_d()
 {
-    bool carry_flag = f & (1 << 4);
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (d & 0xf) + carry_flag) > 0xf)
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (state.d & 0xf) + carry_flag) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + d + carry_flag) > 0xff)
+    if ((state.a + state.d + carry_flag) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += d + carry_flag;
-    if (a == 0)
+    state.a += state.d + carry_flag;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3259,32 +3549,32 @@ std::uint8_t cpu::adc_a_d()
 
 std::uint8_t cpu::adc_a_e()
 {
-    bool carry_flag = f & (1 << 4);
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (e & 0xf) + carry_flag) > 0xf)
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (state.e & 0xf) + carry_flag) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + e + carry_flag) > 0xff)
+    if ((state.a + state.e + carry_flag) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += e + carry_flag;
-    if (a == 0)
+    state.a += state.e + carry_flag;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3292,32 +3582,32 @@ std::uint8_t cpu::adc_a_e()
 
 std::uint8_t cpu::adc_a_h()
 {
-    bool carry_flag = f & (1 << 4);
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (h & 0xf) + carry_flag) > 0xf)
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (state.h & 0xf) + carry_flag) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + h + carry_flag) > 0xff)
+    if ((state.a + state.h + carry_flag) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += h + carry_flag;
-    if (a == 0)
+    state.a += state.h + carry_flag;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3325,32 +3615,32 @@ std::uint8_t cpu::adc_a_h()
 
 std::uint8_t cpu::adc_a_l()
 {
-    bool carry_flag = f & (1 << 4);
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (l & 0xf) + carry_flag) > 0xf)
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (state.l & 0xf) + carry_flag) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + l + carry_flag) > 0xff)
+    if ((state.a + state.l + carry_flag) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += l + carry_flag;
-    if (a == 0)
+    state.a += state.l + carry_flag;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3358,34 +3648,34 @@ std::uint8_t cpu::adc_a_l()
 
 std::uint8_t cpu::adc_a_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
-    bool carry_flag = f & (1 << 4);
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (memory & 0xf) + carry_flag) > 0xf)
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (memory & 0xf) + carry_flag) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + memory + carry_flag) > 0xff)
+    if ((state.a + memory + carry_flag) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += memory + carry_flag;
-    if (a == 0)
+    state.a += memory + carry_flag;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -3393,32 +3683,32 @@ std::uint8_t cpu::adc_a_addr_hl()
 
 std::uint8_t cpu::adc_a_a()
 {
-    bool carry_flag = f & (1 << 4);
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (a & 0xf) + carry_flag) > 0xf)
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (state.a & 0xf) + carry_flag) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + a + carry_flag) > 0xff)
+    if ((state.a + state.a + carry_flag) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += a + carry_flag;
-    if (a == 0)
+    state.a += state.a + carry_flag;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3426,31 +3716,31 @@ std::uint8_t cpu::adc_a_a()
 
 std::uint8_t cpu::sub_b()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (b & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (state.b & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < b)
+    if (state.a < state.b)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= b;
-    if (a == 0)
+    state.a -= state.b;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3458,31 +3748,31 @@ std::uint8_t cpu::sub_b()
 
 std::uint8_t cpu::sub_c()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (c & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (state.c & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < c)
+    if (state.a < state.c)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= c;
-    if (a == 0)
+    state.a -= state.c;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3490,31 +3780,31 @@ std::uint8_t cpu::sub_c()
 
 std::uint8_t cpu::sub_d()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (d & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (state.d & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < d)
+    if (state.a < state.d)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= d;
-    if (a == 0)
+    state.a -= state.d;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3522,31 +3812,31 @@ std::uint8_t cpu::sub_d()
 
 std::uint8_t cpu::sub_e()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (e & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (state.e & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < e)
+    if (state.a < state.e)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= e;
-    if (a == 0)
+    state.a -= state.e;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3554,31 +3844,31 @@ std::uint8_t cpu::sub_e()
 
 std::uint8_t cpu::sub_h()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (h & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (state.h & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < h)
+    if (state.a < state.h)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= h;
-    if (a == 0)
+    state.a -= state.h;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3586,31 +3876,31 @@ std::uint8_t cpu::sub_h()
 
 std::uint8_t cpu::sub_l()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (l & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (state.l & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < l)
+    if (state.a < state.l)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= l;
-    if (a == 0)
+    state.a -= state.l;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3618,33 +3908,33 @@ std::uint8_t cpu::sub_l()
 
 std::uint8_t cpu::sub_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
-    f = f | (1 << 6);
-    if ((a & 0xf) < (memory & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (memory & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < memory)
+    if (state.a < memory)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= memory;
-    if (a == 0)
+    state.a -= memory;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -3652,31 +3942,31 @@ std::uint8_t cpu::sub_addr_hl()
 
 std::uint8_t cpu::sub_a()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (a & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (state.a & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < a)
+    if (state.a < state.a)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= a;
-    if (a == 0)
+    state.a -= state.a;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3684,32 +3974,32 @@ std::uint8_t cpu::sub_a()
 
 std::uint8_t cpu::sbc_a_b()
 {
-    bool carry_flag = f & (1 << 4);
-    f = f | (1 << 6);
-    if ((a & 0xf) < ((b & 0xf) + carry_flag))
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < ((state.b & 0xf) + carry_flag))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < (b + carry_flag))
+    if (state.a < (state.b + carry_flag))
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= (b + carry_flag);
-    if (a == 0)
+    state.a -= (state.b + carry_flag);
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3717,32 +4007,32 @@ std::uint8_t cpu::sbc_a_b()
 
 std::uint8_t cpu::sbc_a_c()
 {
-    bool carry_flag = f & (1 << 4);
-    f = f | (1 << 6);
-    if ((a & 0xf) < ((c & 0xf) + carry_flag))
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < ((state.c & 0xf) + carry_flag))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < (c + carry_flag))
+    if (state.a < (state.c + carry_flag))
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= (c + carry_flag);
-    if (a == 0)
+    state.a -= (state.c + carry_flag);
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3750,32 +4040,32 @@ std::uint8_t cpu::sbc_a_c()
 
 std::uint8_t cpu::sbc_a_d()
 {
-    bool carry_flag = f & (1 << 4);
-    f = f | (1 << 6);
-    if ((a & 0xf) < ((d & 0xf) + carry_flag))
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < ((state.d & 0xf) + carry_flag))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < (d + carry_flag))
+    if (state.a < (state.d + carry_flag))
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= (d + carry_flag);
-    if (a == 0)
+    state.a -= (state.d + carry_flag);
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3783,32 +4073,32 @@ std::uint8_t cpu::sbc_a_d()
 
 std::uint8_t cpu::sbc_a_e()
 {
-    bool carry_flag = f & (1 << 4);
-    f = f | (1 << 6);
-    if ((a & 0xf) < ((e & 0xf) + carry_flag))
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < ((state.e & 0xf) + carry_flag))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < (e + carry_flag))
+    if (state.a < (state.e + carry_flag))
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= (e + carry_flag);
-    if (a == 0)
+    state.a -= (state.e + carry_flag);
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3816,32 +4106,32 @@ std::uint8_t cpu::sbc_a_e()
 
 std::uint8_t cpu::sbc_a_h()
 {
-    bool carry_flag = f & (1 << 4);
-    f = f | (1 << 6);
-    if ((a & 0xf) < ((h & 0xf) + carry_flag))
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < ((state.h & 0xf) + carry_flag))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < (h + carry_flag))
+    if (state.a < (state.h + carry_flag))
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= (h + carry_flag);
-    if (a == 0)
+    state.a -= (state.h + carry_flag);
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3849,32 +4139,32 @@ std::uint8_t cpu::sbc_a_h()
 
 std::uint8_t cpu::sbc_a_l()
 {
-    bool carry_flag = f & (1 << 4);
-    f = f | (1 << 6);
-    if ((a & 0xf) < ((l & 0xf) + carry_flag))
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < ((state.l & 0xf) + carry_flag))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < (l + carry_flag))
+    if (state.a < (state.l + carry_flag))
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= (l + carry_flag);
-    if (a == 0)
+    state.a -= (state.l + carry_flag);
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3882,34 +4172,34 @@ std::uint8_t cpu::sbc_a_l()
 
 std::uint8_t cpu::sbc_a_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
-    bool carry_flag = f & (1 << 4);
-    f = f | (1 << 6);
-    if ((a & 0xf) < ((memory & 0xf) + carry_flag))
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < ((memory & 0xf) + carry_flag))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < (memory + carry_flag))
+    if (state.a < (memory + carry_flag))
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= (memory + carry_flag);
-    if (a == 0)
+    state.a -= (memory + carry_flag);
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -3917,32 +4207,32 @@ std::uint8_t cpu::sbc_a_addr_hl()
 
 std::uint8_t cpu::sbc_a_a()
 {
-    bool carry_flag = f & (1 << 4);
-    f = f | (1 << 6);
-    if ((a & 0xf) < ((a & 0xf) + carry_flag))
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < ((state.a & 0xf) + carry_flag))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < (a + carry_flag))
+    if (state.a < (state.a + carry_flag))
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= (a + carry_flag);
-    if (a == 0)
+    state.a -= (state.a + carry_flag);
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -3950,468 +4240,468 @@ std::uint8_t cpu::sbc_a_a()
 
 std::uint8_t cpu::and_b()
 {
-    a = a & b;
-    if (a == 0)
+    state.a = state.a & state.b;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::and_c()
 {
-    a = a & c;
-    if (a == 0)
+    state.a = state.a & state.c;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::and_d()
 {
-    a = a & d;
-    if (a == 0)
+    state.a = state.a & state.d;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::and_e()
 {
-    a = a & e;
-    if (a == 0)
+    state.a = state.a & state.e;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::and_h()
 {
-    a = a & h;
-    if (a == 0)
+    state.a = state.a & state.h;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::and_l()
 {
-    a = a & l;
-    if (a == 0)
+    state.a = state.a & state.l;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::and_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
-    a = a & memory;
-    if (a == 0)
+    state.a = state.a & memory;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::and_a()
 {
-    a = a & a;
-    if (a == 0)
+    state.a = state.a & state.a;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::xor_b()
 {
-    a = a ^ b;
-    if (a == 0)
+    state.a = state.a ^ state.b;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::xor_c()
 {
-    a = a ^ c;
-    if (a == 0)
+    state.a = state.a ^ state.c;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::xor_d()
 {
-    a = a ^ d;
-    if (a == 0)
+    state.a = state.a ^ state.d;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::xor_e()
 {
-    a = a ^ e;
-    if (a == 0)
+    state.a = state.a ^ state.e;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::xor_h()
 {
-    a = a ^ h;
-    if (a == 0)
+    state.a = state.a ^ state.h;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::xor_l()
 {
-    a = a ^ l;
-    if (a == 0)
+    state.a = state.a ^ state.l;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::xor_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
-    a = a ^ memory;
-    if (a == 0)
+    state.a = state.a ^ memory;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::xor_a()
 {
-    a = a ^ a;
-    if (a == 0)
+    state.a = state.a ^ state.a;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::or_b()
 {
-    a = a | b;
-    if (a == 0)
+    state.a = state.a | state.b;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::or_c()
 {
-    a = a | c;
-    if (a == 0)
+    state.a = state.a | state.c;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::or_d()
 {
-    a = a | d;
-    if (a == 0)
+    state.a = state.a | state.d;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::or_e()
 {
-    a = a | e;
-    if (a == 0)
+    state.a = state.a | state.e;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::or_h()
 {
-    a = a | h;
-    if (a == 0)
+    state.a = state.a | state.h;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::or_l()
 {
-    a = a | l;
-    if (a == 0)
+    state.a = state.a | state.l;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::or_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
-    a = a | memory;
-    if (a == 0)
+    state.a = state.a | memory;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::or_a()
 {
-    a = a | a;
-    if (a == 0)
+    state.a = state.a | state.a;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::cp_b()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (b & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (state.b & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < b)
+    if (state.a < state.b)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    if (a - b == 0)
+    if (state.a - state.b == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -4419,30 +4709,30 @@ std::uint8_t cpu::cp_b()
 
 std::uint8_t cpu::cp_c()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (c & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (state.c & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < c)
+    if (state.a < state.c)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    if (a - c == 0)
+    if (state.a - state.c == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -4450,30 +4740,30 @@ std::uint8_t cpu::cp_c()
 
 std::uint8_t cpu::cp_d()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (d & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (state.d & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < d)
+    if (state.a < state.d)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    if (a - d == 0)
+    if (state.a - state.d == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -4481,30 +4771,30 @@ std::uint8_t cpu::cp_d()
 
 std::uint8_t cpu::cp_e()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (e & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (state.e & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < e)
+    if (state.a < state.e)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    if (a - e == 0)
+    if (state.a - state.e == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -4512,30 +4802,30 @@ std::uint8_t cpu::cp_e()
 
 std::uint8_t cpu::cp_h()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (h & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (state.h & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < h)
+    if (state.a < state.h)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    if (a - h == 0)
+    if (state.a - state.h == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -4543,30 +4833,30 @@ std::uint8_t cpu::cp_h()
 
 std::uint8_t cpu::cp_l()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (l & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (state.l & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < l)
+    if (state.a < state.l)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    if (a - l == 0)
+    if (state.a - state.l == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -4574,32 +4864,32 @@ std::uint8_t cpu::cp_l()
 
 std::uint8_t cpu::cp_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
-    f = f | (1 << 6);
-    if ((a & 0xf) < (memory & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (memory & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < memory)
+    if (state.a < memory)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    if (a - memory == 0)
+    if (state.a - memory == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -4607,30 +4897,30 @@ std::uint8_t cpu::cp_addr_hl()
 
 std::uint8_t cpu::cp_a()
 {
-    f = f | (1 << 6);
-    if ((a & 0xf) < (a & 0xf))
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (state.a & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < a)
+    if (state.a < state.a)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    if (a - a == 0)
+    if (state.a - state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 4;
@@ -4638,33 +4928,33 @@ std::uint8_t cpu::cp_a()
 
 std::uint8_t cpu::add_a_d8()
 {
-    std::uint8_t d8 = read(pc);
-    ++pc;
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (d8 & 0xf)) > 0xf)
+    std::uint8_t d8 = read(state.pc);
+    ++state.pc;
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (d8 & 0xf)) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + d8) > 0xff)
+    if ((state.a + d8) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += d8;
-    if (a == 0)
+    state.a += d8;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -4672,34 +4962,34 @@ std::uint8_t cpu::add_a_d8()
 
 std::uint8_t cpu::adc_a_d8()
 {
-    std::uint8_t d8 = read(pc);
-    ++pc;
-    bool carry_flag = f & (1 << 4);
-    f = f & ~(1 << 6);
-    if (((a & 0xf) + (d8 & 0xf) + carry_flag) > 0xf)
+    std::uint8_t d8 = read(state.pc);
+    ++state.pc;
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f & ~(1 << 6);
+    if (((state.a & 0xf) + (d8 & 0xf) + carry_flag) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((a + d8 + carry_flag) > 0xff)
+    if ((state.a + d8 + carry_flag) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a += d8 + carry_flag;
-    if (a == 0)
+    state.a += d8 + carry_flag;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -4707,33 +4997,33 @@ std::uint8_t cpu::adc_a_d8()
 
 std::uint8_t cpu::sub_d8()
 {
-    std::uint8_t d8 = read(pc);
-    ++pc;
-    f = f | (1 << 6);
-    if ((a & 0xf) < (d8 & 0xf))
+    std::uint8_t d8 = read(state.pc);
+    ++state.pc;
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (d8 & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < d8)
+    if (state.a < d8)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= d8;
-    if (a == 0)
+    state.a -= d8;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -4741,34 +5031,34 @@ std::uint8_t cpu::sub_d8()
 
 std::uint8_t cpu::sbc_a_d8()
 {
-    std::uint8_t d8 = read(pc);
-    ++pc;
-    bool carry_flag = f & (1 << 4);
-    f = f | (1 << 6);
-    if ((a & 0xf) < ((d8 & 0xf) + carry_flag))
+    std::uint8_t d8 = read(state.pc);
+    ++state.pc;
+    bool carry_flag = state.f & (1 << 4);
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < ((d8 & 0xf) + carry_flag))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < (d8 + carry_flag))
+    if (state.a < (d8 + carry_flag))
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a -= (d8 + carry_flag);
-    if (a == 0)
+    state.a -= (d8 + carry_flag);
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -4776,92 +5066,92 @@ std::uint8_t cpu::sbc_a_d8()
 
 std::uint8_t cpu::and_d8()
 {
-    std::uint8_t d8 = read(pc);
-    ++pc;
-    a = a & d8;
-    if (a == 0)
+    std::uint8_t d8 = read(state.pc);
+    ++state.pc;
+    state.a = state.a & d8;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::xor_d8()
 {
-    std::uint8_t d8 = read(pc);
-    ++pc;
-    a = a ^ d8;
-    if (a == 0)
+    std::uint8_t d8 = read(state.pc);
+    ++state.pc;
+    state.a = state.a ^ d8;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::or_d8()
 {
-    std::uint8_t d8 = read(pc);
-    ++pc;
-    a = a | d8;
-    if (a == 0)
+    std::uint8_t d8 = read(state.pc);
+    ++state.pc;
+    state.a = state.a | d8;
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::cp_d8()
 {
-    std::uint8_t d8 = read(pc);
-    ++pc;
-    f = f | (1 << 6);
-    if ((a & 0xf) < (d8 & 0xf))
+    std::uint8_t d8 = read(state.pc);
+    ++state.pc;
+    state.f = state.f | (1 << 6);
+    if ((state.a & 0xf) < (d8 & 0xf))
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (a < d8)
+    if (state.a < d8)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    if (a - d8 == 0)
+    if (state.a - d8 == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -4869,435 +5159,435 @@ std::uint8_t cpu::cp_d8()
 
 std::uint8_t cpu::daa()
 {
-    bool half_carry_flag = f & (1 << 5);
-    bool carry_flag = f & (1 << 4);
-    bool subtraction = f & (1 << 6);
+    bool half_carry_flag = state.f & (1 << 5);
+    bool carry_flag = state.f & (1 << 4);
+    bool subtraction = state.f & (1 << 6);
     if (!subtraction)
     {
-        if (a > 0x99 || carry_flag)
+        if (state.a > 0x99 || carry_flag)
         {
-            a += 0x60;
-            f = f | (1 << 4);
+            state.a += 0x60;
+            state.f = state.f | (1 << 4);
         }
-        if ((a & 0xf) > 0x09 || half_carry_flag)
+        if ((state.a & 0xf) > 0x09 || half_carry_flag)
         {
-            a += 0x06;
+            state.a += 0x06;
         }
     }
     else
     {
         if (carry_flag)
         {
-            a -= 0x60;
+            state.a -= 0x60;
         }
         if (half_carry_flag)
         {
-            a -= 0x06;
+            state.a -= 0x06;
         }
     }
-    if (a == 0)
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 5);
+    state.f = state.f & ~(1 << 5);
 
     return 4;
 }
 
 std::uint8_t cpu::cpl()
 {
-    a = ~a;
-    f = f | (1 << 6);
-    f = f | (1 << 5);
+    state.a = ~state.a;
+    state.f = state.f | (1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 4;
 }
 
 std::uint8_t cpu::scf()
 {
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f | (1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f | (1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::ccf()
 {
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f ^ (1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f ^ (1 << 4);
 
     return 4;
 }
 
 std::uint8_t cpu::inc_bc()
 {
-    std::uint16_t bc = (b << 8) | c;
-    b = ++bc >> 8;
-    c = bc;
+    std::uint16_t bc = (state.b << 8) | state.c;
+    state.b = ++bc >> 8;
+    state.c = bc;
 
     return 8;
 }
 
 std::uint8_t cpu::inc_de()
 {
-    std::uint16_t de = (d << 8) | e;
-    d = ++de >> 8;
-    e = de;
+    std::uint16_t de = (state.d << 8) | state.e;
+    state.d = ++de >> 8;
+    state.e = de;
 
     return 8;
 }
 
 std::uint8_t cpu::inc_hl()
 {
-    std::uint16_t hl = (h << 8) | l;
-    h = ++hl >> 8;
-    l = hl;
+    std::uint16_t hl = (state.h << 8) | state.l;
+    state.h = ++hl >> 8;
+    state.l = hl;
 
     return 8;
 }
 
 std::uint8_t cpu::inc_sp()
 {
-    ++sp;
+    ++state.sp;
 
     return 8;
 }
 
 std::uint8_t cpu::dec_bc()
 {
-    std::uint16_t bc = (b << 8) | c;
-    b = --bc >> 8;
-    c = bc;
+    std::uint16_t bc = (state.b << 8) | state.c;
+    state.b = --bc >> 8;
+    state.c = bc;
 
     return 8;
 }
 
 std::uint8_t cpu::dec_de()
 {
-    std::uint16_t de = (d << 8) | e;
-    d = --de >> 8;
-    e = de;
+    std::uint16_t de = (state.d << 8) | state.e;
+    state.d = --de >> 8;
+    state.e = de;
 
     return 8;
 }
 
 std::uint8_t cpu::dec_hl()
 {
-    std::uint16_t hl = (h << 8) | l;
-    h = --hl >> 8;
-    l = hl;
+    std::uint16_t hl = (state.h << 8) | state.l;
+    state.h = --hl >> 8;
+    state.l = hl;
 
     return 8;
 }
 
 std::uint8_t cpu::dec_sp()
 {
-    --sp;
+    --state.sp;
 
     return 8;
 }
 
 std::uint8_t cpu::add_hl_bc()
 {
-    std::uint16_t hl = (h << 8) | l;
-    std::uint16_t bc = (b << 8) | c;
-    f = f & ~(1 << 6);
+    std::uint16_t hl = (state.h << 8) | state.l;
+    std::uint16_t bc = (state.b << 8) | state.c;
+    state.f = state.f & ~(1 << 6);
     if (((hl & 0xfff) + (bc & 0xfff)) > 0xfff)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
     if ((hl + bc) > 0xffff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     hl += bc;
-    h = (hl >> 8);
-    l = hl;
+    state.h = (hl >> 8);
+    state.l = hl;
 
     return 8;
 }
 
 std::uint8_t cpu::add_hl_de()
 {
-    std::uint16_t hl = (h << 8) | l;
-    std::uint16_t de = (d << 8) | e;
-    f = f & ~(1 << 6);
+    std::uint16_t hl = (state.h << 8) | state.l;
+    std::uint16_t de = (state.d << 8) | state.e;
+    state.f = state.f & ~(1 << 6);
     if (((hl & 0xfff) + (de & 0xfff)) > 0xfff)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
     if ((hl + de) > 0xffff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     hl += de;
-    h = (hl >> 8);
-    l = hl;
+    state.h = (hl >> 8);
+    state.l = hl;
 
     return 8;
 }
 
 std::uint8_t cpu::add_hl_hl()
 {
-    std::uint16_t hl = (h << 8) | l;
-    f = f & ~(1 << 6);
+    std::uint16_t hl = (state.h << 8) | state.l;
+    state.f = state.f & ~(1 << 6);
     if (((hl & 0xfff) + (hl & 0xfff)) > 0xfff)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
     if ((hl + hl) > 0xffff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     hl += hl;
-    h = (hl >> 8);
-    l = hl;
+    state.h = (hl >> 8);
+    state.l = hl;
 
     return 8;
 }
 
 std::uint8_t cpu::add_hl_sp()
 {
-    std::uint16_t hl = (h << 8) | l;
-    f = f & ~(1 << 6);
-    if (((hl & 0xfff) + (sp & 0xfff)) > 0xfff)
+    std::uint16_t hl = (state.h << 8) | state.l;
+    state.f = state.f & ~(1 << 6);
+    if (((hl & 0xfff) + (state.sp & 0xfff)) > 0xfff)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if ((hl + sp) > 0xffff)
+    if ((hl + state.sp) > 0xffff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    hl += sp;
-    h = (hl >> 8);
-    l = hl;
+    hl += state.sp;
+    state.h = (hl >> 8);
+    state.l = hl;
 
     return 8;
 }
 
 std::uint8_t cpu::add_sp_r8()
 {
-    std::uint8_t r8 = read(pc);
-    ++pc;
-    f = f & ~(1 << 7);
-    f = f & ~(1 << 6);
-    if (((sp & 0xf) + (r8 & 0xf)) > 0xf)
+    std::uint8_t r8 = read(state.pc);
+    ++state.pc;
+    state.f = state.f & ~(1 << 7);
+    state.f = state.f & ~(1 << 6);
+    if (((state.sp & 0xf) + (r8 & 0xf)) > 0xf)
     {
-        f = f | (1 << 5);
+        state.f = state.f | (1 << 5);
     }
     else
     {
-        f = f & ~(1 << 5);
+        state.f = state.f & ~(1 << 5);
     }
-    if (((sp & 0xff) + r8) > 0xff)
+    if (((state.sp & 0xff) + r8) > 0xff)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
 
-    sp = sp + (std::int8_t)r8;
+    state.sp = state.sp + (std::int8_t)r8;
 
     return 16;
 }
 
 std::uint8_t cpu::jr_r8()
 {
-    std::int8_t r8 = read(pc);
-    ++pc;
-    pc += r8;
+    std::int8_t r8 = read(state.pc);
+    ++state.pc;
+    state.pc += r8;
 
     return 12;
 }
 
 std::uint8_t cpu::jr_z_r8()
 {
-    bool zero_flag = f & (1 << 7);
+    bool zero_flag = state.f & (1 << 7);
     if (zero_flag)
     {
-        std::int8_t r8 = read(pc);
-        ++pc;
-        pc += r8;
+        std::int8_t r8 = read(state.pc);
+        ++state.pc;
+        state.pc += r8;
         return 12;
     }
-    ++pc;
+    ++state.pc;
 
     return 8;
 }
 
 std::uint8_t cpu::jr_nz_r8()
 {
-    bool zero_flag = f & (1 << 7);
+    bool zero_flag = state.f & (1 << 7);
     if (!zero_flag)
     {
-        std::int8_t r8 = read(pc);
-        ++pc;
-        pc += r8;
+        std::int8_t r8 = read(state.pc);
+        ++state.pc;
+        state.pc += r8;
         return 12;
     }
-    ++pc;
+    ++state.pc;
 
     return 8;
 }
 
 std::uint8_t cpu::jr_c_r8()
 {
-    bool carry_flag = f & (1 << 4);
+    bool carry_flag = state.f & (1 << 4);
     if (carry_flag)
     {
-        std::int8_t r8 = read(pc);
-        ++pc;
-        pc += r8;
+        std::int8_t r8 = read(state.pc);
+        ++state.pc;
+        state.pc += r8;
         return 12;
     }
-    ++pc;
+    ++state.pc;
 
     return 8;
 }
 
 std::uint8_t cpu::jr_nc_r8()
 {
-    bool carry_flag = f & (1 << 4);
+    bool carry_flag = state.f & (1 << 4);
     if (!carry_flag)
     {
-        std::int8_t r8 = read(pc);
-        ++pc;
-        pc += r8;
+        std::int8_t r8 = read(state.pc);
+        ++state.pc;
+        state.pc += r8;
         return 12;
     }
-    ++pc;
+    ++state.pc;
 
     return 8;
 }
 
 std::uint8_t cpu::jp_a16()
 {
-    std::uint16_t a16 = read(pc) | (read(++pc) << 8);
-    ++pc;
-    pc = a16;
+    std::uint16_t a16 = read(state.pc) | (read(++state.pc) << 8);
+    ++state.pc;
+    state.pc = a16;
 
     return 16;
 }
 
 std::uint8_t cpu::jp_z_a16()
 {
-    bool zero_flag = f & (1 << 7);
+    bool zero_flag = state.f & (1 << 7);
     if (zero_flag)
     {
-        std::uint16_t a16 = read(pc) | (read(++pc) << 8);
-        ++pc;
-        pc = a16;
+        std::uint16_t a16 = read(state.pc) | (read(++state.pc) << 8);
+        ++state.pc;
+        state.pc = a16;
         return 16;
     }
-    ++pc;
-    ++pc;
+    ++state.pc;
+    ++state.pc;
 
     return 12;
 }
 
 std::uint8_t cpu::jp_nz_a16()
 {
-    bool zero_flag = f & (1 << 7);
+    bool zero_flag = state.f & (1 << 7);
     if (!zero_flag)
     {
-        std::uint16_t a16 = read(pc) | (read(++pc) << 8);
-        ++pc;
-        pc = a16;
+        std::uint16_t a16 = read(state.pc) | (read(++state.pc) << 8);
+        ++state.pc;
+        state.pc = a16;
         return 16;
     }
-    ++pc;
-    ++pc;
+    ++state.pc;
+    ++state.pc;
 
     return 12;
 }
 
 std::uint8_t cpu::jp_c_a16()
 {
-    bool carry_flag = f & (1 << 4);
+    bool carry_flag = state.f & (1 << 4);
     if (carry_flag)
     {
-        std::uint16_t a16 = read(pc) | (read(++pc) << 8);
-        ++pc;
-        pc = a16;
+        std::uint16_t a16 = read(state.pc) | (read(++state.pc) << 8);
+        ++state.pc;
+        state.pc = a16;
         return 16;
     }
-    ++pc;
-    ++pc;
+    ++state.pc;
+    ++state.pc;
 
     return 12;
 }
 
 std::uint8_t cpu::jp_nc_a16()
 {
-    bool carry_flag = f & (1 << 4);
+    bool carry_flag = state.f & (1 << 4);
     if (!carry_flag)
     {
-        std::uint16_t a16 = read(pc) | (read(++pc) << 8);
-        ++pc;
-        pc = a16;
+        std::uint16_t a16 = read(state.pc) | (read(++state.pc) << 8);
+        ++state.pc;
+        state.pc = a16;
         return 16;
     }
-    ++pc;
-    ++pc;
+    ++state.pc;
+    ++state.pc;
 
     return 12;
 }
 
 std::uint8_t cpu::ret()
 {
-    pc = read(sp) | (read(++sp) << 8);
-    ++sp;
+    state.pc = read(state.sp) | (read(++state.sp) << 8);
+    ++state.sp;
 
     return 16;
 }
 
 std::uint8_t cpu::ret_z()
 {
-    bool zero_flag = f & (1 << 7);
+    bool zero_flag = state.f & (1 << 7);
     if (zero_flag)
     {
-        pc = read(sp) | (read(++sp) << 8);
-        ++sp;
+        state.pc = read(state.sp) | (read(++state.sp) << 8);
+        ++state.sp;
         return 20;
     }
 
@@ -5306,11 +5596,11 @@ std::uint8_t cpu::ret_z()
 
 std::uint8_t cpu::ret_nz()
 {
-    bool zero_flag = f & (1 << 7);
+    bool zero_flag = state.f & (1 << 7);
     if (!zero_flag)
     {
-        pc = read(sp) | (read(++sp) << 8);
-        ++sp;
+        state.pc = read(state.sp) | (read(++state.sp) << 8);
+        ++state.sp;
         return 20;
     }
 
@@ -5319,11 +5609,11 @@ std::uint8_t cpu::ret_nz()
 
 std::uint8_t cpu::ret_c()
 {
-    bool carry_flag = f & (1 << 4);
+    bool carry_flag = state.f & (1 << 4);
     if (carry_flag)
     {
-        pc = read(sp) | (read(++sp) << 8);
-        ++sp;
+        state.pc = read(state.sp) | (read(++state.sp) << 8);
+        ++state.sp;
         return 20;
     }
 
@@ -5332,11 +5622,11 @@ std::uint8_t cpu::ret_c()
 
 std::uint8_t cpu::ret_nc()
 {
-    bool carry_flag = f & (1 << 4);
+    bool carry_flag = state.f & (1 << 4);
     if (!carry_flag)
     {
-        pc = read(sp) | (read(++sp) << 8);
-        ++sp;
+        state.pc = read(state.sp) | (read(++state.sp) << 8);
+        ++state.sp;
         return 20;
     }
 
@@ -5345,252 +5635,252 @@ std::uint8_t cpu::ret_nc()
 
 std::uint8_t cpu::reti()
 {
-    pc = read(sp) | (read(++sp) << 8);
-    ++sp;
-    ime_flag = true;
+    state.pc = read(state.sp) | (read(++state.sp) << 8);
+    ++state.sp;
+    state.ime_flag = true;
 
     return 16;
 }
 
 std::uint8_t cpu::jp_hl()
 {
-    std::uint16_t hl = (h << 8) | l;
-    pc = hl;
+    std::uint16_t hl = (state.h << 8) | state.l;
+    state.pc = hl;
 
     return 4;
 }
 
 std::uint8_t cpu::call_a16()
 {
-    std::uint16_t a16 = read(pc) | (read(++pc) << 8);
-    ++pc;
-    std::uint8_t high = pc >> 8;
-    std::uint8_t low = pc;
-    --sp;
-    write(sp, high);
-    --sp;
-    write(sp, low);
-    pc = a16;
+    std::uint16_t a16 = read(state.pc) | (read(++state.pc) << 8);
+    ++state.pc;
+    std::uint8_t high = state.pc >> 8;
+    std::uint8_t low = state.pc;
+    --state.sp;
+    write(state.sp, high);
+    --state.sp;
+    write(state.sp, low);
+    state.pc = a16;
 
     return 24;
 }
 
 std::uint8_t cpu::call_z_a16()
 {
-    bool zero_flag = f & (1 << 7);
+    bool zero_flag = state.f & (1 << 7);
     if (zero_flag)
     {
-        std::uint16_t a16 = read(pc) | (read(++pc) << 8);
-        ++pc;
-        std::uint8_t high = pc >> 8;
-        std::uint8_t low = pc;
-        --sp;
-        write(sp, high);
-        --sp;
-        write(sp, low);
-        pc = a16;
+        std::uint16_t a16 = read(state.pc) | (read(++state.pc) << 8);
+        ++state.pc;
+        std::uint8_t high = state.pc >> 8;
+        std::uint8_t low = state.pc;
+        --state.sp;
+        write(state.sp, high);
+        --state.sp;
+        write(state.sp, low);
+        state.pc = a16;
         return 24;
     }
-    ++pc;
-    ++pc;
+    ++state.pc;
+    ++state.pc;
 
     return 12;
 }
 
 std::uint8_t cpu::call_nz_a16()
 {
-    bool zero_flag = f & (1 << 7);
+    bool zero_flag = state.f & (1 << 7);
     if (!zero_flag)
     {
-        std::uint16_t a16 = read(pc) | (read(++pc) << 8);
-        ++pc;
-        std::uint8_t high = pc >> 8;
-        std::uint8_t low = pc;
-        --sp;
-        write(sp, high);
-        --sp;
-        write(sp, low);
-        pc = a16;
+        std::uint16_t a16 = read(state.pc) | (read(++state.pc) << 8);
+        ++state.pc;
+        std::uint8_t high = state.pc >> 8;
+        std::uint8_t low = state.pc;
+        --state.sp;
+        write(state.sp, high);
+        --state.sp;
+        write(state.sp, low);
+        state.pc = a16;
         return 24;
     }
-    ++pc;
-    ++pc;
+    ++state.pc;
+    ++state.pc;
 
     return 12;
 }
 
 std::uint8_t cpu::call_c_a16()
 {
-    bool carry_flag = f & (1 << 4);
+    bool carry_flag = state.f & (1 << 4);
     if (carry_flag)
     {
-        std::uint16_t a16 = read(pc) | (read(++pc) << 8);
-        ++pc;
-        std::uint8_t high = pc >> 8;
-        std::uint8_t low = pc;
-        --sp;
-        write(sp, high);
-        --sp;
-        write(sp, low);
-        pc = a16;
+        std::uint16_t a16 = read(state.pc) | (read(++state.pc) << 8);
+        ++state.pc;
+        std::uint8_t high = state.pc >> 8;
+        std::uint8_t low = state.pc;
+        --state.sp;
+        write(state.sp, high);
+        --state.sp;
+        write(state.sp, low);
+        state.pc = a16;
         return 24;
     }
-    ++pc;
-    ++pc;
+    ++state.pc;
+    ++state.pc;
 
     return 12;
 }
 
 std::uint8_t cpu::call_nc_a16()
 {
-    bool carry_flag = f & (1 << 4);
+    bool carry_flag = state.f & (1 << 4);
     if (!carry_flag)
     {
-        std::uint16_t a16 = read(pc) | (read(++pc) << 8);
-        ++pc;
-        std::uint8_t high = pc >> 8;
-        std::uint8_t low = pc;
-        --sp;
-        write(sp, high);
-        --sp;
-        write(sp, low);
-        pc = a16;
+        std::uint16_t a16 = read(state.pc) | (read(++state.pc) << 8);
+        ++state.pc;
+        std::uint8_t high = state.pc >> 8;
+        std::uint8_t low = state.pc;
+        --state.sp;
+        write(state.sp, high);
+        --state.sp;
+        write(state.sp, low);
+        state.pc = a16;
         return 24;
     }
-    ++pc;
-    ++pc;
+    ++state.pc;
+    ++state.pc;
 
     return 12;
 }
 
 std::uint8_t cpu::rst_00h()
 {
-    std::uint8_t high = pc >> 8;
-    std::uint8_t low = pc;
-    --sp;
-    write(sp, high);
-    --sp;
-    write(sp, low);
+    std::uint8_t high = state.pc >> 8;
+    std::uint8_t low = state.pc;
+    --state.sp;
+    write(state.sp, high);
+    --state.sp;
+    write(state.sp, low);
     std::uint16_t address = 0x0000 + 0x00;
-    pc = address;
+    state.pc = address;
 
     return 16;
 }
 
 std::uint8_t cpu::rst_08h()
 {
-    std::uint8_t high = pc >> 8;
-    std::uint8_t low = pc;
-    --sp;
-    write(sp, high);
-    --sp;
-    write(sp, low);
+    std::uint8_t high = state.pc >> 8;
+    std::uint8_t low = state.pc;
+    --state.sp;
+    write(state.sp, high);
+    --state.sp;
+    write(state.sp, low);
     std::uint16_t address = 0x0000 + 0x08;
-    pc = address;
+    state.pc = address;
 
     return 16;
 }
 
 std::uint8_t cpu::rst_10h()
 {
-    std::uint8_t high = pc >> 8;
-    std::uint8_t low = pc;
-    --sp;
-    write(sp, high);
-    --sp;
-    write(sp, low);
+    std::uint8_t high = state.pc >> 8;
+    std::uint8_t low = state.pc;
+    --state.sp;
+    write(state.sp, high);
+    --state.sp;
+    write(state.sp, low);
     std::uint16_t address = 0x0000 + 0x10;
-    pc = address;
+    state.pc = address;
 
     return 16;
 }
 
 std::uint8_t cpu::rst_18h()
 {
-    std::uint8_t high = pc >> 8;
-    std::uint8_t low = pc;
-    --sp;
-    write(sp, high);
-    --sp;
-    write(sp, low);
+    std::uint8_t high = state.pc >> 8;
+    std::uint8_t low = state.pc;
+    --state.sp;
+    write(state.sp, high);
+    --state.sp;
+    write(state.sp, low);
     std::uint16_t address = 0x0000 + 0x18;
-    pc = address;
+    state.pc = address;
 
     return 16;
 }
 
 std::uint8_t cpu::rst_20h()
 {
-    std::uint8_t high = pc >> 8;
-    std::uint8_t low = pc;
-    --sp;
-    write(sp, high);
-    --sp;
-    write(sp, low);
+    std::uint8_t high = state.pc >> 8;
+    std::uint8_t low = state.pc;
+    --state.sp;
+    write(state.sp, high);
+    --state.sp;
+    write(state.sp, low);
     std::uint16_t address = 0x0000 + 0x20;
-    pc = address;
+    state.pc = address;
 
     return 16;
 }
 
 std::uint8_t cpu::rst_28h()
 {
-    std::uint8_t high = pc >> 8;
-    std::uint8_t low = pc;
-    --sp;
-    write(sp, high);
-    --sp;
-    write(sp, low);
+    std::uint8_t high = state.pc >> 8;
+    std::uint8_t low = state.pc;
+    --state.sp;
+    write(state.sp, high);
+    --state.sp;
+    write(state.sp, low);
     std::uint16_t address = 0x0000 + 0x28;
-    pc = address;
+    state.pc = address;
 
     return 16;
 }
 
 std::uint8_t cpu::rst_30h()
 {
-    std::uint8_t high = pc >> 8;
-    std::uint8_t low = pc;
-    --sp;
-    write(sp, high);
-    --sp;
-    write(sp, low);
+    std::uint8_t high = state.pc >> 8;
+    std::uint8_t low = state.pc;
+    --state.sp;
+    write(state.sp, high);
+    --state.sp;
+    write(state.sp, low);
     std::uint16_t address = 0x0000 + 0x30;
-    pc = address;
+    state.pc = address;
 
     return 16;
 }
 
 std::uint8_t cpu::rst_38h()
 {
-    std::uint8_t high = pc >> 8;
-    std::uint8_t low = pc;
-    --sp;
-    write(sp, high);
-    --sp;
-    write(sp, low);
+    std::uint8_t high = state.pc >> 8;
+    std::uint8_t low = state.pc;
+    --state.sp;
+    write(state.sp, high);
+    --state.sp;
+    write(state.sp, low);
     std::uint16_t address = 0x0000 + 0x38;
-    pc = address;
+    state.pc = address;
 
     return 16;
 }
 
 std::uint8_t cpu::rlca()
 {
-    bool bit_7_set = a & (1 << 7);
-    a = a << 1;
-    f = f & ~(1 << 7);
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.a & (1 << 7);
+    state.a = state.a << 1;
+    state.f = state.f & ~(1 << 7);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
-        a = a | (1 << 0);
+        state.f = state.f | (1 << 4);
+        state.a = state.a | (1 << 0);
     }
     else
     {
-        f = f & ~(1 << 4);
-        a = a & ~(1 << 0);
+        state.f = state.f & ~(1 << 4);
+        state.a = state.a & ~(1 << 0);
     }
 
     return 4;
@@ -5598,27 +5888,27 @@ std::uint8_t cpu::rlca()
 
 std::uint8_t cpu::rla()
 {
-    bool bit_7_set = a & (1 << 7);
-    bool carry_flag = f & (1 << 4);
-    a = a << 1;
-    f = f & ~(1 << 7);
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.a & (1 << 7);
+    bool carry_flag = state.f & (1 << 4);
+    state.a = state.a << 1;
+    state.f = state.f & ~(1 << 7);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        a = a | (1 << 0);
+        state.a = state.a | (1 << 0);
     }
     else
     {
-        a = a & ~(1 << 0);
+        state.a = state.a & ~(1 << 0);
     }
 
     return 4;
@@ -5626,20 +5916,20 @@ std::uint8_t cpu::rla()
 
 std::uint8_t cpu::rrca()
 {
-    bool bit_0_set = a & (1 << 0);
-    a = a >> 1;
-    f = f & ~(1 << 7);
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.a & (1 << 0);
+    state.a = state.a >> 1;
+    state.f = state.f & ~(1 << 7);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
-        a = a | (1 << 7);
+        state.f = state.f | (1 << 4);
+        state.a = state.a | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 4);
-        a = a & ~(1 << 7);
+        state.f = state.f & ~(1 << 4);
+        state.a = state.a & ~(1 << 7);
     }
 
     return 4;
@@ -5647,27 +5937,27 @@ std::uint8_t cpu::rrca()
 
 std::uint8_t cpu::rra()
 {
-    bool bit_0_set = a & (1 << 0);
-    bool carry_flag = f & (1 << 4);
-    a = a >> 1;
-    f = f & ~(1 << 7);
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.a & (1 << 0);
+    bool carry_flag = state.f & (1 << 4);
+    state.a = state.a >> 1;
+    state.f = state.f & ~(1 << 7);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        a = a | (1 << 7);
+        state.a = state.a | (1 << 7);
     }
     else
     {
-        a = a & ~(1 << 7);
+        state.a = state.a & ~(1 << 7);
     }
 
     return 4;
@@ -5675,26 +5965,30 @@ std::uint8_t cpu::rra()
 
 std::uint8_t cpu::stop()
 {
+    if (gb_bus->switch_speed())
+    {
+        state.speed = gb_bus->is_double_speed() ? 2 : 1;
+    }
     return 4;
 }
 
 std::uint8_t cpu::halt()
 {
-    halted = true;
+    state.halted = true;
 
     return 0;
 }
 
 std::uint8_t cpu::ei()
 {
-    ime_flag = true;
+    state.ime_flag = true;
 
     return 4;
 }
 
 std::uint8_t cpu::di()
 {
-    ime_flag = false;
+    state.ime_flag = false;
 
     return 4;
 }
@@ -5706,27 +6000,27 @@ std::uint8_t cpu::nop()
 
 std::uint8_t cpu::rlc_b()
 {
-    bool bit_7_set = b & (1 << 7);
-    b = b << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.b & (1 << 7);
+    state.b = state.b << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
-        b = b | (1 << 0);
+        state.f = state.f | (1 << 4);
+        state.b = state.b | (1 << 0);
     }
     else
     {
-        f = f & ~(1 << 4);
-        b = b & ~(1 << 0);
+        state.f = state.f & ~(1 << 4);
+        state.b = state.b & ~(1 << 0);
     }
-    if (b == 0)
+    if (state.b == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -5734,27 +6028,27 @@ std::uint8_t cpu::rlc_b()
 
 std::uint8_t cpu::rlc_c()
 {
-    bool bit_7_set = c & (1 << 7);
-    c = c << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.c & (1 << 7);
+    state.c = state.c << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
-        c = c | (1 << 0);
+        state.f = state.f | (1 << 4);
+        state.c = state.c | (1 << 0);
     }
     else
     {
-        f = f & ~(1 << 4);
-        c = c & ~(1 << 0);
+        state.f = state.f & ~(1 << 4);
+        state.c = state.c & ~(1 << 0);
     }
-    if (c == 0)
+    if (state.c == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -5762,27 +6056,27 @@ std::uint8_t cpu::rlc_c()
 
 std::uint8_t cpu::rlc_d()
 {
-    bool bit_7_set = d & (1 << 7);
-    d = d << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.d & (1 << 7);
+    state.d = state.d << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
-        d = d | (1 << 0);
+        state.f = state.f | (1 << 4);
+        state.d = state.d | (1 << 0);
     }
     else
     {
-        f = f & ~(1 << 4);
-        d = d & ~(1 << 0);
+        state.f = state.f & ~(1 << 4);
+        state.d = state.d & ~(1 << 0);
     }
-    if (d == 0)
+    if (state.d == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -5790,27 +6084,27 @@ std::uint8_t cpu::rlc_d()
 
 std::uint8_t cpu::rlc_e()
 {
-    bool bit_7_set = e & (1 << 7);
-    e = e << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.e & (1 << 7);
+    state.e = state.e << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
-        e = e | (1 << 0);
+        state.f = state.f | (1 << 4);
+        state.e = state.e | (1 << 0);
     }
     else
     {
-        f = f & ~(1 << 4);
-        e = e & ~(1 << 0);
+        state.f = state.f & ~(1 << 4);
+        state.e = state.e & ~(1 << 0);
     }
-    if (e == 0)
+    if (state.e == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -5818,27 +6112,27 @@ std::uint8_t cpu::rlc_e()
 
 std::uint8_t cpu::rlc_h()
 {
-    bool bit_7_set = h & (1 << 7);
-    h = h << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.h & (1 << 7);
+    state.h = state.h << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
-        h = h | (1 << 0);
+        state.f = state.f | (1 << 4);
+        state.h = state.h | (1 << 0);
     }
     else
     {
-        f = f & ~(1 << 4);
-        h = h & ~(1 << 0);
+        state.f = state.f & ~(1 << 4);
+        state.h = state.h & ~(1 << 0);
     }
-    if (h == 0)
+    if (state.h == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -5846,27 +6140,27 @@ std::uint8_t cpu::rlc_h()
 
 std::uint8_t cpu::rlc_l()
 {
-    bool bit_7_set = l & (1 << 7);
-    l = l << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.l & (1 << 7);
+    state.l = state.l << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
-        l = l | (1 << 0);
+        state.f = state.f | (1 << 4);
+        state.l = state.l | (1 << 0);
     }
     else
     {
-        f = f & ~(1 << 4);
-        l = l & ~(1 << 0);
+        state.f = state.f & ~(1 << 4);
+        state.l = state.l & ~(1 << 0);
     }
-    if (l == 0)
+    if (state.l == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -5874,29 +6168,29 @@ std::uint8_t cpu::rlc_l()
 
 std::uint8_t cpu::rlc_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_7_set = memory & (1 << 7);
     memory = memory << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
         memory = memory | (1 << 0);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
         memory = memory & ~(1 << 0);
     }
     if (memory == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
     write(ahl, memory);
 
@@ -5905,27 +6199,27 @@ std::uint8_t cpu::rlc_addr_hl()
 
 std::uint8_t cpu::rlc_a()
 {
-    bool bit_7_set = a & (1 << 7);
-    a = a << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.a & (1 << 7);
+    state.a = state.a << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
-        a = a | (1 << 0);
+        state.f = state.f | (1 << 4);
+        state.a = state.a | (1 << 0);
     }
     else
     {
-        f = f & ~(1 << 4);
-        a = a & ~(1 << 0);
+        state.f = state.f & ~(1 << 4);
+        state.a = state.a & ~(1 << 0);
     }
-    if (a == 0)
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -5933,27 +6227,27 @@ std::uint8_t cpu::rlc_a()
 
 std::uint8_t cpu::rrc_b()
 {
-    bool bit_0_set = b & (1 << 0);
-    b = b >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.b & (1 << 0);
+    state.b = state.b >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
-        b = b | (1 << 7);
+        state.f = state.f | (1 << 4);
+        state.b = state.b | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 4);
-        b = b & ~(1 << 7);
+        state.f = state.f & ~(1 << 4);
+        state.b = state.b & ~(1 << 7);
     }
-    if (b == 0)
+    if (state.b == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -5961,27 +6255,27 @@ std::uint8_t cpu::rrc_b()
 
 std::uint8_t cpu::rrc_c()
 {
-    bool bit_0_set = c & (1 << 0);
-    c = c >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.c & (1 << 0);
+    state.c = state.c >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
-        c = c | (1 << 7);
+        state.f = state.f | (1 << 4);
+        state.c = state.c | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 4);
-        c = c & ~(1 << 7);
+        state.f = state.f & ~(1 << 4);
+        state.c = state.c & ~(1 << 7);
     }
-    if (c == 0)
+    if (state.c == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -5989,27 +6283,27 @@ std::uint8_t cpu::rrc_c()
 
 std::uint8_t cpu::rrc_d()
 {
-    bool bit_0_set = d & (1 << 0);
-    d = d >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.d & (1 << 0);
+    state.d = state.d >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
-        d = d | (1 << 7);
+        state.f = state.f | (1 << 4);
+        state.d = state.d | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 4);
-        d = d & ~(1 << 7);
+        state.f = state.f & ~(1 << 4);
+        state.d = state.d & ~(1 << 7);
     }
-    if (d == 0)
+    if (state.d == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6017,27 +6311,27 @@ std::uint8_t cpu::rrc_d()
 
 std::uint8_t cpu::rrc_e()
 {
-    bool bit_0_set = e & (1 << 0);
-    e = e >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.e & (1 << 0);
+    state.e = state.e >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
-        e = e | (1 << 7);
+        state.f = state.f | (1 << 4);
+        state.e = state.e | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 4);
-        e = e & ~(1 << 7);
+        state.f = state.f & ~(1 << 4);
+        state.e = state.e & ~(1 << 7);
     }
-    if (e == 0)
+    if (state.e == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6045,27 +6339,27 @@ std::uint8_t cpu::rrc_e()
 
 std::uint8_t cpu::rrc_h()
 {
-    bool bit_0_set = h & (1 << 0);
-    h = h >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.h & (1 << 0);
+    state.h = state.h >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
-        h = h | (1 << 7);
+        state.f = state.f | (1 << 4);
+        state.h = state.h | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 4);
-        h = h & ~(1 << 7);
+        state.f = state.f & ~(1 << 4);
+        state.h = state.h & ~(1 << 7);
     }
-    if (h == 0)
+    if (state.h == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6073,27 +6367,27 @@ std::uint8_t cpu::rrc_h()
 
 std::uint8_t cpu::rrc_l()
 {
-    bool bit_0_set = l & (1 << 0);
-    l = l >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.l & (1 << 0);
+    state.l = state.l >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
-        l = l | (1 << 7);
+        state.f = state.f | (1 << 4);
+        state.l = state.l | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 4);
-        l = l & ~(1 << 7);
+        state.f = state.f & ~(1 << 4);
+        state.l = state.l & ~(1 << 7);
     }
-    if (l == 0)
+    if (state.l == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6101,29 +6395,29 @@ std::uint8_t cpu::rrc_l()
 
 std::uint8_t cpu::rrc_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_0_set = memory & (1 << 0);
     memory = memory >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
         memory = memory | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
         memory = memory & ~(1 << 7);
     }
     if (memory == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
     write(ahl, memory);
 
@@ -6132,27 +6426,27 @@ std::uint8_t cpu::rrc_addr_hl()
 
 std::uint8_t cpu::rrc_a()
 {
-    bool bit_0_set = a & (1 << 0);
-    a = a >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.a & (1 << 0);
+    state.a = state.a >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
-        a = a | (1 << 7);
+        state.f = state.f | (1 << 4);
+        state.a = state.a | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 4);
-        a = a & ~(1 << 7);
+        state.f = state.f & ~(1 << 4);
+        state.a = state.a & ~(1 << 7);
     }
-    if (a == 0)
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6160,34 +6454,34 @@ std::uint8_t cpu::rrc_a()
 
 std::uint8_t cpu::rl_b()
 {
-    bool bit_7_set = b & (1 << 7);
-    bool carry_flag = f & (1 << 4);
-    b = b << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.b & (1 << 7);
+    bool carry_flag = state.f & (1 << 4);
+    state.b = state.b << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        b = b | (1 << 0);
+        state.b = state.b | (1 << 0);
     }
     else
     {
-        b = b & ~(1 << 0);
+        state.b = state.b & ~(1 << 0);
     }
-    if (b == 0)
+    if (state.b == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6195,34 +6489,34 @@ std::uint8_t cpu::rl_b()
 
 std::uint8_t cpu::rl_c()
 {
-    bool bit_7_set = c & (1 << 7);
-    bool carry_flag = f & (1 << 4);
-    c = c << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.c & (1 << 7);
+    bool carry_flag = state.f & (1 << 4);
+    state.c = state.c << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        c = c | (1 << 0);
+        state.c = state.c | (1 << 0);
     }
     else
     {
-        c = c & ~(1 << 0);
+        state.c = state.c & ~(1 << 0);
     }
-    if (c == 0)
+    if (state.c == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6230,34 +6524,34 @@ std::uint8_t cpu::rl_c()
 
 std::uint8_t cpu::rl_d()
 {
-    bool bit_7_set = d & (1 << 7);
-    bool carry_flag = f & (1 << 4);
-    d = d << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.d & (1 << 7);
+    bool carry_flag = state.f & (1 << 4);
+    state.d = state.d << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        d = d | (1 << 0);
+        state.d = state.d | (1 << 0);
     }
     else
     {
-        d = d & ~(1 << 0);
+        state.d = state.d & ~(1 << 0);
     }
-    if (d == 0)
+    if (state.d == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6265,34 +6559,34 @@ std::uint8_t cpu::rl_d()
 
 std::uint8_t cpu::rl_e()
 {
-    bool bit_7_set = e & (1 << 7);
-    bool carry_flag = f & (1 << 4);
-    e = e << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.e & (1 << 7);
+    bool carry_flag = state.f & (1 << 4);
+    state.e = state.e << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        e = e | (1 << 0);
+        state.e = state.e | (1 << 0);
     }
     else
     {
-        e = e & ~(1 << 0);
+        state.e = state.e & ~(1 << 0);
     }
-    if (e == 0)
+    if (state.e == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6300,34 +6594,34 @@ std::uint8_t cpu::rl_e()
 
 std::uint8_t cpu::rl_h()
 {
-    bool bit_7_set = h & (1 << 7);
-    bool carry_flag = f & (1 << 4);
-    h = h << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.h & (1 << 7);
+    bool carry_flag = state.f & (1 << 4);
+    state.h = state.h << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        h = h | (1 << 0);
+        state.h = state.h | (1 << 0);
     }
     else
     {
-        h = h & ~(1 << 0);
+        state.h = state.h & ~(1 << 0);
     }
-    if (h == 0)
+    if (state.h == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6335,34 +6629,34 @@ std::uint8_t cpu::rl_h()
 
 std::uint8_t cpu::rl_l()
 {
-    bool bit_7_set = l & (1 << 7);
-    bool carry_flag = f & (1 << 4);
-    l = l << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.l & (1 << 7);
+    bool carry_flag = state.f & (1 << 4);
+    state.l = state.l << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        l = l | (1 << 0);
+        state.l = state.l | (1 << 0);
     }
     else
     {
-        l = l & ~(1 << 0);
+        state.l = state.l & ~(1 << 0);
     }
-    if (l == 0)
+    if (state.l == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6370,20 +6664,20 @@ std::uint8_t cpu::rl_l()
 
 std::uint8_t cpu::rl_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_7_set = memory & (1 << 7);
-    bool carry_flag = f & (1 << 4);
+    bool carry_flag = state.f & (1 << 4);
     memory = memory << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
@@ -6395,11 +6689,11 @@ std::uint8_t cpu::rl_addr_hl()
     }
     if (memory == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
     write(ahl, memory);
 
@@ -6408,34 +6702,34 @@ std::uint8_t cpu::rl_addr_hl()
 
 std::uint8_t cpu::rl_a()
 {
-    bool bit_7_set = a & (1 << 7);
-    bool carry_flag = f & (1 << 4);
-    a = a << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.a & (1 << 7);
+    bool carry_flag = state.f & (1 << 4);
+    state.a = state.a << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        a = a | (1 << 0);
+        state.a = state.a | (1 << 0);
     }
     else
     {
-        a = a & ~(1 << 0);
+        state.a = state.a & ~(1 << 0);
     }
-    if (a == 0)
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6443,34 +6737,34 @@ std::uint8_t cpu::rl_a()
 
 std::uint8_t cpu::rr_b()
 {
-    bool bit_0_set = b & (1 << 0);
-    bool carry_flag = f & (1 << 4);
-    b = b >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.b & (1 << 0);
+    bool carry_flag = state.f & (1 << 4);
+    state.b = state.b >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        b = b | (1 << 7);
+        state.b = state.b | (1 << 7);
     }
     else
     {
-        b = b & ~(1 << 7);
+        state.b = state.b & ~(1 << 7);
     }
-    if (b == 0)
+    if (state.b == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6478,34 +6772,34 @@ std::uint8_t cpu::rr_b()
 
 std::uint8_t cpu::rr_c()
 {
-    bool bit_0_set = c & (1 << 0);
-    bool carry_flag = f & (1 << 4);
-    c = c >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.c & (1 << 0);
+    bool carry_flag = state.f & (1 << 4);
+    state.c = state.c >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        c = c | (1 << 7);
+        state.c = state.c | (1 << 7);
     }
     else
     {
-        c = c & ~(1 << 7);
+        state.c = state.c & ~(1 << 7);
     }
-    if (c == 0)
+    if (state.c == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6513,34 +6807,34 @@ std::uint8_t cpu::rr_c()
 
 std::uint8_t cpu::rr_d()
 {
-    bool bit_0_set = d & (1 << 0);
-    bool carry_flag = f & (1 << 4);
-    d = d >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.d & (1 << 0);
+    bool carry_flag = state.f & (1 << 4);
+    state.d = state.d >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        d = d | (1 << 7);
+        state.d = state.d | (1 << 7);
     }
     else
     {
-        d = d & ~(1 << 7);
+        state.d = state.d & ~(1 << 7);
     }
-    if (d == 0)
+    if (state.d == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6548,34 +6842,34 @@ std::uint8_t cpu::rr_d()
 
 std::uint8_t cpu::rr_e()
 {
-    bool bit_0_set = e & (1 << 0);
-    bool carry_flag = f & (1 << 4);
-    e = e >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.e & (1 << 0);
+    bool carry_flag = state.f & (1 << 4);
+    state.e = state.e >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        e = e | (1 << 7);
+        state.e = state.e | (1 << 7);
     }
     else
     {
-        e = e & ~(1 << 7);
+        state.e = state.e & ~(1 << 7);
     }
-    if (e == 0)
+    if (state.e == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6583,34 +6877,34 @@ std::uint8_t cpu::rr_e()
 
 std::uint8_t cpu::rr_h()
 {
-    bool bit_0_set = h & (1 << 0);
-    bool carry_flag = f & (1 << 4);
-    h = h >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.h & (1 << 0);
+    bool carry_flag = state.f & (1 << 4);
+    state.h = state.h >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        h = h | (1 << 7);
+        state.h = state.h | (1 << 7);
     }
     else
     {
-        h = h & ~(1 << 7);
+        state.h = state.h & ~(1 << 7);
     }
-    if (h == 0)
+    if (state.h == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6618,34 +6912,34 @@ std::uint8_t cpu::rr_h()
 
 std::uint8_t cpu::rr_l()
 {
-    bool bit_0_set = l & (1 << 0);
-    bool carry_flag = f & (1 << 4);
-    l = l >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.l & (1 << 0);
+    bool carry_flag = state.f & (1 << 4);
+    state.l = state.l >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        l = l | (1 << 7);
+        state.l = state.l | (1 << 7);
     }
     else
     {
-        l = l & ~(1 << 7);
+        state.l = state.l & ~(1 << 7);
     }
-    if (l == 0)
+    if (state.l == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6653,20 +6947,20 @@ std::uint8_t cpu::rr_l()
 
 std::uint8_t cpu::rr_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_0_set = memory & (1 << 0);
-    bool carry_flag = f & (1 << 4);
+    bool carry_flag = state.f & (1 << 4);
     memory = memory >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
@@ -6678,11 +6972,11 @@ std::uint8_t cpu::rr_addr_hl()
     }
     if (memory == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
     write(ahl, memory);
 
@@ -6691,34 +6985,34 @@ std::uint8_t cpu::rr_addr_hl()
 
 std::uint8_t cpu::rr_a()
 {
-    bool bit_0_set = a & (1 << 0);
-    bool carry_flag = f & (1 << 4);
-    a = a >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.a & (1 << 0);
+    bool carry_flag = state.f & (1 << 4);
+    state.a = state.a >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (carry_flag)
     {
-        a = a | (1 << 7);
+        state.a = state.a | (1 << 7);
     }
     else
     {
-        a = a & ~(1 << 7);
+        state.a = state.a & ~(1 << 7);
     }
-    if (a == 0)
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6726,26 +7020,26 @@ std::uint8_t cpu::rr_a()
 
 std::uint8_t cpu::sla_b()
 {
-    bool bit_7_set = b & (1 << 7);
-    b = b << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.b & (1 << 7);
+    state.b = state.b << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    b = b & ~(1 << 0);
-    if (b == 0)
+    state.b = state.b & ~(1 << 0);
+    if (state.b == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6753,26 +7047,26 @@ std::uint8_t cpu::sla_b()
 
 std::uint8_t cpu::sla_c()
 {
-    bool bit_7_set = c & (1 << 7);
-    c = c << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.c & (1 << 7);
+    state.c = state.c << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    c = c & ~(1 << 0);
-    if (c == 0)
+    state.c = state.c & ~(1 << 0);
+    if (state.c == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6780,26 +7074,26 @@ std::uint8_t cpu::sla_c()
 
 std::uint8_t cpu::sla_d()
 {
-    bool bit_7_set = d & (1 << 7);
-    d = d << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.d & (1 << 7);
+    state.d = state.d << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    d = d & ~(1 << 0);
-    if (d == 0)
+    state.d = state.d & ~(1 << 0);
+    if (state.d == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6807,26 +7101,26 @@ std::uint8_t cpu::sla_d()
 
 std::uint8_t cpu::sla_e()
 {
-    bool bit_7_set = e & (1 << 7);
-    e = e << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.e & (1 << 7);
+    state.e = state.e << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    e = e & ~(1 << 0);
-    if (e == 0)
+    state.e = state.e & ~(1 << 0);
+    if (state.e == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6834,26 +7128,26 @@ std::uint8_t cpu::sla_e()
 
 std::uint8_t cpu::sla_h()
 {
-    bool bit_7_set = h & (1 << 7);
-    h = h << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.h & (1 << 7);
+    state.h = state.h << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    h = h & ~(1 << 0);
-    if (h == 0)
+    state.h = state.h & ~(1 << 0);
+    if (state.h == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6861,26 +7155,26 @@ std::uint8_t cpu::sla_h()
 
 std::uint8_t cpu::sla_l()
 {
-    bool bit_7_set = l & (1 << 7);
-    l = l << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.l & (1 << 7);
+    state.l = state.l << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    l = l & ~(1 << 0);
-    if (l == 0)
+    state.l = state.l & ~(1 << 0);
+    if (state.l == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6888,28 +7182,28 @@ std::uint8_t cpu::sla_l()
 
 std::uint8_t cpu::sla_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_7_set = memory & (1 << 7);
     memory = memory << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     memory = memory & ~(1 << 0);
     if (memory == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
     write(ahl, memory);
 
@@ -6918,26 +7212,26 @@ std::uint8_t cpu::sla_addr_hl()
 
 std::uint8_t cpu::sla_a()
 {
-    bool bit_7_set = a & (1 << 7);
-    a = a << 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_7_set = state.a & (1 << 7);
+    state.a = state.a << 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_7_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a = a & ~(1 << 0);
-    if (a == 0)
+    state.a = state.a & ~(1 << 0);
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6945,30 +7239,30 @@ std::uint8_t cpu::sla_a()
 
 std::uint8_t cpu::sra_b()
 {
-    bool bit_0_set = b & (1 << 0);
-    bool bit_7_set = b & (1 << 7);
-    b = b >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.b & (1 << 0);
+    bool bit_7_set = state.b & (1 << 7);
+    state.b = state.b >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (bit_7_set)
     {
-        b = b | (1 << 7);
+        state.b = state.b | (1 << 7);
     }
-    if (b == 0)
+    if (state.b == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -6976,30 +7270,30 @@ std::uint8_t cpu::sra_b()
 
 std::uint8_t cpu::sra_c()
 {
-    bool bit_0_set = c & (1 << 0);
-    bool bit_7_set = c & (1 << 7);
-    c = c >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.c & (1 << 0);
+    bool bit_7_set = state.c & (1 << 7);
+    state.c = state.c >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (bit_7_set)
     {
-        c = c | (1 << 7);
+        state.c = state.c | (1 << 7);
     }
-    if (c == 0)
+    if (state.c == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7007,30 +7301,30 @@ std::uint8_t cpu::sra_c()
 
 std::uint8_t cpu::sra_d()
 {
-    bool bit_0_set = d & (1 << 0);
-    bool bit_7_set = d & (1 << 7);
-    d = d >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.d & (1 << 0);
+    bool bit_7_set = state.d & (1 << 7);
+    state.d = state.d >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (bit_7_set)
     {
-        d = d | (1 << 7);
+        state.d = state.d | (1 << 7);
     }
-    if (d == 0)
+    if (state.d == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7038,30 +7332,30 @@ std::uint8_t cpu::sra_d()
 
 std::uint8_t cpu::sra_e()
 {
-    bool bit_0_set = e & (1 << 0);
-    bool bit_7_set = e & (1 << 7);
-    e = e >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.e & (1 << 0);
+    bool bit_7_set = state.e & (1 << 7);
+    state.e = state.e >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (bit_7_set)
     {
-        e = e | (1 << 7);
+        state.e = state.e | (1 << 7);
     }
-    if (e == 0)
+    if (state.e == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7069,30 +7363,30 @@ std::uint8_t cpu::sra_e()
 
 std::uint8_t cpu::sra_h()
 {
-    bool bit_0_set = h & (1 << 0);
-    bool bit_7_set = h & (1 << 7);
-    h = h >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.h & (1 << 0);
+    bool bit_7_set = state.h & (1 << 7);
+    state.h = state.h >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (bit_7_set)
     {
-        h = h | (1 << 7);
+        state.h = state.h | (1 << 7);
     }
-    if (h == 0)
+    if (state.h == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7100,30 +7394,30 @@ std::uint8_t cpu::sra_h()
 
 std::uint8_t cpu::sra_l()
 {
-    bool bit_0_set = l & (1 << 0);
-    bool bit_7_set = l & (1 << 7);
-    l = l >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.l & (1 << 0);
+    bool bit_7_set = state.l & (1 << 7);
+    state.l = state.l >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (bit_7_set)
     {
-        l = l | (1 << 7);
+        state.l = state.l | (1 << 7);
     }
-    if (l == 0)
+    if (state.l == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7131,20 +7425,20 @@ std::uint8_t cpu::sra_l()
 
 std::uint8_t cpu::sra_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_0_set = memory & (1 << 0);
     bool bit_7_set = memory & (1 << 7);
     memory = memory >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (bit_7_set)
     {
@@ -7152,11 +7446,11 @@ std::uint8_t cpu::sra_addr_hl()
     }
     if (memory == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
     write(ahl, memory);
 
@@ -7165,30 +7459,30 @@ std::uint8_t cpu::sra_addr_hl()
 
 std::uint8_t cpu::sra_a()
 {
-    bool bit_0_set = a & (1 << 0);
-    bool bit_7_set = a & (1 << 7);
-    a = a >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.a & (1 << 0);
+    bool bit_7_set = state.a & (1 << 7);
+    state.a = state.a >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     if (bit_7_set)
     {
-        a = a | (1 << 7);
+        state.a = state.a | (1 << 7);
     }
-    if (a == 0)
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7196,17 +7490,17 @@ std::uint8_t cpu::sra_a()
 
 std::uint8_t cpu::swap_b()
 {
-    b = (b << 4) | (b >> 4);
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
-    if (b == 0)
+    state.b = (state.b << 4) | (state.b >> 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
+    if (state.b == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7214,17 +7508,17 @@ std::uint8_t cpu::swap_b()
 
 std::uint8_t cpu::swap_c()
 {
-    c = ((c & 0xf) << 4) | (c >> 4);
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
-    if (c == 0)
+    state.c = ((state.c & 0xf) << 4) | (state.c >> 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
+    if (state.c == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7232,17 +7526,17 @@ std::uint8_t cpu::swap_c()
 
 std::uint8_t cpu::swap_d()
 {
-    d = ((d & 0xf) << 4) | (d >> 4);
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
-    if (d == 0)
+    state.d = ((state.d & 0xf) << 4) | (state.d >> 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
+    if (state.d == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7250,17 +7544,17 @@ std::uint8_t cpu::swap_d()
 
 std::uint8_t cpu::swap_e()
 {
-    e = ((e & 0xf) << 4) | (e >> 4);
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
-    if (e == 0)
+    state.e = ((state.e & 0xf) << 4) | (state.e >> 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
+    if (state.e == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7268,17 +7562,17 @@ std::uint8_t cpu::swap_e()
 
 std::uint8_t cpu::swap_h()
 {
-    h = ((h & 0xf) << 4) | (h >> 4);
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
-    if (h == 0)
+    state.h = ((state.h & 0xf) << 4) | (state.h >> 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
+    if (state.h == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7286,17 +7580,17 @@ std::uint8_t cpu::swap_h()
 
 std::uint8_t cpu::swap_l()
 {
-    l = ((l & 0xf) << 4) | (l >> 4);
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
-    if (l == 0)
+    state.l = ((state.l & 0xf) << 4) | (state.l >> 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
+    if (state.l == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7304,20 +7598,20 @@ std::uint8_t cpu::swap_l()
 
 std::uint8_t cpu::swap_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = ((memory & 0xf) << 4) | (memory >> 4);
     write(ahl, memory);
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
     if (memory == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 16;
@@ -7325,17 +7619,17 @@ std::uint8_t cpu::swap_addr_hl()
 
 std::uint8_t cpu::swap_a()
 {
-    a = ((a & 0xf) << 4) | (a >> 4);
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
-    f = f & ~(1 << 4);
-    if (a == 0)
+    state.a = ((state.a & 0xf) << 4) | (state.a >> 4);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
+    state.f = state.f & ~(1 << 4);
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7343,26 +7637,26 @@ std::uint8_t cpu::swap_a()
 
 std::uint8_t cpu::srl_b()
 {
-    bool bit_0_set = b & (1 << 0);
-    b = b >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.b & (1 << 0);
+    state.b = state.b >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    b = b & ~(1 << 7);
-    if (b == 0)
+    state.b = state.b & ~(1 << 7);
+    if (state.b == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7370,26 +7664,26 @@ std::uint8_t cpu::srl_b()
 
 std::uint8_t cpu::srl_c()
 {
-    bool bit_0_set = c & (1 << 0);
-    c = c >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.c & (1 << 0);
+    state.c = state.c >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    c = c & ~(1 << 7);
-    if (c == 0)
+    state.c = state.c & ~(1 << 7);
+    if (state.c == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7397,26 +7691,26 @@ std::uint8_t cpu::srl_c()
 
 std::uint8_t cpu::srl_d()
 {
-    bool bit_0_set = d & (1 << 0);
-    d = d >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.d & (1 << 0);
+    state.d = state.d >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    d = d & ~(1 << 7);
-    if (d == 0)
+    state.d = state.d & ~(1 << 7);
+    if (state.d == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7424,26 +7718,26 @@ std::uint8_t cpu::srl_d()
 
 std::uint8_t cpu::srl_e()
 {
-    bool bit_0_set = e & (1 << 0);
-    e = e >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.e & (1 << 0);
+    state.e = state.e >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    e = e & ~(1 << 7);
-    if (e == 0)
+    state.e = state.e & ~(1 << 7);
+    if (state.e == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7451,26 +7745,26 @@ std::uint8_t cpu::srl_e()
 
 std::uint8_t cpu::srl_h()
 {
-    bool bit_0_set = h & (1 << 0);
-    h = h >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.h & (1 << 0);
+    state.h = state.h >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    h = h & ~(1 << 7);
-    if (h == 0)
+    state.h = state.h & ~(1 << 7);
+    if (state.h == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7478,26 +7772,26 @@ std::uint8_t cpu::srl_h()
 
 std::uint8_t cpu::srl_l()
 {
-    bool bit_0_set = l & (1 << 0);
-    l = l >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.l & (1 << 0);
+    state.l = state.l >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    l = l & ~(1 << 7);
-    if (l == 0)
+    state.l = state.l & ~(1 << 7);
+    if (state.l == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7505,28 +7799,28 @@ std::uint8_t cpu::srl_l()
 
 std::uint8_t cpu::srl_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_0_set = memory & (1 << 0);
     memory = memory >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
     memory = memory & ~(1 << 7);
     if (memory == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
     write(ahl, memory);
 
@@ -7535,26 +7829,26 @@ std::uint8_t cpu::srl_addr_hl()
 
 std::uint8_t cpu::srl_a()
 {
-    bool bit_0_set = a & (1 << 0);
-    a = a >> 1;
-    f = f & ~(1 << 6);
-    f = f & ~(1 << 5);
+    bool bit_0_set = state.a & (1 << 0);
+    state.a = state.a >> 1;
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f & ~(1 << 5);
     if (bit_0_set)
     {
-        f = f | (1 << 4);
+        state.f = state.f | (1 << 4);
     }
     else
     {
-        f = f & ~(1 << 4);
+        state.f = state.f & ~(1 << 4);
     }
-    a = a & ~(1 << 7);
-    if (a == 0)
+    state.a = state.a & ~(1 << 7);
+    if (state.a == 0)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
 
     return 8;
@@ -7562,1153 +7856,1153 @@ std::uint8_t cpu::srl_a()
 
 std::uint8_t cpu::bit_0_b()
 {
-    bool bit_set = b & (1 << 0);
+    bool bit_set = state.b & (1 << 0);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_0_c()
 {
-    bool bit_set = c & (1 << 0);
+    bool bit_set = state.c & (1 << 0);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_0_d()
 {
-    bool bit_set = d & (1 << 0);
+    bool bit_set = state.d & (1 << 0);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_0_e()
 {
-    bool bit_set = e & (1 << 0);
+    bool bit_set = state.e & (1 << 0);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_0_h()
 {
-    bool bit_set = h & (1 << 0);
+    bool bit_set = state.h & (1 << 0);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_0_l()
 {
-    bool bit_set = l & (1 << 0);
+    bool bit_set = state.l & (1 << 0);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_0_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_set = memory & (1 << 0);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 12;
 }
 
 std::uint8_t cpu::bit_0_a()
 {
-    bool bit_set = a & (1 << 0);
+    bool bit_set = state.a & (1 << 0);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_1_b()
 {
-    bool bit_set = b & (1 << 1);
+    bool bit_set = state.b & (1 << 1);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_1_c()
 {
-    bool bit_set = c & (1 << 1);
+    bool bit_set = state.c & (1 << 1);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_1_d()
 {
-    bool bit_set = d & (1 << 1);
+    bool bit_set = state.d & (1 << 1);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_1_e()
 {
-    bool bit_set = e & (1 << 1);
+    bool bit_set = state.e & (1 << 1);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_1_h()
 {
-    bool bit_set = h & (1 << 1);
+    bool bit_set = state.h & (1 << 1);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_1_l()
 {
-    bool bit_set = l & (1 << 1);
+    bool bit_set = state.l & (1 << 1);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_1_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_set = memory & (1 << 1);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 12;
 }
 
 std::uint8_t cpu::bit_1_a()
 {
-    bool bit_set = a & (1 << 1);
+    bool bit_set = state.a & (1 << 1);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_2_b()
 {
-    bool bit_set = b & (1 << 2);
+    bool bit_set = state.b & (1 << 2);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_2_c()
 {
-    bool bit_set = c & (1 << 2);
+    bool bit_set = state.c & (1 << 2);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_2_d()
 {
-    bool bit_set = d & (1 << 2);
+    bool bit_set = state.d & (1 << 2);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_2_e()
 {
-    bool bit_set = e & (1 << 2);
+    bool bit_set = state.e & (1 << 2);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_2_h()
 {
-    bool bit_set = h & (1 << 2);
+    bool bit_set = state.h & (1 << 2);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_2_l()
 {
-    bool bit_set = l & (1 << 2);
+    bool bit_set = state.l & (1 << 2);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_2_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_set = memory & (1 << 2);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 12;
 }
 
 std::uint8_t cpu::bit_2_a()
 {
-    bool bit_set = a & (1 << 2);
+    bool bit_set = state.a & (1 << 2);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_3_b()
 {
-    bool bit_set = b & (1 << 3);
+    bool bit_set = state.b & (1 << 3);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_3_c()
 {
-    bool bit_set = c & (1 << 3);
+    bool bit_set = state.c & (1 << 3);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_3_d()
 {
-    bool bit_set = d & (1 << 3);
+    bool bit_set = state.d & (1 << 3);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_3_e()
 {
-    bool bit_set = e & (1 << 3);
+    bool bit_set = state.e & (1 << 3);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_3_h()
 {
-    bool bit_set = h & (1 << 3);
+    bool bit_set = state.h & (1 << 3);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_3_l()
 {
-    bool bit_set = l & (1 << 3);
+    bool bit_set = state.l & (1 << 3);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_3_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_set = memory & (1 << 3);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 12;
 }
 
 std::uint8_t cpu::bit_3_a()
 {
-    bool bit_set = a & (1 << 3);
+    bool bit_set = state.a & (1 << 3);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_4_b()
 {
-    bool bit_set = b & (1 << 4);
+    bool bit_set = state.b & (1 << 4);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_4_c()
 {
-    bool bit_set = c & (1 << 4);
+    bool bit_set = state.c & (1 << 4);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_4_d()
 {
-    bool bit_set = d & (1 << 4);
+    bool bit_set = state.d & (1 << 4);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_4_e()
 {
-    bool bit_set = e & (1 << 4);
+    bool bit_set = state.e & (1 << 4);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_4_h()
 {
-    bool bit_set = h & (1 << 4);
+    bool bit_set = state.h & (1 << 4);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_4_l()
 {
-    bool bit_set = l & (1 << 4);
+    bool bit_set = state.l & (1 << 4);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_4_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_set = memory & (1 << 4);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 12;
 }
 
 std::uint8_t cpu::bit_4_a()
 {
-    bool bit_set = a & (1 << 4);
+    bool bit_set = state.a & (1 << 4);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_5_b()
 {
-    bool bit_set = b & (1 << 5);
+    bool bit_set = state.b & (1 << 5);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_5_c()
 {
-    bool bit_set = c & (1 << 5);
+    bool bit_set = state.c & (1 << 5);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_5_d()
 {
-    bool bit_set = d & (1 << 5);
+    bool bit_set = state.d & (1 << 5);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_5_e()
 {
-    bool bit_set = e & (1 << 5);
+    bool bit_set = state.e & (1 << 5);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_5_h()
 {
-    bool bit_set = h & (1 << 5);
+    bool bit_set = state.h & (1 << 5);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_5_l()
 {
-    bool bit_set = l & (1 << 5);
+    bool bit_set = state.l & (1 << 5);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_5_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_set = memory & (1 << 5);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 12;
 }
 
 std::uint8_t cpu::bit_5_a()
 {
-    bool bit_set = a & (1 << 5);
+    bool bit_set = state.a & (1 << 5);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_6_b()
 {
-    bool bit_set = b & (1 << 6);
+    bool bit_set = state.b & (1 << 6);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_6_c()
 {
-    bool bit_set = c & (1 << 6);
+    bool bit_set = state.c & (1 << 6);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_6_d()
 {
-    bool bit_set = d & (1 << 6);
+    bool bit_set = state.d & (1 << 6);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_6_e()
 {
-    bool bit_set = e & (1 << 6);
+    bool bit_set = state.e & (1 << 6);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_6_h()
 {
-    bool bit_set = h & (1 << 6);
+    bool bit_set = state.h & (1 << 6);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_6_l()
 {
-    bool bit_set = l & (1 << 6);
+    bool bit_set = state.l & (1 << 6);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_6_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_set = memory & (1 << 6);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 12;
 }
 
 std::uint8_t cpu::bit_6_a()
 {
-    bool bit_set = a & (1 << 6);
+    bool bit_set = state.a & (1 << 6);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_7_b()
 {
-    bool bit_set = b & (1 << 7);
+    bool bit_set = state.b & (1 << 7);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_7_c()
 {
-    bool bit_set = c & (1 << 7);
+    bool bit_set = state.c & (1 << 7);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_7_d()
 {
-    bool bit_set = d & (1 << 7);
+    bool bit_set = state.d & (1 << 7);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_7_e()
 {
-    bool bit_set = e & (1 << 7);
+    bool bit_set = state.e & (1 << 7);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_7_h()
 {
-    bool bit_set = h & (1 << 7);
+    bool bit_set = state.h & (1 << 7);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_7_l()
 {
-    bool bit_set = l & (1 << 7);
+    bool bit_set = state.l & (1 << 7);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::bit_7_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     bool bit_set = memory & (1 << 7);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 12;
 }
 
 std::uint8_t cpu::bit_7_a()
 {
-    bool bit_set = a & (1 << 7);
+    bool bit_set = state.a & (1 << 7);
     if (!bit_set)
     {
-        f = f | (1 << 7);
+        state.f = state.f | (1 << 7);
     }
     else
     {
-        f = f & ~(1 << 7);
+        state.f = state.f & ~(1 << 7);
     }
-    f = f & ~(1 << 6);
-    f = f | (1 << 5);
+    state.f = state.f & ~(1 << 6);
+    state.f = state.f | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::res_0_b()
 {
-    b = b & ~(1 << 0);
+    state.b = state.b & ~(1 << 0);
 
     return 8;
 }
 
 std::uint8_t cpu::res_0_c()
 {
-    c = c & ~(1 << 0);
+    state.c = state.c & ~(1 << 0);
 
     return 8;
 }
 
 std::uint8_t cpu::res_0_d()
 {
-    d = d & ~(1 << 0);
+    state.d = state.d & ~(1 << 0);
 
     return 8;
 }
 
 std::uint8_t cpu::res_0_e()
 {
-    e = e & ~(1 << 0);
+    state.e = state.e & ~(1 << 0);
 
     return 8;
 }
 
 std::uint8_t cpu::res_0_h()
 {
-    h = h & ~(1 << 0);
+    state.h = state.h & ~(1 << 0);
 
     return 8;
 }
 
 std::uint8_t cpu::res_0_l()
 {
-    l = l & ~(1 << 0);
+    state.l = state.l & ~(1 << 0);
 
     return 8;
 }
 
 std::uint8_t cpu::res_0_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory & ~(1 << 0);
     write(ahl, memory);
@@ -8718,56 +9012,56 @@ std::uint8_t cpu::res_0_addr_hl()
 
 std::uint8_t cpu::res_0_a()
 {
-    a = a & ~(1 << 0);
+    state.a = state.a & ~(1 << 0);
 
     return 8;
 }
 
 std::uint8_t cpu::res_1_b()
 {
-    b = b & ~(1 << 1);
+    state.b = state.b & ~(1 << 1);
 
     return 8;
 }
 
 std::uint8_t cpu::res_1_c()
 {
-    c = c & ~(1 << 1);
+    state.c = state.c & ~(1 << 1);
 
     return 8;
 }
 
 std::uint8_t cpu::res_1_d()
 {
-    d = d & ~(1 << 1);
+    state.d = state.d & ~(1 << 1);
 
     return 8;
 }
 
 std::uint8_t cpu::res_1_e()
 {
-    e = e & ~(1 << 1);
+    state.e = state.e & ~(1 << 1);
 
     return 8;
 }
 
 std::uint8_t cpu::res_1_h()
 {
-    h = h & ~(1 << 1);
+    state.h = state.h & ~(1 << 1);
 
     return 8;
 }
 
 std::uint8_t cpu::res_1_l()
 {
-    l = l & ~(1 << 1);
+    state.l = state.l & ~(1 << 1);
 
     return 8;
 }
 
 std::uint8_t cpu::res_1_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory & ~(1 << 1);
     write(ahl, memory);
@@ -8777,56 +9071,56 @@ std::uint8_t cpu::res_1_addr_hl()
 
 std::uint8_t cpu::res_1_a()
 {
-    a = a & ~(1 << 1);
+    state.a = state.a & ~(1 << 1);
 
     return 8;
 }
 
 std::uint8_t cpu::res_2_b()
 {
-    b = b & ~(1 << 2);
+    state.b = state.b & ~(1 << 2);
 
     return 8;
 }
 
 std::uint8_t cpu::res_2_c()
 {
-    c = c & ~(1 << 2);
+    state.c = state.c & ~(1 << 2);
 
     return 8;
 }
 
 std::uint8_t cpu::res_2_d()
 {
-    d = d & ~(1 << 2);
+    state.d = state.d & ~(1 << 2);
 
     return 8;
 }
 
 std::uint8_t cpu::res_2_e()
 {
-    e = e & ~(1 << 2);
+    state.e = state.e & ~(1 << 2);
 
     return 8;
 }
 
 std::uint8_t cpu::res_2_h()
 {
-    h = h & ~(1 << 2);
+    state.h = state.h & ~(1 << 2);
 
     return 8;
 }
 
 std::uint8_t cpu::res_2_l()
 {
-    l = l & ~(1 << 2);
+    state.l = state.l & ~(1 << 2);
 
     return 8;
 }
 
 std::uint8_t cpu::res_2_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory & ~(1 << 2);
     write(ahl, memory);
@@ -8836,56 +9130,56 @@ std::uint8_t cpu::res_2_addr_hl()
 
 std::uint8_t cpu::res_2_a()
 {
-    a = a & ~(1 << 2);
+    state.a = state.a & ~(1 << 2);
 
     return 8;
 }
 
 std::uint8_t cpu::res_3_b()
 {
-    b = b & ~(1 << 3);
+    state.b = state.b & ~(1 << 3);
 
     return 8;
 }
 
 std::uint8_t cpu::res_3_c()
 {
-    c = c & ~(1 << 3);
+    state.c = state.c & ~(1 << 3);
 
     return 8;
 }
 
 std::uint8_t cpu::res_3_d()
 {
-    d = d & ~(1 << 3);
+    state.d = state.d & ~(1 << 3);
 
     return 8;
 }
 
 std::uint8_t cpu::res_3_e()
 {
-    e = e & ~(1 << 3);
+    state.e = state.e & ~(1 << 3);
 
     return 8;
 }
 
 std::uint8_t cpu::res_3_h()
 {
-    h = h & ~(1 << 3);
+    state.h = state.h & ~(1 << 3);
 
     return 8;
 }
 
 std::uint8_t cpu::res_3_l()
 {
-    l = l & ~(1 << 3);
+    state.l = state.l & ~(1 << 3);
 
     return 8;
 }
 
 std::uint8_t cpu::res_3_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory & ~(1 << 3);
     write(ahl, memory);
@@ -8895,56 +9189,56 @@ std::uint8_t cpu::res_3_addr_hl()
 
 std::uint8_t cpu::res_3_a()
 {
-    a = a & ~(1 << 3);
+    state.a = state.a & ~(1 << 3);
 
     return 8;
 }
 
 std::uint8_t cpu::res_4_b()
 {
-    b = b & ~(1 << 4);
+    state.b = state.b & ~(1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::res_4_c()
 {
-    c = c & ~(1 << 4);
+    state.c = state.c & ~(1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::res_4_d()
 {
-    d = d & ~(1 << 4);
+    state.d = state.d & ~(1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::res_4_e()
 {
-    e = e & ~(1 << 4);
+    state.e = state.e & ~(1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::res_4_h()
 {
-    h = h & ~(1 << 4);
+    state.h = state.h & ~(1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::res_4_l()
 {
-    l = l & ~(1 << 4);
+    state.l = state.l & ~(1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::res_4_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory & ~(1 << 4);
     write(ahl, memory);
@@ -8954,56 +9248,56 @@ std::uint8_t cpu::res_4_addr_hl()
 
 std::uint8_t cpu::res_4_a()
 {
-    a = a & ~(1 << 4);
+    state.a = state.a & ~(1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::res_5_b()
 {
-    b = b & ~(1 << 5);
+    state.b = state.b & ~(1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::res_5_c()
 {
-    c = c & ~(1 << 5);
+    state.c = state.c & ~(1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::res_5_d()
 {
-    d = d & ~(1 << 5);
+    state.d = state.d & ~(1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::res_5_e()
 {
-    e = e & ~(1 << 5);
+    state.e = state.e & ~(1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::res_5_h()
 {
-    h = h & ~(1 << 5);
+    state.h = state.h & ~(1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::res_5_l()
 {
-    l = l & ~(1 << 5);
+    state.l = state.l & ~(1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::res_5_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory & ~(1 << 5);
     write(ahl, memory);
@@ -9013,56 +9307,56 @@ std::uint8_t cpu::res_5_addr_hl()
 
 std::uint8_t cpu::res_5_a()
 {
-    a = a & ~(1 << 5);
+    state.a = state.a & ~(1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::res_6_b()
 {
-    b = b & ~(1 << 6);
+    state.b = state.b & ~(1 << 6);
 
     return 8;
 }
 
 std::uint8_t cpu::res_6_c()
 {
-    c = c & ~(1 << 6);
+    state.c = state.c & ~(1 << 6);
 
     return 8;
 }
 
 std::uint8_t cpu::res_6_d()
 {
-    d = d & ~(1 << 6);
+    state.d = state.d & ~(1 << 6);
 
     return 8;
 }
 
 std::uint8_t cpu::res_6_e()
 {
-    e = e & ~(1 << 6);
+    state.e = state.e & ~(1 << 6);
 
     return 8;
 }
 
 std::uint8_t cpu::res_6_h()
 {
-    h = h & ~(1 << 6);
+    state.h = state.h & ~(1 << 6);
 
     return 8;
 }
 
 std::uint8_t cpu::res_6_l()
 {
-    l = l & ~(1 << 6);
+    state.l = state.l & ~(1 << 6);
 
     return 8;
 }
 
 std::uint8_t cpu::res_6_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory & ~(1 << 6);
     write(ahl, memory);
@@ -9072,56 +9366,56 @@ std::uint8_t cpu::res_6_addr_hl()
 
 std::uint8_t cpu::res_6_a()
 {
-    a = a & ~(1 << 6);
+    state.a = state.a & ~(1 << 6);
 
     return 8;
 }
 
 std::uint8_t cpu::res_7_b()
 {
-    b = b & ~(1 << 7);
+    state.b = state.b & ~(1 << 7);
 
     return 8;
 }
 
 std::uint8_t cpu::res_7_c()
 {
-    c = c & ~(1 << 7);
+    state.c = state.c & ~(1 << 7);
 
     return 8;
 }
 
 std::uint8_t cpu::res_7_d()
 {
-    d = d & ~(1 << 7);
+    state.d = state.d & ~(1 << 7);
 
     return 8;
 }
 
 std::uint8_t cpu::res_7_e()
 {
-    e = e & ~(1 << 7);
+    state.e = state.e & ~(1 << 7);
 
     return 8;
 }
 
 std::uint8_t cpu::res_7_h()
 {
-    h = h & ~(1 << 7);
+    state.h = state.h & ~(1 << 7);
 
     return 8;
 }
 
 std::uint8_t cpu::res_7_l()
 {
-    l = l & ~(1 << 7);
+    state.l = state.l & ~(1 << 7);
 
     return 8;
 }
 
 std::uint8_t cpu::res_7_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory & ~(1 << 7);
     write(ahl, memory);
@@ -9131,56 +9425,56 @@ std::uint8_t cpu::res_7_addr_hl()
 
 std::uint8_t cpu::res_7_a()
 {
-    a = a & ~(1 << 7);
+    state.a = state.a & ~(1 << 7);
 
     return 8;
 }
 
 std::uint8_t cpu::set_0_b()
 {
-    b = b | (1 << 0);
+    state.b = state.b | (1 << 0);
 
     return 8;
 }
 
 std::uint8_t cpu::set_0_c()
 {
-    c = c | (1 << 0);
+    state.c = state.c | (1 << 0);
 
     return 8;
 }
 
 std::uint8_t cpu::set_0_d()
 {
-    d = d | (1 << 0);
+    state.d = state.d | (1 << 0);
 
     return 8;
 }
 
 std::uint8_t cpu::set_0_e()
 {
-    e = e | (1 << 0);
+    state.e = state.e | (1 << 0);
 
     return 8;
 }
 
 std::uint8_t cpu::set_0_h()
 {
-    h = h | (1 << 0);
+    state.h = state.h | (1 << 0);
 
     return 8;
 }
 
 std::uint8_t cpu::set_0_l()
 {
-    l = l | (1 << 0);
+    state.l = state.l | (1 << 0);
 
     return 8;
 }
 
 std::uint8_t cpu::set_0_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory | (1 << 0);
     write(ahl, memory);
@@ -9190,56 +9484,56 @@ std::uint8_t cpu::set_0_addr_hl()
 
 std::uint8_t cpu::set_0_a()
 {
-    a = a | (1 << 0);
+    state.a = state.a | (1 << 0);
 
     return 8;
 }
 
 std::uint8_t cpu::set_1_b()
 {
-    b = b | (1 << 1);
+    state.b = state.b | (1 << 1);
 
     return 8;
 }
 
 std::uint8_t cpu::set_1_c()
 {
-    c = c | (1 << 1);
+    state.c = state.c | (1 << 1);
 
     return 8;
 }
 
 std::uint8_t cpu::set_1_d()
 {
-    d = d | (1 << 1);
+    state.d = state.d | (1 << 1);
 
     return 8;
 }
 
 std::uint8_t cpu::set_1_e()
 {
-    e = e | (1 << 1);
+    state.e = state.e | (1 << 1);
 
     return 8;
 }
 
 std::uint8_t cpu::set_1_h()
 {
-    h = h | (1 << 1);
+    state.h = state.h | (1 << 1);
 
     return 8;
 }
 
 std::uint8_t cpu::set_1_l()
 {
-    l = l | (1 << 1);
+    state.l = state.l | (1 << 1);
 
     return 8;
 }
 
 std::uint8_t cpu::set_1_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory | (1 << 1);
     write(ahl, memory);
@@ -9249,56 +9543,56 @@ std::uint8_t cpu::set_1_addr_hl()
 
 std::uint8_t cpu::set_1_a()
 {
-    a = a | (1 << 1);
+    state.a = state.a | (1 << 1);
 
     return 8;
 }
 
 std::uint8_t cpu::set_2_b()
 {
-    b = b | (1 << 2);
+    state.b = state.b | (1 << 2);
 
     return 8;
 }
 
 std::uint8_t cpu::set_2_c()
 {
-    c = c | (1 << 2);
+    state.c = state.c | (1 << 2);
 
     return 8;
 }
 
 std::uint8_t cpu::set_2_d()
 {
-    d = d | (1 << 2);
+    state.d = state.d | (1 << 2);
 
     return 8;
 }
 
 std::uint8_t cpu::set_2_e()
 {
-    e = e | (1 << 2);
+    state.e = state.e | (1 << 2);
 
     return 8;
 }
 
 std::uint8_t cpu::set_2_h()
 {
-    h = h | (1 << 2);
+    state.h = state.h | (1 << 2);
 
     return 8;
 }
 
 std::uint8_t cpu::set_2_l()
 {
-    l = l | (1 << 2);
+    state.l = state.l | (1 << 2);
 
     return 8;
 }
 
 std::uint8_t cpu::set_2_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory | (1 << 2);
     write(ahl, memory);
@@ -9308,56 +9602,56 @@ std::uint8_t cpu::set_2_addr_hl()
 
 std::uint8_t cpu::set_2_a()
 {
-    a = a | (1 << 2);
+    state.a = state.a | (1 << 2);
 
     return 8;
 }
 
 std::uint8_t cpu::set_3_b()
 {
-    b = b | (1 << 3);
+    state.b = state.b | (1 << 3);
 
     return 8;
 }
 
 std::uint8_t cpu::set_3_c()
 {
-    c = c | (1 << 3);
+    state.c = state.c | (1 << 3);
 
     return 8;
 }
 
 std::uint8_t cpu::set_3_d()
 {
-    d = d | (1 << 3);
+    state.d = state.d | (1 << 3);
 
     return 8;
 }
 
 std::uint8_t cpu::set_3_e()
 {
-    e = e | (1 << 3);
+    state.e = state.e | (1 << 3);
 
     return 8;
 }
 
 std::uint8_t cpu::set_3_h()
 {
-    h = h | (1 << 3);
+    state.h = state.h | (1 << 3);
 
     return 8;
 }
 
 std::uint8_t cpu::set_3_l()
 {
-    l = l | (1 << 3);
+    state.l = state.l | (1 << 3);
 
     return 8;
 }
 
 std::uint8_t cpu::set_3_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory | (1 << 3);
     write(ahl, memory);
@@ -9367,56 +9661,56 @@ std::uint8_t cpu::set_3_addr_hl()
 
 std::uint8_t cpu::set_3_a()
 {
-    a = a | (1 << 3);
+    state.a = state.a | (1 << 3);
 
     return 8;
 }
 
 std::uint8_t cpu::set_4_b()
 {
-    b = b | (1 << 4);
+    state.b = state.b | (1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::set_4_c()
 {
-    c = c | (1 << 4);
+    state.c = state.c | (1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::set_4_d()
 {
-    d = d | (1 << 4);
+    state.d = state.d | (1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::set_4_e()
 {
-    e = e | (1 << 4);
+    state.e = state.e | (1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::set_4_h()
 {
-    h = h | (1 << 4);
+    state.h = state.h | (1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::set_4_l()
 {
-    l = l | (1 << 4);
+    state.l = state.l | (1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::set_4_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory | (1 << 4);
     write(ahl, memory);
@@ -9426,56 +9720,56 @@ std::uint8_t cpu::set_4_addr_hl()
 
 std::uint8_t cpu::set_4_a()
 {
-    a = a | (1 << 4);
+    state.a = state.a | (1 << 4);
 
     return 8;
 }
 
 std::uint8_t cpu::set_5_b()
 {
-    b = b | (1 << 5);
+    state.b = state.b | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::set_5_c()
 {
-    c = c | (1 << 5);
+    state.c = state.c | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::set_5_d()
 {
-    d = d | (1 << 5);
+    state.d = state.d | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::set_5_e()
 {
-    e = e | (1 << 5);
+    state.e = state.e | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::set_5_h()
 {
-    h = h | (1 << 5);
+    state.h = state.h | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::set_5_l()
 {
-    l = l | (1 << 5);
+    state.l = state.l | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::set_5_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory | (1 << 5);
     write(ahl, memory);
@@ -9485,56 +9779,56 @@ std::uint8_t cpu::set_5_addr_hl()
 
 std::uint8_t cpu::set_5_a()
 {
-    a = a | (1 << 5);
+    state.a = state.a | (1 << 5);
 
     return 8;
 }
 
 std::uint8_t cpu::set_6_b()
 {
-    b = b | (1 << 6);
+    state.b = state.b | (1 << 6);
 
     return 8;
 }
 
 std::uint8_t cpu::set_6_c()
 {
-    c = c | (1 << 6);
+    state.c = state.c | (1 << 6);
 
     return 8;
 }
 
 std::uint8_t cpu::set_6_d()
 {
-    d = d | (1 << 6);
+    state.d = state.d | (1 << 6);
 
     return 8;
 }
 
 std::uint8_t cpu::set_6_e()
 {
-    e = e | (1 << 6);
+    state.e = state.e | (1 << 6);
 
     return 8;
 }
 
 std::uint8_t cpu::set_6_h()
 {
-    h = h | (1 << 6);
+    state.h = state.h | (1 << 6);
 
     return 8;
 }
 
 std::uint8_t cpu::set_6_l()
 {
-    l = l | (1 << 6);
+    state.l = state.l | (1 << 6);
 
     return 8;
 }
 
 std::uint8_t cpu::set_6_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory | (1 << 6);
     write(ahl, memory);
@@ -9544,56 +9838,56 @@ std::uint8_t cpu::set_6_addr_hl()
 
 std::uint8_t cpu::set_6_a()
 {
-    a = a | (1 << 6);
+    state.a = state.a | (1 << 6);
 
     return 8;
 }
 
 std::uint8_t cpu::set_7_b()
 {
-    b = b | (1 << 7);
+    state.b = state.b | (1 << 7);
 
     return 8;
 }
 
 std::uint8_t cpu::set_7_c()
 {
-    c = c | (1 << 7);
+    state.c = state.c | (1 << 7);
 
     return 8;
 }
 
 std::uint8_t cpu::set_7_d()
 {
-    d = d | (1 << 7);
+    state.d = state.d | (1 << 7);
 
     return 8;
 }
 
 std::uint8_t cpu::set_7_e()
 {
-    e = e | (1 << 7);
+    state.e = state.e | (1 << 7);
 
     return 8;
 }
 
 std::uint8_t cpu::set_7_h()
 {
-    h = h | (1 << 7);
+    state.h = state.h | (1 << 7);
 
     return 8;
 }
 
 std::uint8_t cpu::set_7_l()
 {
-    l = l | (1 << 7);
+    state.l = state.l | (1 << 7);
 
     return 8;
 }
 
 std::uint8_t cpu::set_7_addr_hl()
 {
-    std::uint16_t ahl = (h << 8) | l;
+    std::uint16_t ahl = (state.h << 8) | state.l;
     std::uint8_t memory = read(ahl);
     memory = memory | (1 << 7);
     write(ahl, memory);
@@ -9603,7 +9897,7 @@ std::uint8_t cpu::set_7_addr_hl()
 
 std::uint8_t cpu::set_7_a()
 {
-    a = a | (1 << 7);
+    state.a = state.a | (1 << 7);
 
     return 8;
 }
@@ -9611,4 +9905,522 @@ std::uint8_t cpu::set_7_a()
 std::uint8_t cpu::invalid()
 {
     return 0;
-}
\ No newline at end of file
+}
+
+const std::array<opcode_info, 256> opcode_table = {{
+    {"NOP", 1, 4, 4}, // 0x00
+    {"LD BC,d16", 3, 12, 12}, // 0x01
+    {"LD (BC),A", 1, 8, 8}, // 0x02
+    {"INC BC", 1, 8, 8}, // 0x03
+    {"INC B", 1, 4, 4}, // 0x04
+    {"DEC B", 1, 4, 4}, // 0x05
+    {"LD B,d8", 2, 8, 8}, // 0x06
+    {"RLCA", 1, 4, 4}, // 0x07
+    {"LD (a16),SP", 3, 20, 20}, // 0x08
+    {"ADD HL,BC", 1, 8, 8}, // 0x09
+    {"LD A,(BC)", 1, 8, 8}, // 0x0a
+    {"DEC BC", 1, 8, 8}, // 0x0b
+    {"INC C", 1, 4, 4}, // 0x0c
+    {"DEC C", 1, 4, 4}, // 0x0d
+    {"LD C,d8", 2, 8, 8}, // 0x0e
+    {"RRCA", 1, 4, 4}, // 0x0f
+    {"STOP", 2, 4, 4}, // 0x10
+    {"LD DE,d16", 3, 12, 12}, // 0x11
+    {"LD (DE),A", 1, 8, 8}, // 0x12
+    {"INC DE", 1, 8, 8}, // 0x13
+    {"INC D", 1, 4, 4}, // 0x14
+    {"DEC D", 1, 4, 4}, // 0x15
+    {"LD D,d8", 2, 8, 8}, // 0x16
+    {"RLA", 1, 4, 4}, // 0x17
+    {"JR r8", 2, 12, 12}, // 0x18
+    {"ADD HL,DE", 1, 8, 8}, // 0x19
+    {"LD A,(DE)", 1, 8, 8}, // 0x1a
+    {"DEC DE", 1, 8, 8}, // 0x1b
+    {"INC E", 1, 4, 4}, // 0x1c
+    {"DEC E", 1, 4, 4}, // 0x1d
+    {"LD E,d8", 2, 8, 8}, // 0x1e
+    {"RRA", 1, 4, 4}, // 0x1f
+    {"JR NZ,r8", 2, 8, 12}, // 0x20
+    {"LD HL,d16", 3, 12, 12}, // 0x21
+    {"LD (HL+),A", 1, 8, 8}, // 0x22
+    {"INC HL", 1, 8, 8}, // 0x23
+    {"INC H", 1, 4, 4}, // 0x24
+    {"DEC H", 1, 4, 4}, // 0x25
+    {"LD H,d8", 2, 8, 8}, // 0x26
+    {"DAA", 1, 4, 4}, // 0x27
+    {"JR Z,r8", 2, 8, 12}, // 0x28
+    {"ADD HL,HL", 1, 8, 8}, // 0x29
+    {"LD A,(HL+)", 1, 8, 8}, // 0x2a
+    {"DEC HL", 1, 8, 8}, // 0x2b
+    {"INC L", 1, 4, 4}, // 0x2c
+    {"DEC L", 1, 4, 4}, // 0x2d
+    {"LD L,d8", 2, 8, 8}, // 0x2e
+    {"CPL", 1, 4, 4}, // 0x2f
+    {"JR NC,r8", 2, 8, 12}, // 0x30
+    {"LD SP,d16", 3, 12, 12}, // 0x31
+    {"LD (HL-),A", 1, 8, 8}, // 0x32
+    {"INC SP", 1, 8, 8}, // 0x33
+    {"INC (HL)", 1, 12, 12}, // 0x34
+    {"DEC (HL)", 1, 12, 12}, // 0x35
+    {"LD (HL),d8", 2, 12, 12}, // 0x36
+    {"SCF", 1, 4, 4}, // 0x37
+    {"JR C,r8", 2, 8, 12}, // 0x38
+    {"ADD HL,SP", 1, 8, 8}, // 0x39
+    {"LD A,(HL-)", 1, 8, 8}, // 0x3a
+    {"DEC SP", 1, 8, 8}, // 0x3b
+    {"INC A", 1, 4, 4}, // 0x3c
+    {"DEC A", 1, 4, 4}, // 0x3d
+    {"LD A,d8", 2, 8, 8}, // 0x3e
+    {"CCF", 1, 4, 4}, // 0x3f
+    {"LD B,B", 1, 4, 4}, // 0x40
+    {"LD B,C", 1, 4, 4}, // 0x41
+    {"LD B,D", 1, 4, 4}, // 0x42
+    {"LD B,E", 1, 4, 4}, // 0x43
+    {"LD B,H", 1, 4, 4}, // 0x44
+    {"LD B,L", 1, 4, 4}, // 0x45
+    {"LD B,(HL)", 1, 8, 8}, // 0x46
+    {"LD B,A", 1, 4, 4}, // 0x47
+    {"LD C,B", 1, 4, 4}, // 0x48
+    {"LD C,C", 1, 4, 4}, // 0x49
+    {"LD C,D", 1, 4, 4}, // 0x4a
+    {"LD C,E", 1, 4, 4}, // 0x4b
+    {"LD C,H", 1, 4, 4}, // 0x4c
+    {"LD C,L", 1, 4, 4}, // 0x4d
+    {"LD C,(HL)", 1, 8, 8}, // 0x4e
+    {"LD C,A", 1, 4, 4}, // 0x4f
+    {"LD D,B", 1, 4, 4}, // 0x50
+    {"LD D,C", 1, 4, 4}, // 0x51
+    {"LD D,D", 1, 4, 4}, // 0x52
+    {"LD D,E", 1, 4, 4}, // 0x53
+    {"LD D,H", 1, 4, 4}, // 0x54
+    {"LD D,L", 1, 4, 4}, // 0x55
+    {"LD D,(HL)", 1, 8, 8}, // 0x56
+    {"LD D,A", 1, 4, 4}, // 0x57
+    {"LD E,B", 1, 4, 4}, // 0x58
+    {"LD E,C", 1, 4, 4}, // 0x59
+    {"LD E,D", 1, 4, 4}, // 0x5a
+    {"LD E,E", 1, 4, 4}, // 0x5b
+    {"LD E,H", 1, 4, 4}, // 0x5c
+    {"LD E,L", 1, 4, 4}, // 0x5d
+    {"LD E,(HL)", 1, 8, 8}, // 0x5e
+    {"LD E,A", 1, 4, 4}, // 0x5f
+    {"LD H,B", 1, 4, 4}, // 0x60
+    {"LD H,C", 1, 4, 4}, // 0x61
+    {"LD H,D", 1, 4, 4}, // 0x62
+    {"LD H,E", 1, 4, 4}, // 0x63
+    {"LD H,H", 1, 4, 4}, // 0x64
+    {"LD H,L", 1, 4, 4}, // 0x65
+    {"LD H,(HL)", 1, 8, 8}, // 0x66
+    {"LD H,A", 1, 4, 4}, // 0x67
+    {"LD L,B", 1, 4, 4}, // 0x68
+    {"LD L,C", 1, 4, 4}, // 0x69
+    {"LD L,D", 1, 4, 4}, // 0x6a
+    {"LD L,E", 1, 4, 4}, // 0x6b
+    {"LD L,H", 1, 4, 4}, // 0x6c
+    {"LD L,L", 1, 4, 4}, // 0x6d
+    {"LD L,(HL)", 1, 8, 8}, // 0x6e
+    {"LD L,A", 1, 4, 4}, // 0x6f
+    {"LD (HL),B", 1, 8, 8}, // 0x70
+    {"LD (HL),C", 1, 8, 8}, // 0x71
+    {"LD (HL),D", 1, 8, 8}, // 0x72
+    {"LD (HL),E", 1, 8, 8}, // 0x73
+    {"LD (HL),H", 1, 8, 8}, // 0x74
+    {"LD (HL),L", 1, 8, 8}, // 0x75
+    {"HALT", 1, 4, 4}, // 0x76
+    {"LD (HL),A", 1, 8, 8}, // 0x77
+    {"LD A,B", 1, 4, 4}, // 0x78
+    {"LD A,C", 1, 4, 4}, // 0x79
+    {"LD A,D", 1, 4, 4}, // 0x7a
+    {"LD A,E", 1, 4, 4}, // 0x7b
+    {"LD A,H", 1, 4, 4}, // 0x7c
+    {"LD A,L", 1, 4, 4}, // 0x7d
+    {"LD A,(HL)", 1, 8, 8}, // 0x7e
+    {"LD A,A", 1, 4, 4}, // 0x7f
+    {"ADD A,B", 1, 4, 4}, // 0x80
+    {"ADD A,C", 1, 4, 4}, // 0x81
+    {"ADD A,D", 1, 4, 4}, // 0x82
+    {"ADD A,E", 1, 4, 4}, // 0x83
+    {"ADD A,H", 1, 4, 4}, // 0x84
+    {"ADD A,L", 1, 4, 4}, // 0x85
+    {"ADD A,(HL)", 1, 8, 8}, // 0x86
+    {"ADD A,A", 1, 4, 4}, // 0x87
+    {"ADC A,B", 1, 4, 4}, // 0x88
+    {"ADC A,C", 1, 4, 4}, // 0x89
+    {"ADC A,D", 1, 4, 4}, // 0x8a
+    {"ADC A,E", 1, 4, 4}, // 0x8b
+    {"ADC A,H", 1, 4, 4}, // 0x8c
+    {"ADC A,L", 1, 4, 4}, // 0x8d
+    {"ADC A,(HL)", 1, 8, 8}, // 0x8e
+    {"ADC A,A", 1, 4, 4}, // 0x8f
+    {"SUB B", 1, 4, 4}, // 0x90
+    {"SUB C", 1, 4, 4}, // 0x91
+    {"SUB D", 1, 4, 4}, // 0x92
+    {"SUB E", 1, 4, 4}, // 0x93
+    {"SUB H", 1, 4, 4}, // 0x94
+    {"SUB L", 1, 4, 4}, // 0x95
+    {"SUB (HL)", 1, 8, 8}, // 0x96
+    {"SUB A", 1, 4, 4}, // 0x97
+    {"SBC A,B", 1, 4, 4}, // 0x98
+    {"SBC A,C", 1, 4, 4}, // 0x99
+    {"SBC A,D", 1, 4, 4}, // 0x9a
+    {"SBC A,E", 1, 4, 4}, // 0x9b
+    {"SBC A,H", 1, 4, 4}, // 0x9c
+    {"SBC A,L", 1, 4, 4}, // 0x9d
+    {"SBC A,(HL)", 1, 8, 8}, // 0x9e
+    {"SBC A,A", 1, 4, 4}, // 0x9f
+    {"AND B", 1, 4, 4}, // 0xa0
+    {"AND C", 1, 4, 4}, // 0xa1
+    {"AND D", 1, 4, 4}, // 0xa2
+    {"AND E", 1, 4, 4}, // 0xa3
+    {"AND H", 1, 4, 4}, // 0xa4
+    {"AND L", 1, 4, 4}, // 0xa5
+    {"AND (HL)", 1, 8, 8}, // 0xa6
+    {"AND A", 1, 4, 4}, // 0xa7
+    {"XOR B", 1, 4, 4}, // 0xa8
+    {"XOR C", 1, 4, 4}, // 0xa9
+    {"XOR D", 1, 4, 4}, // 0xaa
+    {"XOR E", 1, 4, 4}, // 0xab
+    {"XOR H", 1, 4, 4}, // 0xac
+    {"XOR L", 1, 4, 4}, // 0xad
+    {"XOR (HL)", 1, 8, 8}, // 0xae
+    {"XOR A", 1, 4, 4}, // 0xaf
+    {"OR B", 1, 4, 4}, // 0xb0
+    {"OR C", 1, 4, 4}, // 0xb1
+    {"OR D", 1, 4, 4}, // 0xb2
+    {"OR E", 1, 4, 4}, // 0xb3
+    {"OR H", 1, 4, 4}, // 0xb4
+    {"OR L", 1, 4, 4}, // 0xb5
+    {"OR (HL)", 1, 8, 8}, // 0xb6
+    {"OR A", 1, 4, 4}, // 0xb7
+    {"CP B", 1, 4, 4}, // 0xb8
+    {"CP C", 1, 4, 4}, // 0xb9
+    {"CP D", 1, 4, 4}, // 0xba
+    {"CP E", 1, 4, 4}, // 0xbb
+    {"CP H", 1, 4, 4}, // 0xbc
+    {"CP L", 1, 4, 4}, // 0xbd
+    {"CP (HL)", 1, 8, 8}, // 0xbe
+    {"CP A", 1, 4, 4}, // 0xbf
+    {"RET NZ", 1, 8, 20}, // 0xc0
+    {"POP BC", 1, 12, 12}, // 0xc1
+    {"JP NZ,a16", 3, 12, 16}, // 0xc2
+    {"JP a16", 3, 16, 16}, // 0xc3
+    {"CALL NZ,a16", 3, 12, 24}, // 0xc4
+    {"PUSH BC", 1, 16, 16}, // 0xc5
+    {"ADD A,d8", 2, 8, 8}, // 0xc6
+    {"RST 00H", 1, 16, 16}, // 0xc7
+    {"RET Z", 1, 8, 20}, // 0xc8
+    {"RET", 1, 16, 16}, // 0xc9
+    {"JP Z,a16", 3, 12, 16}, // 0xca
+    {"PREFIX CB", 1, 4, 4}, // 0xcb
+    {"CALL Z,a16", 3, 12, 24}, // 0xcc
+    {"CALL a16", 3, 24, 24}, // 0xcd
+    {"ADC A,d8", 2, 8, 8}, // 0xce
+    {"RST 08H", 1, 16, 16}, // 0xcf
+    {"RET NC", 1, 8, 20}, // 0xd0
+    {"POP DE", 1, 12, 12}, // 0xd1
+    {"JP NC,a16", 3, 12, 16}, // 0xd2
+    {"INVALID", 1, 0, 0}, // 0xd3
+    {"CALL NC,a16", 3, 12, 24}, // 0xd4
+    {"PUSH DE", 1, 16, 16}, // 0xd5
+    {"SUB d8", 2, 8, 8}, // 0xd6
+    {"RST 10H", 1, 16, 16}, // 0xd7
+    {"RET C", 1, 8, 20}, // 0xd8
+    {"RETI", 1, 16, 16}, // 0xd9
+    {"JP C,a16", 3, 12, 16}, // 0xda
+    {"INVALID", 1, 0, 0}, // 0xdb
+    {"CALL C,a16", 3, 12, 24}, // 0xdc
+    {"INVALID", 1, 0, 0}, // 0xdd
+    {"SBC A,d8", 2, 8, 8}, // 0xde
+    {"RST 18H", 1, 16, 16}, // 0xdf
+    {"LDH (a8),A", 2, 12, 12}, // 0xe0
+    {"POP HL", 1, 12, 12}, // 0xe1
+    {"LD (C),A", 1, 8, 8}, // 0xe2
+    {"INVALID", 1, 0, 0}, // 0xe3
+    {"INVALID", 1, 0, 0}, // 0xe4
+    {"PUSH HL", 1, 16, 16}, // 0xe5
+    {"AND d8", 2, 8, 8}, // 0xe6
+    {"RST 20H", 1, 16, 16}, // 0xe7
+    {"ADD SP,r8", 2, 16, 16}, // 0xe8
+    {"JP HL", 1, 4, 4}, // 0xe9
+    {"LD (a16),A", 3, 16, 16}, // 0xea
+    {"INVALID", 1, 0, 0}, // 0xeb
+    {"INVALID", 1, 0, 0}, // 0xec
+    {"INVALID", 1, 0, 0}, // 0xed
+    {"XOR d8", 2, 8, 8}, // 0xee
+    {"RST 28H", 1, 16, 16}, // 0xef
+    {"LDH A,(a8)", 2, 12, 12}, // 0xf0
+    {"POP AF", 1, 12, 12}, // 0xf1
+    {"LD A,(C)", 1, 8, 8}, // 0xf2
+    {"DI", 1, 4, 4}, // 0xf3
+    {"INVALID", 1, 0, 0}, // 0xf4
+    {"PUSH AF", 1, 16, 16}, // 0xf5
+    {"OR d8", 2, 8, 8}, // 0xf6
+    {"RST 30H", 1, 16, 16}, // 0xf7
+    {"LD HL,SP+r8", 2, 12, 12}, // 0xf8
+    {"LD SP,HL", 1, 8, 8}, // 0xf9
+    {"LD A,(a16)", 3, 16, 16}, // 0xfa
+    {"EI", 1, 4, 4}, // 0xfb
+    {"INVALID", 1, 0, 0}, // 0xfc
+    {"INVALID", 1, 0, 0}, // 0xfd
+    {"CP d8", 2, 8, 8}, // 0xfe
+    {"RST 38H", 1, 16, 16}, // 0xff
+}};
+
+const std::array<opcode_info, 256> cb_opcode_table = {{
+    {"RLC B", 2, 8, 8}, // 0x00
+    {"RLC C", 2, 8, 8}, // 0x01
+    {"RLC D", 2, 8, 8}, // 0x02
+    {"RLC E", 2, 8, 8}, // 0x03
+    {"RLC H", 2, 8, 8}, // 0x04
+    {"RLC L", 2, 8, 8}, // 0x05
+    {"RLC (HL)", 2, 16, 16}, // 0x06
+    {"RLC A", 2, 8, 8}, // 0x07
+    {"RRC B", 2, 8, 8}, // 0x08
+    {"RRC C", 2, 8, 8}, // 0x09
+    {"RRC D", 2, 8, 8}, // 0x0a
+    {"RRC E", 2, 8, 8}, // 0x0b
+    {"RRC H", 2, 8, 8}, // 0x0c
+    {"RRC L", 2, 8, 8}, // 0x0d
+    {"RRC (HL)", 2, 16, 16}, // 0x0e
+    {"RRC A", 2, 8, 8}, // 0x0f
+    {"RL B", 2, 8, 8}, // 0x10
+    {"RL C", 2, 8, 8}, // 0x11
+    {"RL D", 2, 8, 8}, // 0x12
+    {"RL E", 2, 8, 8}, // 0x13
+    {"RL H", 2, 8, 8}, // 0x14
+    {"RL L", 2, 8, 8}, // 0x15
+    {"RL (HL)", 2, 16, 16}, // 0x16
+    {"RL A", 2, 8, 8}, // 0x17
+    {"RR B", 2, 8, 8}, // 0x18
+    {"RR C", 2, 8, 8}, // 0x19
+    {"RR D", 2, 8, 8}, // 0x1a
+    {"RR E", 2, 8, 8}, // 0x1b
+    {"RR H", 2, 8, 8}, // 0x1c
+    {"RR L", 2, 8, 8}, // 0x1d
+    {"RR (HL)", 2, 16, 16}, // 0x1e
+    {"RR A", 2, 8, 8}, // 0x1f
+    {"SLA B", 2, 8, 8}, // 0x20
+    {"SLA C", 2, 8, 8}, // 0x21
+    {"SLA D", 2, 8, 8}, // 0x22
+    {"SLA E", 2, 8, 8}, // 0x23
+    {"SLA H", 2, 8, 8}, // 0x24
+    {"SLA L", 2, 8, 8}, // 0x25
+    {"SLA (HL)", 2, 16, 16}, // 0x26
+    {"SLA A", 2, 8, 8}, // 0x27
+    {"SRA B", 2, 8, 8}, // 0x28
+    {"SRA C", 2, 8, 8}, // 0x29
+    {"SRA D", 2, 8, 8}, // 0x2a
+    {"SRA E", 2, 8, 8}, // 0x2b
+    {"SRA H", 2, 8, 8}, // 0x2c
+    {"SRA L", 2, 8, 8}, // 0x2d
+    {"SRA (HL)", 2, 16, 16}, // 0x2e
+    {"SRA A", 2, 8, 8}, // 0x2f
+    {"SWAP B", 2, 8, 8}, // 0x30
+    {"SWAP C", 2, 8, 8}, // 0x31
+    {"SWAP D", 2, 8, 8}, // 0x32
+    {"SWAP E", 2, 8, 8}, // 0x33
+    {"SWAP H", 2, 8, 8}, // 0x34
+    {"SWAP L", 2, 8, 8}, // 0x35
+    {"SWAP (HL)", 2, 16, 16}, // 0x36
+    {"SWAP A", 2, 8, 8}, // 0x37
+    {"SRL B", 2, 8, 8}, // 0x38
+    {"SRL C", 2, 8, 8}, // 0x39
+    {"SRL D", 2, 8, 8}, // 0x3a
+    {"SRL E", 2, 8, 8}, // 0x3b
+    {"SRL H", 2, 8, 8}, // 0x3c
+    {"SRL L", 2, 8, 8}, // 0x3d
+    {"SRL (HL)", 2, 16, 16}, // 0x3e
+    {"SRL A", 2, 8, 8}, // 0x3f
+    {"BIT 0,B", 2, 8, 8}, // 0x40
+    {"BIT 0,C", 2, 8, 8}, // 0x41
+    {"BIT 0,D", 2, 8, 8}, // 0x42
+    {"BIT 0,E", 2, 8, 8}, // 0x43
+    {"BIT 0,H", 2, 8, 8}, // 0x44
+    {"BIT 0,L", 2, 8, 8}, // 0x45
+    {"BIT 0,(HL)", 2, 12, 12}, // 0x46
+    {"BIT 0,A", 2, 8, 8}, // 0x47
+    {"BIT 1,B", 2, 8, 8}, // 0x48
+    {"BIT 1,C", 2, 8, 8}, // 0x49
+    {"BIT 1,D", 2, 8, 8}, // 0x4a
+    {"BIT 1,E", 2, 8, 8}, // 0x4b
+    {"BIT 1,H", 2, 8, 8}, // 0x4c
+    {"BIT 1,L", 2, 8, 8}, // 0x4d
+    {"BIT 1,(HL)", 2, 12, 12}, // 0x4e
+    {"BIT 1,A", 2, 8, 8}, // 0x4f
+    {"BIT 2,B", 2, 8, 8}, // 0x50
+    {"BIT 2,C", 2, 8, 8}, // 0x51
+    {"BIT 2,D", 2, 8, 8}, // 0x52
+    {"BIT 2,E", 2, 8, 8}, // 0x53
+    {"BIT 2,H", 2, 8, 8}, // 0x54
+    {"BIT 2,L", 2, 8, 8}, // 0x55
+    {"BIT 2,(HL)", 2, 12, 12}, // 0x56
+    {"BIT 2,A", 2, 8, 8}, // 0x57
+    {"BIT 3,B", 2, 8, 8}, // 0x58
+    {"BIT 3,C", 2, 8, 8}, // 0x59
+    {"BIT 3,D", 2, 8, 8}, // 0x5a
+    {"BIT 3,E", 2, 8, 8}, // 0x5b
+    {"BIT 3,H", 2, 8, 8}, // 0x5c
+    {"BIT 3,L", 2, 8, 8}, // 0x5d
+    {"BIT 3,(HL)", 2, 12, 12}, // 0x5e
+    {"BIT 3,A", 2, 8, 8}, // 0x5f
+    {"BIT 4,B", 2, 8, 8}, // 0x60
+    {"BIT 4,C", 2, 8, 8}, // 0x61
+    {"BIT 4,D", 2, 8, 8}, // 0x62
+    {"BIT 4,E", 2, 8, 8}, // 0x63
+    {"BIT 4,H", 2, 8, 8}, // 0x64
+    {"BIT 4,L", 2, 8, 8}, // 0x65
+    {"BIT 4,(HL)", 2, 12, 12}, // 0x66
+    {"BIT 4,A", 2, 8, 8}, // 0x67
+    {"BIT 5,B", 2, 8, 8}, // 0x68
+    {"BIT 5,C", 2, 8, 8}, // 0x69
+    {"BIT 5,D", 2, 8, 8}, // 0x6a
+    {"BIT 5,E", 2, 8, 8}, // 0x6b
+    {"BIT 5,H", 2, 8, 8}, // 0x6c
+    {"BIT 5,L", 2, 8, 8}, // 0x6d
+    {"BIT 5,(HL)", 2, 12, 12}, // 0x6e
+    {"BIT 5,A", 2, 8, 8}, // 0x6f
+    {"BIT 6,B", 2, 8, 8}, // 0x70
+    {"BIT 6,C", 2, 8, 8}, // 0x71
+    {"BIT 6,D", 2, 8, 8}, // 0x72
+    {"BIT 6,E", 2, 8, 8}, // 0x73
+    {"BIT 6,H", 2, 8, 8}, // 0x74
+    {"BIT 6,L", 2, 8, 8}, // 0x75
+    {"BIT 6,(HL)", 2, 12, 12}, // 0x76
+    {"BIT 6,A", 2, 8, 8}, // 0x77
+    {"BIT 7,B", 2, 8, 8}, // 0x78
+    {"BIT 7,C", 2, 8, 8}, // 0x79
+    {"BIT 7,D", 2, 8, 8}, // 0x7a
+    {"BIT 7,E", 2, 8, 8}, // 0x7b
+    {"BIT 7,H", 2, 8, 8}, // 0x7c
+    {"BIT 7,L", 2, 8, 8}, // 0x7d
+    {"BIT 7,(HL)", 2, 12, 12}, // 0x7e
+    {"BIT 7,A", 2, 8, 8}, // 0x7f
+    {"RES 0,B", 2, 8, 8}, // 0x80
+    {"RES 0,C", 2, 8, 8}, // 0x81
+    {"RES 0,D", 2, 8, 8}, // 0x82
+    {"RES 0,E", 2, 8, 8}, // 0x83
+    {"RES 0,H", 2, 8, 8}, // 0x84
+    {"RES 0,L", 2, 8, 8}, // 0x85
+    {"RES 0,(HL)", 2, 16, 16}, // 0x86
+    {"RES 0,A", 2, 8, 8}, // 0x87
+    {"RES 1,B", 2, 8, 8}, // 0x88
+    {"RES 1,C", 2, 8, 8}, // 0x89
+    {"RES 1,D", 2, 8, 8}, // 0x8a
+    {"RES 1,E", 2, 8, 8}, // 0x8b
+    {"RES 1,H", 2, 8, 8}, // 0x8c
+    {"RES 1,L", 2, 8, 8}, // 0x8d
+    {"RES 1,(HL)", 2, 16, 16}, // 0x8e
+    {"RES 1,A", 2, 8, 8}, // 0x8f
+    {"RES 2,B", 2, 8, 8}, // 0x90
+    {"RES 2,C", 2, 8, 8}, // 0x91
+    {"RES 2,D", 2, 8, 8}, // 0x92
+    {"RES 2,E", 2, 8, 8}, // 0x93
+    {"RES 2,H", 2, 8, 8}, // 0x94
+    {"RES 2,L", 2, 8, 8}, // 0x95
+    {"RES 2,(HL)", 2, 16, 16}, // 0x96
+    {"RES 2,A", 2, 8, 8}, // 0x97
+    {"RES 3,B", 2, 8, 8}, // 0x98
+    {"RES 3,C", 2, 8, 8}, // 0x99
+    {"RES 3,D", 2, 8, 8}, // 0x9a
+    {"RES 3,E", 2, 8, 8}, // 0x9b
+    {"RES 3,H", 2, 8, 8}, // 0x9c
+    {"RES 3,L", 2, 8, 8}, // 0x9d
+    {"RES 3,(HL)", 2, 16, 16}, // 0x9e
+    {"RES 3,A", 2, 8, 8}, // 0x9f
+    {"RES 4,B", 2, 8, 8}, // 0xa0
+    {"RES 4,C", 2, 8, 8}, // 0xa1
+    {"RES 4,D", 2, 8, 8}, // 0xa2
+    {"RES 4,E", 2, 8, 8}, // 0xa3
+    {"RES 4,H", 2, 8, 8}, // 0xa4
+    {"RES 4,L", 2, 8, 8}, // 0xa5
+    {"RES 4,(HL)", 2, 16, 16}, // 0xa6
+    {"RES 4,A", 2, 8, 8}, // 0xa7
+    {"RES 5,B", 2, 8, 8}, // 0xa8
+    {"RES 5,C", 2, 8, 8}, // 0xa9
+    {"RES 5,D", 2, 8, 8}, // 0xaa
+    {"RES 5,E", 2, 8, 8}, // 0xab
+    {"RES 5,H", 2, 8, 8}, // 0xac
+    {"RES 5,L", 2, 8, 8}, // 0xad
+    {"RES 5,(HL)", 2, 16, 16}, // 0xae
+    {"RES 5,A", 2, 8, 8}, // 0xaf
+    {"RES 6,B", 2, 8, 8}, // 0xb0
+    {"RES 6,C", 2, 8, 8}, // 0xb1
+    {"RES 6,D", 2, 8, 8}, // 0xb2
+    {"RES 6,E", 2, 8, 8}, // 0xb3
+    {"RES 6,H", 2, 8, 8}, // 0xb4
+    {"RES 6,L", 2, 8, 8}, // 0xb5
+    {"RES 6,(HL)", 2, 16, 16}, // 0xb6
+    {"RES 6,A", 2, 8, 8}, // 0xb7
+    {"RES 7,B", 2, 8, 8}, // 0xb8
+    {"RES 7,C", 2, 8, 8}, // 0xb9
+    {"RES 7,D", 2, 8, 8}, // 0xba
+    {"RES 7,E", 2, 8, 8}, // 0xbb
+    {"RES 7,H", 2, 8, 8}, // 0xbc
+    {"RES 7,L", 2, 8, 8}, // 0xbd
+    {"RES 7,(HL)", 2, 16, 16}, // 0xbe
+    {"RES 7,A", 2, 8, 8}, // 0xbf
+    {"SET 0,B", 2, 8, 8}, // 0xc0
+    {"SET 0,C", 2, 8, 8}, // 0xc1
+    {"SET 0,D", 2, 8, 8}, // 0xc2
+    {"SET 0,E", 2, 8, 8}, // 0xc3
+    {"SET 0,H", 2, 8, 8}, // 0xc4
+    {"SET 0,L", 2, 8, 8}, // 0xc5
+    {"SET 0,(HL)", 2, 16, 16}, // 0xc6
+    {"SET 0,A", 2, 8, 8}, // 0xc7
+    {"SET 1,B", 2, 8, 8}, // 0xc8
+    {"SET 1,C", 2, 8, 8}, // 0xc9
+    {"SET 1,D", 2, 8, 8}, // 0xca
+    {"SET 1,E", 2, 8, 8}, // 0xcb
+    {"SET 1,H", 2, 8, 8}, // 0xcc
+    {"SET 1,L", 2, 8, 8}, // 0xcd
+    {"SET 1,(HL)", 2, 16, 16}, // 0xce
+    {"SET 1,A", 2, 8, 8}, // 0xcf
+    {"SET 2,B", 2, 8, 8}, // 0xd0
+    {"SET 2,C", 2, 8, 8}, // 0xd1
+    {"SET 2,D", 2, 8, 8}, // 0xd2
+    {"SET 2,E", 2, 8, 8}, // 0xd3
+    {"SET 2,H", 2, 8, 8}, // 0xd4
+    {"SET 2,L", 2, 8, 8}, // 0xd5
+    {"SET 2,(HL)", 2, 16, 16}, // 0xd6
+    {"SET 2,A", 2, 8, 8}, // 0xd7
+    {"SET 3,B", 2, 8, 8}, // 0xd8
+    {"SET 3,C", 2, 8, 8}, // 0xd9
+    {"SET 3,D", 2, 8, 8}, // 0xda
+    {"SET 3,E", 2, 8, 8}, // 0xdb
+    {"SET 3,H", 2, 8, 8}, // 0xdc
+    {"SET 3,L", 2, 8, 8}, // 0xdd
+    {"SET 3,(HL)", 2, 16, 16}, // 0xde
+    {"SET 3,A", 2, 8, 8}, // 0xdf
+    {"SET 4,B", 2, 8, 8}, // 0xe0
+    {"SET 4,C", 2, 8, 8}, // 0xe1
+    {"SET 4,D", 2, 8, 8}, // 0xe2
+    {"SET 4,E", 2, 8, 8}, // 0xe3
+    {"SET 4,H", 2, 8, 8}, // 0xe4
+    {"SET 4,L", 2, 8, 8}, // 0xe5
+    {"SET 4,(HL)", 2, 16, 16}, // 0xe6
+    {"SET 4,A", 2, 8, 8}, // 0xe7
+    {"SET 5,B", 2, 8, 8}, // 0xe8
+    {"SET 5,C", 2, 8, 8}, // 0xe9
+    {"SET 5,D", 2, 8, 8}, // 0xea
+    {"SET 5,E", 2, 8, 8}, // 0xeb
+    {"SET 5,H", 2, 8, 8}, // 0xec
+    {"SET 5,L", 2, 8, 8}, // 0xed
+    {"SET 5,(HL)", 2, 16, 16}, // 0xee
+    {"SET 5,A", 2, 8, 8}, // 0xef
+    {"SET 6,B", 2, 8, 8}, // 0xf0
+    {"SET 6,C", 2, 8, 8}, // 0xf1
+    {"SET 6,D", 2, 8, 8}, // 0xf2
+    {"SET 6,E", 2, 8, 8}, // 0xf3
+    {"SET 6,H", 2, 8, 8}, // 0xf4
+    {"SET 6,L", 2, 8, 8}, // 0xf5
+    {"SET 6,(HL)", 2, 16, 16}, // 0xf6
+    {"SET 6,A", 2, 8, 8}, // 0xf7
+    {"SET 7,B", 2, 8, 8}, // 0xf8
+    {"SET 7,C", 2, 8, 8}, // 0xf9
+    {"SET 7,D", 2, 8, 8}, // 0xfa
+    {"SET 7,E", 2, 8, 8}, // 0xfb
+    {"SET 7,H", 2, 8, 8}, // 0xfc
+    {"SET 7,L", 2, 8, 8}, // 0xfd
+    {"SET 7,(HL)", 2, 16, 16}, // 0xfe
+    {"SET 7,A", 2, 8, 8}, // 0xff
+}};
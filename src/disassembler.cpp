@@ -0,0 +1,63 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "disassembler.h"
+
+const opcode_info &decode(const std::uint8_t *bytes)
+{
+    return bytes[0] == 0xcb ? cb_opcode_table[bytes[1]] : opcode_table[bytes[0]];
+}
+
+std::string disassemble(std::uint16_t address, const std::uint8_t *bytes)
+{
+    const opcode_info &info = decode(bytes);
+    std::string text = info.mnemonic;
+    std::uint8_t d8 = bytes[1];
+    std::uint16_t d16 = bytes[1] | (bytes[2] << 8);
+
+    // operand placeholders as written in the tables
+    static const char *const placeholders[] = {"d16", "a16", "d8", "a8", "r8"};
+    for (const char *placeholder : placeholders)
+    {
+        size_t at = text.find(placeholder);
+        if (at == std::string::npos)
+        {
+            continue;
+        }
+        char operand[8];
+        size_t start = at;
+        if (std::strcmp(placeholder, "d16") == 0 || std::strcmp(placeholder, "a16") == 0)
+        {
+            std::snprintf(operand, sizeof(operand), "$%04X", d16);
+        }
+        else if (std::strcmp(placeholder, "d8") == 0)
+        {
+            std::snprintf(operand, sizeof(operand), "$%02X", d8);
+        }
+        else if (std::strcmp(placeholder, "a8") == 0)
+        {
+            std::snprintf(operand, sizeof(operand), "$FF%02X", d8);
+        }
+        else if (text.compare(0, 2, "JR") == 0)
+        {
+            std::snprintf(operand, sizeof(operand), "$%04X",
+                          static_cast<std::uint16_t>(address + 2 + static_cast<std::int8_t>(d8)));
+        }
+        else
+        {
+            // SP+r8: the sign replaces the table's '+'
+            std::int8_t offset = static_cast<std::int8_t>(d8);
+            if (at > 0 && text[at - 1] == '+')
+            {
+                --start;
+            }
+            std::snprintf(operand, sizeof(operand), "%s$%02X", offset < 0 ? "-" : (start < at ? "+" : ""),
+                          offset < 0 ? -offset : offset);
+        }
+        text.replace(start, at + std::strlen(placeholder) - start, operand);
+        break;
+    }
+    return text;
+}
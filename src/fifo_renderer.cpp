@@ -0,0 +1,282 @@
+#include <cstdint>
+#include <algorithm>
+
+#include "renderer.h"
+#include "bus.h"
+
+fifo_renderer::fifo_renderer()
+{
+    gb_bus = nullptr;
+    ly = 0;
+    fetched.fill(false);
+    line = nullptr;
+    bg_size = 0;
+    obj_size = 0;
+    fetch_step = 0;
+    fetch_x = 0;
+    tile_index = 0;
+    attributes = 0;
+    tile_row = 0;
+    tile_low = 0;
+    tile_high = 0;
+    startup = 0;
+    lx = 160;
+    discard = 0;
+    in_window = false;
+    window_drawn = false;
+    window_line = 0;
+    sprite_fetch = -1;
+    sprite_dots = 0;
+}
+
+void fifo_renderer::begin(std::uint8_t ly, const std::vector<sprite> &sprites, std::uint16_t *line)
+{
+    if (ly == 0)
+    {
+        window_line = 0;
+    }
+    this->ly = ly;
+    this->sprites = sprites;
+    this->line = line;
+    fetched.fill(false);
+    bg_size = 0;
+    obj_size = 0;
+    fetch_step = 0;
+    fetch_x = 0;
+    // the first tile is fetched and thrown away; with the 6-dot fetch and
+    // push that follows, the first pixel comes out on dot 13
+    startup = 5;
+    lx = 0;
+    discard = gb_bus->read(0xff43) & 0x07;
+    in_window = false;
+    window_drawn = false;
+    sprite_fetch = -1;
+    sprite_dots = 0;
+}
+
+bool fifo_renderer::done()
+{
+    return lx == 160;
+}
+
+std::uint16_t fifo_renderer::step()
+{
+    if (sprite_fetch >= 0)
+    {
+        // background fetcher and shifter are both held during a sprite fetch
+        if (--sprite_dots == 0)
+        {
+            load_sprite(sprite_fetch);
+            fetched[sprite_fetch] = true;
+            sprite_fetch = -1;
+        }
+        return 1;
+    }
+    if (startup > 0)
+    {
+        --startup;
+        return 1;
+    }
+
+    std::uint8_t lcdc = gb_bus->read(0xff40);
+    if (!in_window && (lcdc & (1 << 5)))
+    {
+        std::uint8_t wy = gb_bus->read(0xff4a);
+        std::uint8_t wx = gb_bus->read(0xff4b);
+        if (ly >= wy && lx + 7 >= wx)
+        {
+            // restart the fetcher on the window's tile map
+            in_window = true;
+            window_drawn = true;
+            bg_size = 0;
+            fetch_step = 0;
+            fetch_x = 0;
+            discard = wx < 7 ? 7 - wx : 0;
+        }
+    }
+
+    if ((lcdc & (1 << 1)) && discard == 0)
+    {
+        for (std::uint8_t i = 0; i < sprites.size(); ++i)
+        {
+            if (fetched[i] || sprites[i].x > lx + 8)
+            {
+                continue;
+            }
+            // the fetcher gets as far as its last VRAM read and the FIFO
+            // must hold pixels to mix with before the sprite is fetched;
+            // that wait plus the fetch itself costs 6 to 11 dots
+            if (fetch_step < 5 || bg_size == 0)
+            {
+                fetch_background();
+                return 1;
+            }
+            sprite_fetch = i;
+            sprite_dots = 5;
+            return 1;
+        }
+    }
+
+    shift_pixel();
+    fetch_background();
+    return 1;
+}
+
+void fifo_renderer::fetch_background()
+{
+    bool cgb = gb_bus->is_cgb();
+    std::uint8_t lcdc = gb_bus->read(0xff40);
+    switch (fetch_step)
+    {
+    case 1:
+    {
+        std::uint16_t map_address;
+        if (in_window)
+        {
+            std::uint16_t tilemap_address = (lcdc & (1 << 6)) ? 0x9c00 : 0x9800;
+            map_address = tilemap_address + (window_line / 8) * 32 + (fetch_x & 0x1f);
+            tile_row = window_line % 8;
+        }
+        else
+        {
+            std::uint8_t scy = gb_bus->read(0xff42);
+            std::uint8_t scx = gb_bus->read(0xff43);
+            std::uint8_t y = scy + ly;
+            std::uint16_t tilemap_address = (lcdc & (1 << 3)) ? 0x9c00 : 0x9800;
+            map_address = tilemap_address + (y / 8) * 32 + (((scx / 8) + fetch_x) & 0x1f);
+            tile_row = y % 8;
+        }
+        tile_index = gb_bus->read_vram(0, map_address);
+        // CGB: palette 0-2, VRAM bank 3, x flip 5, y flip 6, priority 7
+        attributes = cgb ? gb_bus->read_vram(1, map_address) : 0;
+        break;
+    }
+    case 3:
+    case 5:
+    {
+        std::uint8_t row = (attributes & (1 << 6)) ? 7 - tile_row : tile_row;
+        std::uint16_t pixel_address = (lcdc & (1 << 4)) ? 0x8000 + tile_index * 16
+                                                         : 0x9000 + static_cast<std::int8_t>(tile_index) * 16;
+        pixel_address += row * 2;
+        std::uint8_t bank = (attributes >> 3) & 1;
+        if (fetch_step == 3)
+        {
+            tile_low = gb_bus->read_vram(bank, pixel_address);
+        }
+        else
+        {
+            tile_high = gb_bus->read_vram(bank, pixel_address + 1);
+        }
+        break;
+    }
+    case 6:
+        if (bg_size != 0)
+        {
+            return;
+        }
+        for (std::uint8_t i = 0; i < 8; ++i)
+        {
+            int bit = (attributes & (1 << 5)) ? i : 7 - i;
+            std::uint8_t color = (((tile_high >> bit) & 1) << 1) | ((tile_low >> bit) & 1);
+            bg_fifo[i] = {color, static_cast<std::uint8_t>(attributes & 0x07), (attributes & (1 << 7)) != 0};
+        }
+        bg_size = 8;
+        fetch_step = 0;
+        ++fetch_x;
+        return;
+    }
+    ++fetch_step;
+}
+
+void fifo_renderer::load_sprite(std::uint8_t index)
+{
+    const sprite &obj = sprites[index];
+    bool cgb = gb_bus->is_cgb();
+    std::uint8_t lcdc = gb_bus->read(0xff40);
+    std::uint8_t sprite_height = (lcdc & (1 << 2)) ? 16 : 8;
+    std::uint8_t row = (ly + 16) - obj.y;
+    if (obj.flags & (1 << 6))
+    {
+        row = (sprite_height - 1) - row;
+    }
+    std::uint8_t tile = sprite_height == 16 ? obj.tile & 0xfe : obj.tile;
+    std::uint8_t bank = cgb ? (obj.flags >> 3) & 1 : 0;
+    std::uint16_t pixel_address = 0x8000 + tile * 16 + row * 2;
+    std::uint8_t low = gb_bus->read_vram(bank, pixel_address);
+    std::uint8_t high = gb_bus->read_vram(bank, pixel_address + 1);
+
+    // columns already left of the shifter (sprites hanging off the left edge)
+    std::uint8_t skip = lx + 8 - obj.x;
+    for (std::uint8_t i = skip; i < 8; ++i)
+    {
+        std::uint8_t slot = i - skip;
+        if (slot >= obj_size)
+        {
+            obj_fifo[slot] = {0, 0, false, 0};
+            obj_size = slot + 1;
+        }
+        int bit = (obj.flags & (1 << 5)) ? i : 7 - i;
+        std::uint8_t color = (((high >> bit) & 1) << 1) | ((low >> bit) & 1);
+        obj_pixel &pixel = obj_fifo[slot];
+        // DMG: the sprite fetched first (leftmost) keeps the pixel;
+        // CGB: the lower OAM index does
+        if (color != 0 && (pixel.color == 0 || (cgb && index < pixel.oam_index)))
+        {
+            std::uint8_t palette = cgb ? obj.flags & 0x07 : (obj.flags >> 4) & 1;
+            pixel = {color, palette, (obj.flags & (1 << 7)) != 0, index};
+        }
+    }
+}
+
+void fifo_renderer::shift_pixel()
+{
+    if (bg_size == 0)
+    {
+        return;
+    }
+    bg_pixel bg = bg_fifo[0];
+    std::copy(bg_fifo.begin() + 1, bg_fifo.begin() + bg_size, bg_fifo.begin());
+    --bg_size;
+    obj_pixel obj = {0, 0, false, 0};
+    if (obj_size != 0)
+    {
+        obj = obj_fifo[0];
+        std::copy(obj_fifo.begin() + 1, obj_fifo.begin() + obj_size, obj_fifo.begin());
+        --obj_size;
+    }
+    if (discard > 0)
+    {
+        --discard;
+        return;
+    }
+
+    bool cgb = gb_bus->is_cgb();
+    std::uint8_t lcdc = gb_bus->read(0xff40);
+    std::uint8_t bg_color = bg.color;
+    std::uint16_t color;
+    // on CGB, LCDC bit 0 only takes priority away from the background
+    if (!cgb && !(lcdc & (1 << 0)))
+    {
+        bg_color = 0;
+        color = dmg_colors[0];
+    }
+    else
+    {
+        color = cgb ? gb_bus->bg_color(bg.palette, bg_color)
+                    : dmg_colors[(gb_bus->read(0xff47) >> (bg_color * 2)) & 0x03];
+    }
+    if (obj.color != 0 && (lcdc & (1 << 1)))
+    {
+        bool bg_over_obj = cgb ? (lcdc & (1 << 0)) && (obj.behind_bg || bg.priority) : obj.behind_bg;
+        if (!bg_over_obj || bg_color == 0)
+        {
+            color = cgb ? gb_bus->obj_color(obj.palette, obj.color)
+                        : dmg_colors[(gb_bus->read(obj.palette ? 0xff49 : 0xff48) >> (obj.color * 2)) & 0x03];
+        }
+    }
+    line[lx] = color;
+    if (++lx == 160 && window_drawn)
+    {
+        ++window_line;
+    }
+}
@@ -0,0 +1,275 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gameboy.h"
+
+gameboy::gameboy()
+    : memory(std::make_unique<memory_arena>()), gb_cpu(state.cpu), gb_timer(state.timer), gb_serial(state.serial),
+      gb_bus(state.bus, state.io_registers, *memory), gb_ppu(state.ppu)
+{
+    input = nullptr;
+    frame_paused = false;
+    paused_frame = 0;
+#ifdef GB_DEBUGGER
+    breakpoints = nullptr;
+#endif
+}
+
+bool gameboy::load_boot_rom(std::string path)
+{
+    return gb_bus.load_boot_rom(path);
+}
+
+void gameboy::load_rom(std::string path)
+{
+    gb_bus.load_rom(path);
+    connect();
+    gb_cpu.power_on();
+}
+
+bool gameboy::finish_boot(std::uint64_t limit)
+{
+    std::uint64_t until = get_cycle_count() + limit;
+    while (gb_bus.boot_rom_mapped() && get_cycle_count() < until)
+    {
+        clock();
+    }
+    return !gb_bus.boot_rom_mapped();
+}
+
+std::unique_ptr<gameboy> gameboy::boot_snapshot(std::string boot_path, std::string rom_path)
+{
+    std::unique_ptr<gameboy> snapshot = std::make_unique<gameboy>();
+    if (!snapshot->load_boot_rom(boot_path))
+    {
+        return nullptr;
+    }
+    snapshot->load_rom(rom_path);
+    if (!snapshot->finish_boot())
+    {
+        return nullptr;
+    }
+    return snapshot;
+}
+
+void gameboy::connect()
+{
+    bus *b = &gb_bus;
+    gb_cpu.connect_bus(b);
+    gb_ppu.connect_bus(b);
+    gb_timer.connect_bus(b);
+    gb_serial.connect_bus(b);
+    gb_bus.connect_serial(&gb_serial);
+    gb_apu.connect_cpu(&gb_cpu);
+    gb_bus.connect_apu(&gb_apu);
+    gb_bus.connect_cpu(&gb_cpu);
+}
+
+std::vector<std::unique_ptr<gameboy>> gameboy::fork(size_t count)
+{
+    std::vector<std::unique_ptr<gameboy>> children;
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::unique_ptr<gameboy> child = std::make_unique<gameboy>();
+        child->restore(*this);
+        children.push_back(std::move(child));
+    }
+    return children;
+}
+
+void gameboy::restore(const gameboy &source)
+{
+    // The views stay on this instance's storage, so copying the storage
+    // copies cpu, timer and most of the rest; the components copy what they
+    // hold besides, and nothing they are connected to.
+    state = source.state;
+    *memory = *source.memory;
+    gb_bus = source.gb_bus;
+    gb_bus.clear_watchpoints();
+    gb_ppu = source.gb_ppu;
+    gb_serial = source.gb_serial;
+    connect();
+    // after connect(): attaching the CPU restarts the APU clock
+    gb_apu = source.gb_apu;
+    frame_paused = source.frame_paused;
+    paused_frame = source.paused_frame;
+    if (input != nullptr)
+    {
+        input->restart();
+    }
+}
+
+void gameboy::reset()
+{
+    // the bus first: the CPU's registers depend on the boot ROM being mapped,
+    // and the APU restarts from the CPU's timestamp
+    gb_bus.reset();
+    gb_cpu.reset();
+    gb_ppu.reset();
+    gb_timer.reset();
+    gb_serial.reset();
+    gb_apu.reset();
+    frame_paused = false;
+    paused_frame = 0;
+    if (input != nullptr)
+    {
+        input->restart();
+    }
+}
+
+template <std::uint8_t flags>
+void gameboy::clock()
+{
+#ifdef GB_DEBUGGER
+    if constexpr ((flags & instrumentation::debug) != 0)
+    {
+        // before anything ticks, so resuming loses no time
+        if (gb_cpu.at_instruction_boundary() &&
+            breakpoints->stop(gb_cpu.get_pc(), gb_bus.current_rom_bank(gb_cpu.get_pc())))
+        {
+            return;
+        }
+    }
+#endif
+    // The per-tick checks read the hot state directly rather than through
+    // the views, and skip the calls that would do nothing.
+    if (input != nullptr && input->due(state.cpu.timestamp))
+    {
+        poll_input();
+    }
+    if ((state.bus.ie_register & state.io_registers[0x0f]) != 0)
+    {
+        gb_cpu.handle_interrupt();
+    }
+    gb_ppu.clock();
+    gb_timer.clock();
+    gb_serial.clock();
+    if (state.cpu.speed == 2)
+    {
+        // DIV and the serial shift clock run at the CPU clock; the PPU and
+        // everything else stay at 4 MHz
+        gb_timer.clock();
+        gb_serial.clock();
+    }
+    if (state.bus.dma_cycle != 0)
+    {
+        gb_bus.dma_clock();
+    }
+    gb_cpu.clock<flags>();
+}
+
+template <std::uint8_t flags>
+bool gameboy::interrupted()
+{
+#ifdef GB_DEBUGGER
+    if constexpr ((flags & instrumentation::debug) != 0)
+    {
+        if (breakpoints->is_stopped())
+        {
+            return true;
+        }
+    }
+#endif
+    return gb_bus.paused();
+}
+
+template <std::uint8_t flags>
+void gameboy::run_frame()
+{
+    std::uint64_t frame = frame_paused ? paused_frame : gb_ppu.get_frame_count();
+    frame_paused = false;
+    gb_bus.resume();
+    if (!gb_bus.watching() && (flags & instrumentation::debug) == 0)
+    {
+        while (state.ppu.frame_count == frame)
+        {
+            clock<flags>();
+        }
+    }
+    else
+    {
+        while (state.ppu.frame_count == frame)
+        {
+            clock<flags>();
+            if (interrupted<flags>())
+            {
+                frame_paused = true;
+                paused_frame = frame;
+                return;
+            }
+        }
+    }
+    gb_apu.end_frame();
+}
+
+// Slices are shorter than one bit of a serial transfer, so neither side can
+// run ahead of a byte the other is about to send.
+static constexpr std::uint64_t link_slice = 456;
+
+void gameboy::run_linked_frame(gameboy &peer)
+{
+    std::uint64_t frame = gb_ppu.get_frame_count();
+    while (state.ppu.frame_count == frame)
+    {
+        std::uint64_t until = get_cycle_count() + link_slice;
+        while (get_cycle_count() < until)
+        {
+            clock();
+        }
+        until = peer.get_cycle_count() + link_slice;
+        while (peer.get_cycle_count() < until)
+        {
+            peer.clock();
+        }
+    }
+    gb_apu.end_frame();
+    peer.gb_apu.end_frame();
+}
+
+template void gameboy::clock<instrumentation::none>();
+template void gameboy::clock<instrumentation::profile>();
+template void gameboy::clock<instrumentation::trace>();
+template void gameboy::clock<instrumentation::profile | instrumentation::trace>();
+template void gameboy::clock<instrumentation::trace | instrumentation::compare>();
+template void gameboy::clock<instrumentation::profile | instrumentation::trace | instrumentation::compare>();
+template void gameboy::run_frame<instrumentation::none>();
+template void gameboy::run_frame<instrumentation::profile>();
+template void gameboy::run_frame<instrumentation::trace>();
+template void gameboy::run_frame<instrumentation::profile | instrumentation::trace>();
+template void gameboy::run_frame<instrumentation::trace | instrumentation::compare>();
+template void gameboy::run_frame<instrumentation::profile | instrumentation::trace | instrumentation::compare>();
+#ifdef GB_DEBUGGER
+template void gameboy::clock<instrumentation::debug>();
+template void gameboy::run_frame<instrumentation::debug>();
+#endif
+
+void gameboy::set_buttons(std::uint8_t mask)
+{
+    gb_bus.set_buttons(mask);
+}
+
+void gameboy::connect_input(input_queue *q)
+{
+    input = q;
+}
+
+void gameboy::poll_input()
+{
+    if (input == nullptr)
+    {
+        return;
+    }
+    std::uint64_t now = gb_cpu.get_timestamp();
+    std::uint8_t mask;
+    while (input->pop(now, mask))
+    {
+        gb_bus.set_buttons(mask);
+    }
+}
+
+std::uint64_t gameboy::get_cycle_count()
+{
+    return state.cpu.timestamp;
+}
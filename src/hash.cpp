@@ -0,0 +1,100 @@
+#include <cstdint>
+#include <cstring>
+
+#include "hash.h"
+
+static constexpr std::uint64_t prime_1 = 0x9e3779b185ebca87ull;
+static constexpr std::uint64_t prime_2 = 0xc2b2ae3d27d4eb4full;
+static constexpr std::uint64_t prime_3 = 0x165667b19e3779f9ull;
+static constexpr std::uint64_t prime_4 = 0x85ebca77c2b2ae63ull;
+static constexpr std::uint64_t prime_5 = 0x27d4eb2f165667c5ull;
+
+static inline std::uint64_t rotate_left(std::uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline std::uint64_t read_64(const std::uint8_t *p)
+{
+    std::uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline std::uint32_t read_32(const std::uint8_t *p)
+{
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline std::uint64_t lane_round(std::uint64_t accumulator, std::uint64_t input)
+{
+    accumulator += input * prime_2;
+    accumulator = rotate_left(accumulator, 31);
+    return accumulator * prime_1;
+}
+
+static inline std::uint64_t merge_round(std::uint64_t accumulator, std::uint64_t lane)
+{
+    accumulator ^= lane_round(0, lane);
+    return accumulator * prime_1 + prime_4;
+}
+
+std::uint64_t xxh64(const void *data, size_t length, std::uint64_t seed)
+{
+    const std::uint8_t *p = static_cast<const std::uint8_t *>(data);
+    const std::uint8_t *end = p + length;
+    std::uint64_t hash;
+
+    if (length >= 32)
+    {
+        std::uint64_t lane_1 = seed + prime_1 + prime_2;
+        std::uint64_t lane_2 = seed + prime_2;
+        std::uint64_t lane_3 = seed;
+        std::uint64_t lane_4 = seed - prime_1;
+        const std::uint8_t *limit = end - 32;
+        do
+        {
+            lane_1 = lane_round(lane_1, read_64(p));
+            lane_2 = lane_round(lane_2, read_64(p + 8));
+            lane_3 = lane_round(lane_3, read_64(p + 16));
+            lane_4 = lane_round(lane_4, read_64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        hash = rotate_left(lane_1, 1) + rotate_left(lane_2, 7) + rotate_left(lane_3, 12) + rotate_left(lane_4, 18);
+        hash = merge_round(hash, lane_1);
+        hash = merge_round(hash, lane_2);
+        hash = merge_round(hash, lane_3);
+        hash = merge_round(hash, lane_4);
+    }
+    else
+    {
+        hash = seed + prime_5;
+    }
+    hash += length;
+
+    for (; p + 8 <= end; p += 8)
+    {
+        hash ^= lane_round(0, read_64(p));
+        hash = rotate_left(hash, 27) * prime_1 + prime_4;
+    }
+    if (p + 4 <= end)
+    {
+        hash ^= read_32(p) * prime_1;
+        hash = rotate_left(hash, 23) * prime_2 + prime_3;
+        p += 4;
+    }
+    for (; p < end; ++p)
+    {
+        hash ^= *p * prime_5;
+        hash = rotate_left(hash, 11) * prime_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime_2;
+    hash ^= hash >> 29;
+    hash *= prime_3;
+    hash ^= hash >> 32;
+    return hash;
+}
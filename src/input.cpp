@@ -0,0 +1,46 @@
+#include <cstdint>
+
+#include "input.h"
+
+// T-cycles between looks at an empty queue: one scanline, about 109 us
+static constexpr std::uint64_t poll_interval = 456;
+
+input_queue::input_queue(size_t capacity) : events(capacity)
+{
+    pending = {0, 0};
+    has_pending = false;
+    next_check = 0;
+}
+
+bool input_queue::push(std::uint64_t timestamp, std::uint8_t mask)
+{
+    input_event event = {timestamp, mask};
+    return events.push(&event, 1) == 1;
+}
+
+bool input_queue::pop(std::uint64_t now, std::uint8_t &mask)
+{
+    if (!has_pending)
+    {
+        if (events.pop(&pending, 1) == 0)
+        {
+            next_check = now + poll_interval;
+            return false;
+        }
+        has_pending = true;
+    }
+    if (pending.timestamp > now)
+    {
+        next_check = pending.timestamp;
+        return false;
+    }
+    has_pending = false;
+    mask = pending.mask;
+    return true;
+}
+
+void input_queue::restart()
+{
+    next_check = 0;
+    pending.timestamp = 0;
+}
@@ -2,140 +2,440 @@
 #include <fstream>
 #include <chrono>
 #include <thread>
+#include <string>
+#include <cstdlib>
+#include <memory>
+#include <array>
 #include <SDL.h>
 
-#include "cpu.h"
-#include "bus.h"
-#include "timer.h"
-#include "ppu.h"
+#include "gameboy.h"
+#include "profiler.h"
+#include "trace.h"
+#include "audio.h"
+#include "rate_control.h"
+#include "capture.h"
+#include "movie.h"
 
-int main(int argc, char *argv[])
+// Held keys as a gameboy::set_buttons mask.
+static std::uint8_t keyboard_buttons()
 {
-    if (argc != 2)
+    // A, B, Select, Start, Right, Left, Up, Down
+    static constexpr std::array<SDL_Scancode, 8> keys = {SDL_SCANCODE_S,  SDL_SCANCODE_A,     SDL_SCANCODE_Y,
+                                                         SDL_SCANCODE_X,  SDL_SCANCODE_RIGHT, SDL_SCANCODE_LEFT,
+                                                         SDL_SCANCODE_UP, SDL_SCANCODE_DOWN};
+    const Uint8 *key_states = SDL_GetKeyboardState(NULL);
+    std::uint8_t mask = 0;
+    for (size_t i = 0; i < keys.size(); ++i)
     {
-        std::cerr << "A ROM file is required!" << std::endl;
-        return 1;
+        if (key_states[keys[i]])
+        {
+            mask |= 1 << i;
+        }
     }
+    return mask;
+}
 
-    cpu gb_cpu = cpu();
-    ppu gb_ppu = ppu();
-    bus gb_bus = bus();
-    timer gb_timer = timer();
-    gb_bus.load_rom(argv[1]);
-    bus *b = &gb_bus;
-    gb_cpu.connect_bus(b);
-    gb_ppu.connect_bus(b);
-    gb_timer.connect_bus(b);
+// SDL event watch: queues the held buttons whenever a key goes up or down.
+static int queue_buttons(void *userdata, SDL_Event *event)
+{
+    if ((event->type == SDL_KEYDOWN || event->type == SDL_KEYUP) && !event->key.repeat)
+    {
+        static_cast<input_queue *>(userdata)->push(0, keyboard_buttons());
+    }
+    return 0;
+}
 
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) != 0)
+static bool poll_sdl(gameboy &gb)
+{
+    SDL_Event event;
+    while (SDL_PollEvent(&event))
     {
-        SDL_Log("Unable to initialize SDL: %s", SDL_GetError());
-        return 1;
+        if (event.type == SDL_QUIT)
+        {
+            return true;
+        }
+        if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_P && gb.gb_cpu.profiler != nullptr)
+        {
+            gb.gb_cpu.profiler->dump(std::cerr);
+        }
     }
-    SDL_Window *window = SDL_CreateWindow("gb_emulator", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
-                                          160 * 2, 144 * 2, SDL_WINDOW_SHOWN);
-    SDL_Renderer *renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-    SDL_Texture *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
-                                             160, 144);
-    gb_ppu.window = window;
-    gb_ppu.renderer = renderer;
-    gb_ppu.texture = texture;
+    return false;
+}
 
-    std::uint32_t control_counter = 0;
+template <std::uint8_t flags = instrumentation::none>
+static void run(gameboy &gb, bool headless, rate_control &pacer, movie *recording, movie *replay)
+{
     bool quit = false;
-    while (!quit)
+    for (std::uint32_t frame = 0; !quit; ++frame)
     {
-        ++control_counter;
-        if (control_counter == 69905)
+        if (replay != nullptr)
         {
-            control_counter = 0;
-            const Uint8 *key_states = SDL_GetKeyboardState(NULL);
-
-            if (key_states[SDL_SCANCODE_RIGHT])
-            {
-                gb_bus.set_direction_button(0, 1);
-            }
-            if (key_states[SDL_SCANCODE_LEFT])
-            {
-                gb_bus.set_direction_button(1, 1);
-            }
-            if (key_states[SDL_SCANCODE_UP])
+            if (replay->finished(frame))
             {
-                gb_bus.set_direction_button(2, 1);
-            }
-            if (key_states[SDL_SCANCODE_DOWN])
-            {
-                gb_bus.set_direction_button(3, 1);
-            }
-            if (!key_states[SDL_SCANCODE_RIGHT])
-            {
-                gb_bus.set_direction_button(0, 0);
-            }
-            if (!key_states[SDL_SCANCODE_LEFT])
-            {
-                gb_bus.set_direction_button(1, 0);
-            }
-            if (!key_states[SDL_SCANCODE_UP])
-            {
-                gb_bus.set_direction_button(2, 0);
-            }
-            if (!key_states[SDL_SCANCODE_DOWN])
-            {
-                gb_bus.set_direction_button(3, 0);
+                break;
             }
+            gb.set_buttons(replay->play(frame));
+        }
+        if (recording != nullptr)
+        {
+            // keys are only queued between frames; taking them here lines
+            // them up with the frame a replay will apply them on
+            gb.poll_input();
+            recording->record(frame, gb.gb_bus.get_buttons());
+        }
+        gb.run_frame<flags>();
+        if (!headless)
+        {
+            quit = poll_sdl(gb);
+        }
+        if constexpr ((flags & instrumentation::compare) != 0)
+        {
+            quit = quit || gb.gb_cpu.comparator->finished();
+        }
+        pacer.frame_done();
+    }
+}
 
-            if (key_states[SDL_SCANCODE_S])
-            {
-                gb_bus.set_action_button(0, 1);
-            }
-            if (key_states[SDL_SCANCODE_A])
-            {
-                gb_bus.set_action_button(1, 1);
-            }
-            if (key_states[SDL_SCANCODE_Y])
-            {
-                gb_bus.set_action_button(2, 1);
-            }
-            if (key_states[SDL_SCANCODE_X])
-            {
-                gb_bus.set_action_button(3, 1);
-            }
-            if (!key_states[SDL_SCANCODE_S])
-            {
-                gb_bus.set_action_button(0, 0);
-            }
-            if (!key_states[SDL_SCANCODE_A])
-            {
-                gb_bus.set_action_button(1, 0);
-            }
-            if (!key_states[SDL_SCANCODE_Y])
-            {
-                gb_bus.set_action_button(2, 0);
-            }
-            if (!key_states[SDL_SCANCODE_X])
-            {
-                gb_bus.set_action_button(3, 0);
-            }
+static void run_instrumented(gameboy &gb, bool headless, rate_control &pacer, movie *recording, movie *replay,
+                             std::uint8_t flags)
+{
+    switch (flags)
+    {
+    case instrumentation::none:
+        run<instrumentation::none>(gb, headless, pacer, recording, replay);
+        break;
+    case instrumentation::profile:
+        run<instrumentation::profile>(gb, headless, pacer, recording, replay);
+        break;
+    case instrumentation::trace:
+        run<instrumentation::trace>(gb, headless, pacer, recording, replay);
+        break;
+    case instrumentation::profile | instrumentation::trace:
+        run<instrumentation::profile | instrumentation::trace>(gb, headless, pacer, recording, replay);
+        break;
+    case instrumentation::trace | instrumentation::compare:
+        run<instrumentation::trace | instrumentation::compare>(gb, headless, pacer, recording, replay);
+        break;
+    case instrumentation::profile | instrumentation::trace | instrumentation::compare:
+        run<instrumentation::profile | instrumentation::trace | instrumentation::compare>(gb, headless, pacer,
+                                                                                          recording, replay);
+        break;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "A ROM file is required!" << std::endl;
+        return 1;
+    }
 
-            SDL_Event event;
-            while (SDL_PollEvent(&event))
+    bool headless = false;
+    bool fuse = false;
+    std::string profile_path;
+    std::uint64_t trace_length = 0;
+    std::string trace_path = "gb_trace.bin";
+    std::string compare_path;
+    std::string link_path;
+    std::string sync_mode;
+    std::string ppu_backend;
+    std::string render;
+    std::string capture_path;
+    std::string record_path;
+    std::string replay_path;
+    std::uint64_t ram_seed = 0;
+    std::string boot_path;
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--headless")
+        {
+            headless = true;
+        }
+        else if (arg == "--fuse")
+        {
+            fuse = true;
+        }
+        else if (arg == "--profile")
+        {
+            profile_path = "-";
+            if (i + 1 < argc && argv[i + 1][0] != '-')
             {
-                if (event.type == SDL_QUIT)
-                {
-                    quit = true;
-                    break;
-                }
+                profile_path = argv[++i];
             }
         }
+        else if (arg == "--trace" && i + 1 < argc)
+        {
+            trace_length = std::stod(argv[++i]) * 1000000;
+        }
+        else if (arg == "--trace-file" && i + 1 < argc)
+        {
+            trace_path = argv[++i];
+        }
+        else if (arg == "--compare-trace" && i + 1 < argc)
+        {
+            compare_path = argv[++i];
+        }
+        else if (arg == "--link" && i + 1 < argc)
+        {
+            link_path = argv[++i];
+        }
+        else if (arg == "--sync" && i + 1 < argc)
+        {
+            sync_mode = argv[++i];
+        }
+        else if (arg == "--ppu" && i + 1 < argc)
+        {
+            ppu_backend = argv[++i];
+        }
+        else if (arg == "--render" && i + 1 < argc)
+        {
+            render = argv[++i];
+        }
+        else if (arg == "--capture" && i + 1 < argc)
+        {
+            capture_path = argv[++i];
+        }
+        else if (arg == "--record" && i + 1 < argc)
+        {
+            record_path = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc)
+        {
+            replay_path = argv[++i];
+        }
+        else if (arg == "--ram-seed" && i + 1 < argc)
+        {
+            ram_seed = std::stoull(argv[++i], nullptr, 0);
+        }
+        else if (arg == "--boot-rom" && i + 1 < argc)
+        {
+            boot_path = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    gameboy gb;
+    if (!boot_path.empty() && !gb.load_boot_rom(boot_path))
+    {
+        std::cerr << "Unable to read boot ROM " << boot_path << std::endl;
+        return 1;
+    }
+    gb.load_rom(argv[1]);
+    gb.gb_cpu.fusion = fuse;
+    if (ppu_backend == "fifo")
+    {
+        gb.gb_ppu.set_backend(ppu::backend::fifo);
+    }
+    else if (!ppu_backend.empty() && ppu_backend != "scanline")
+    {
+        std::cerr << "Unknown PPU backend " << ppu_backend << std::endl;
+        return 1;
+    }
+    if (render == "off")
+    {
+        gb.gb_ppu.set_render_mode(ppu::render_mode::off);
+    }
+    else if (!render.empty() && render != "full")
+    {
+        std::uint32_t interval = std::strtoul(render.c_str(), nullptr, 10);
+        if (interval == 0)
+        {
+            std::cerr << "Unknown render mode " << render << std::endl;
+            return 1;
+        }
+        gb.gb_ppu.set_render_mode(ppu::render_mode::every_nth, interval);
+    }
+
+    // a movie has to start from power-on, before anything else touches the core
+    movie recording;
+    movie replay;
+    if (!replay_path.empty())
+    {
+        if (!link_path.empty())
+        {
+            std::cerr << "--replay cannot be combined with --link" << std::endl;
+            return 1;
+        }
+        if (!replay.load(replay_path))
+        {
+            std::cerr << "Unable to read movie " << replay_path << std::endl;
+            return 1;
+        }
+        if (!replay.begin_replay(gb))
+        {
+            std::cerr << "Movie " << replay_path << " was recorded with a different ROM" << std::endl;
+            return 1;
+        }
+    }
+    else if (!record_path.empty())
+    {
+        recording.begin_recording(gb, ram_seed);
+    }
+    else
+    {
+        gb.gb_bus.randomize_ram(ram_seed);
+    }
+
+    std::unique_ptr<socket_serial> link;
+    if (!link_path.empty())
+    {
+        int fd = open_link_socket(link_path);
+        if (fd < 0)
+        {
+            std::cerr << "Unable to open link socket " << link_path << std::endl;
+            return 1;
+        }
+        link = std::make_unique<socket_serial>(fd);
+        gb.gb_serial.connect(link.get());
+    }
+
+    video_capture capture;
+    if (!capture_path.empty())
+    {
+        bool y4m = capture_path.size() >= 4 && capture_path.substr(capture_path.size() - 4) == ".y4m";
+        if (!capture.open(capture_path, y4m ? video_capture::format::y4m : video_capture::format::raw,
+                          gb.gb_bus.is_cgb()))
+        {
+            std::cerr << "Unable to open capture file " << capture_path << std::endl;
+            return 1;
+        }
+        gb.gb_ppu.connect_sink(&capture);
+    }
+
+    sdl_audio_sink audio;
+    input_queue keys;
+    if (!headless)
+    {
+        if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_EVENTS) != 0)
+        {
+            SDL_Log("Unable to initialize SDL: %s", SDL_GetError());
+            return 1;
+        }
+        SDL_Window *window = SDL_CreateWindow("gb_emulator", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                                              160 * 2, 144 * 2, SDL_WINDOW_SHOWN);
+        SDL_Renderer *renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+        SDL_Texture *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGB555, SDL_TEXTUREACCESS_STREAMING,
+                                                 160, 144);
+        gb.gb_ppu.window = window;
+        gb.gb_ppu.renderer = renderer;
+        gb.gb_ppu.texture = texture;
+        if (replay_path.empty())
+        {
+            SDL_AddEventWatch(queue_buttons, &keys);
+            gb.connect_input(&keys);
+        }
+        if (audio.open(48000))
+        {
+            gb.gb_apu.connect(&audio);
+        }
+        else
+        {
+            SDL_Log("Unable to open audio device: %s", SDL_GetError());
+        }
+    }
 
-        gb_cpu.handle_interrupt();
-        gb_ppu.clock();
-        gb_timer.clock();
-        gb_bus.dma_clock();
-        gb_cpu.clock();
+    std::uint8_t flags = instrumentation::none;
+    opcode_profiler profiler;
+    if (!profile_path.empty())
+    {
+        profiler.attach(gb);
+        flags |= instrumentation::profile;
+    }
+    if (!compare_path.empty() && trace_length == 0)
+    {
+        trace_length = 1 << 16; // history for the mismatch report
+    }
+    trace_buffer tracer(trace_length > 0 ? trace_length : 1);
+    if (trace_length > 0)
+    {
+        gb.gb_cpu.tracer = &tracer;
+        install_trace_signal_handlers(&tracer, trace_path);
+        flags |= instrumentation::trace;
+    }
+    trace_comparator comparator(&tracer);
+    if (!compare_path.empty())
+    {
+        if (!comparator.open(compare_path))
+        {
+            std::cerr << "Unable to open reference trace " << compare_path << std::endl;
+            return 1;
+        }
+        gb.gb_cpu.comparator = &comparator;
+        flags |= instrumentation::compare;
     }
 
-    SDL_Quit();
+    rate_control::sync sync = headless ? rate_control::sync::none : rate_control::sync::video;
+    if (sync_mode == "audio")
+    {
+        sync = rate_control::sync::audio;
+    }
+    else if (sync_mode == "video")
+    {
+        sync = rate_control::sync::video;
+    }
+    else if (sync_mode == "none")
+    {
+        sync = rate_control::sync::none;
+    }
+    else if (!sync_mode.empty())
+    {
+        std::cerr << "Unknown sync mode " << sync_mode << std::endl;
+        return 1;
+    }
+    rate_control pacer(sync, &gb.gb_apu, &audio);
 
+    run_instrumented(gb, headless, pacer, record_path.empty() ? nullptr : &recording,
+                     replay_path.empty() ? nullptr : &replay, flags);
+
+    if (!record_path.empty() && !recording.save(record_path))
+    {
+        std::cerr << "Unable to write movie " << record_path << std::endl;
+    }
+    if (!replay_path.empty())
+    {
+        std::cerr << "replayed " << gb.gb_ppu.get_frame_count() << " frames, frame hash " << std::hex
+                  << gb.gb_ppu.get_frame_hash() << std::dec << std::endl;
+    }
+
+    if (!profile_path.empty())
+    {
+        if (profile_path == "-")
+        {
+            profiler.dump(std::cerr);
+        }
+        else
+        {
+            std::ofstream profile_file(profile_path);
+            profiler.dump(profile_file);
+        }
+    }
+
+    if (!headless)
+    {
+        SDL_Quit();
+    }
+
+    if (!capture_path.empty())
+    {
+        capture.close();
+        std::cerr << "captured " << capture.written() << " frames to " << capture_path;
+        if (capture.dropped() != 0)
+        {
+            std::cerr << " (" << capture.dropped() << " dropped)";
+        }
+        std::cerr << std::endl;
+    }
+
+    if (!compare_path.empty())
+    {
+        std::cerr << "compared " << comparator.matched() << " instructions against " << compare_path << std::endl;
+        return comparator.mismatched() ? 2 : 0;
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,135 @@
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "movie.h"
+#include "gameboy.h"
+
+static std::uint16_t cartridge_checksum(gameboy &gb)
+{
+    return (gb.gb_bus.read(0x014e) << 8) | gb.gb_bus.read(0x014f);
+}
+
+movie::movie()
+{
+    rom_checksum = 0;
+    ram_seed = 0;
+    length = 0;
+    cursor = 0;
+}
+
+void movie::begin_recording(gameboy &gb, std::uint64_t seed)
+{
+    changes.clear();
+    rom_checksum = cartridge_checksum(gb);
+    ram_seed = seed;
+    length = 0;
+    gb.gb_bus.randomize_ram(seed);
+}
+
+bool movie::begin_replay(gameboy &gb)
+{
+    if (cartridge_checksum(gb) != rom_checksum)
+    {
+        return false;
+    }
+    cursor = 0;
+    gb.gb_bus.randomize_ram(ram_seed);
+    return true;
+}
+
+void movie::record(std::uint32_t frame, std::uint8_t mask)
+{
+    std::uint8_t held = changes.empty() ? 0x00 : changes.back().mask;
+    if (mask != held)
+    {
+        changes.push_back({frame, mask});
+    }
+    length = frame + 1;
+}
+
+std::uint8_t movie::play(std::uint32_t frame)
+{
+    while (cursor < changes.size() && changes[cursor].frame <= frame)
+    {
+        ++cursor;
+    }
+    return cursor == 0 ? 0x00 : changes[cursor - 1].mask;
+}
+
+bool movie::finished(std::uint32_t frame)
+{
+    return frame >= length;
+}
+
+bool movie::save(const std::string &path)
+{
+    std::vector<std::uint8_t> body;
+    std::uint32_t previous = 0;
+    for (const change &c : changes)
+    {
+        std::uint32_t delta = c.frame - previous;
+        previous = c.frame;
+        do
+        {
+            body.push_back((delta & 0x7f) | (delta >= 0x80 ? 0x80 : 0x00));
+            delta >>= 7;
+        } while (delta != 0);
+        body.push_back(c.mask);
+    }
+
+    movie_header header;
+    header.magic = movie_magic;
+    header.version = 1;
+    header.rom_checksum = rom_checksum;
+    header.ram_seed = ram_seed;
+    header.frames = length;
+    header.changes = changes.size();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(body.data()), body.size());
+    return static_cast<bool>(out);
+}
+
+bool movie::load(const std::string &path)
+{
+    std::ifstream input(path, std::ios::binary);
+    movie_header header;
+    if (!input.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != movie_magic ||
+        header.version != 1)
+    {
+        return false;
+    }
+    std::vector<std::uint8_t> body(std::istreambuf_iterator<char>(input), {});
+
+    changes.clear();
+    size_t p = 0;
+    std::uint32_t frame = 0;
+    for (std::uint32_t i = 0; i < header.changes; ++i)
+    {
+        std::uint32_t delta = 0;
+        int shift = 0;
+        do
+        {
+            if (p >= body.size() || shift > 28)
+            {
+                return false;
+            }
+            delta |= (body[p] & 0x7f) << shift;
+            shift += 7;
+        } while (body[p++] & 0x80);
+        if (p >= body.size())
+        {
+            return false;
+        }
+        frame += delta;
+        changes.push_back({frame, body[p++]});
+    }
+    rom_checksum = header.rom_checksum;
+    ram_seed = header.ram_seed;
+    length = header.frames;
+    cursor = 0;
+    return true;
+}
@@ -0,0 +1,126 @@
+#include <cstdint>
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "profiler.h"
+#include "cpu.h"
+#include "gameboy.h"
+
+opcode_profiler::opcode_profiler()
+{
+    reset();
+}
+
+void opcode_profiler::attach(gameboy &gb)
+{
+    std::uint16_t n_banks = gb.gb_bus.rom_banks();
+    rom_pcs.assign(static_cast<size_t>(n_banks) * 0x4000, {});
+    banks.assign(n_banks, {});
+    gb.gb_cpu.profiler = this;
+}
+
+void opcode_profiler::reset()
+{
+    base_opcodes.fill({});
+    cb_opcodes.fill({});
+    ram_pcs.fill({});
+    std::fill(rom_pcs.begin(), rom_pcs.end(), counter{});
+    std::fill(banks.begin(), banks.end(), counter{});
+}
+
+void opcode_profiler::dump(std::ostream &out, size_t hot_pcs)
+{
+    std::uint64_t total_count = 0;
+    std::uint64_t total_cycles = 0;
+    for (size_t i = 0; i < 256; ++i)
+    {
+        total_count += base_opcodes[i].count + cb_opcodes[i].count;
+        total_cycles += base_opcodes[i].cycles + cb_opcodes[i].cycles;
+    }
+    auto percent = [&](std::uint64_t cycles)
+    { return total_cycles == 0 ? 0.0 : 100.0 * cycles / total_cycles; };
+
+    std::ios_base::fmtflags saved_flags = out.flags();
+    out << std::fixed << std::setprecision(2);
+    out << "instructions: " << total_count << ", cycles: " << total_cycles << "\n\n";
+
+    // (prefix, opcode, counter)
+    std::vector<std::tuple<bool, std::uint8_t, counter>> opcodes;
+    for (size_t i = 0; i < 256; ++i)
+    {
+        if (base_opcodes[i].count > 0)
+        {
+            opcodes.push_back({false, i, base_opcodes[i]});
+        }
+        if (cb_opcodes[i].count > 0)
+        {
+            opcodes.push_back({true, i, cb_opcodes[i]});
+        }
+    }
+    std::stable_sort(opcodes.begin(), opcodes.end(), [](auto &left, auto &right)
+                     { return std::get<2>(left).cycles > std::get<2>(right).cycles; });
+
+    out << "opcode   mnemonic           count           cycles   cycles%\n";
+    for (auto &[prefix, opcode, entry] : opcodes)
+    {
+        const opcode_info &info = prefix ? cb_opcode_table[opcode] : opcode_table[opcode];
+        out << (prefix ? "cb " : "   ") << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(opcode)
+            << std::dec << std::setfill(' ') << "    " << std::left << std::setw(14) << info.mnemonic << std::right
+            << std::setw(12) << entry.count << std::setw(17) << entry.cycles << std::setw(10) << percent(entry.cycles) << "\n";
+    }
+
+    out << "\nbank           count           cycles   cycles%\n";
+    for (size_t bank = 0; bank < banks.size(); ++bank)
+    {
+        if (banks[bank].count > 0)
+        {
+            out << std::hex << std::setw(4) << std::setfill('0') << bank << std::dec << std::setfill(' ')
+                << std::setw(16) << banks[bank].count << std::setw(17) << banks[bank].cycles
+                << std::setw(10) << percent(banks[bank].cycles) << "\n";
+        }
+    }
+
+    // (bank or -1 outside ROM, pc, counter)
+    std::vector<std::tuple<int, std::uint16_t, counter>> locations;
+    for (size_t index = 0; index < rom_pcs.size(); ++index)
+    {
+        if (rom_pcs[index].count > 0)
+        {
+            // listed at the address the bank normally runs from
+            int bank = index / 0x4000;
+            std::uint16_t pc = (bank == 0 ? 0x0000 : 0x4000) | (index & 0x3fff);
+            locations.push_back({bank, pc, rom_pcs[index]});
+        }
+    }
+    for (size_t index = 0; index < ram_pcs.size(); ++index)
+    {
+        if (ram_pcs[index].count > 0)
+        {
+            locations.push_back({-1, 0x8000 + index, ram_pcs[index]});
+        }
+    }
+    size_t n_hot = std::min(hot_pcs, locations.size());
+    std::partial_sort(locations.begin(), locations.begin() + n_hot, locations.end(), [](auto &left, auto &right)
+                      { return std::get<2>(left).cycles > std::get<2>(right).cycles; });
+
+    out << "\nhot pcs\nbank:pc           count           cycles   cycles%\n";
+    for (size_t i = 0; i < n_hot; ++i)
+    {
+        auto &[bank, pc, entry] = locations[i];
+        if (bank < 0)
+        {
+            out << "  --";
+        }
+        else
+        {
+            out << std::hex << std::setw(4) << std::setfill('0') << bank;
+        }
+        out << std::hex << ":" << std::setw(4) << std::setfill('0') << pc << std::dec << std::setfill(' ')
+            << std::setw(14) << entry.count << std::setw(17) << entry.cycles << std::setw(10) << percent(entry.cycles) << "\n";
+    }
+    out.flags(saved_flags);
+}
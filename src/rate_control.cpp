@@ -0,0 +1,96 @@
+#include <cstdint>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "rate_control.h"
+#include "apu.h"
+#include "audio.h"
+
+// 70224 T-cycles per frame at 4194304 Hz
+static constexpr std::chrono::nanoseconds dmg_frame_period(16742706);
+static constexpr double max_adjust = 0.005;
+
+rate_control::rate_control(sync mode, apu *a, sdl_audio_sink *audio)
+{
+    this->mode = mode;
+    gb_apu = a;
+    this->audio = audio != nullptr && audio->sample_rate() != 0 ? audio : nullptr;
+    if (this->audio == nullptr && mode == sync::audio)
+    {
+        this->mode = sync::video;
+    }
+    frame_period = dmg_frame_period;
+    deadline = std::chrono::steady_clock::now() + frame_period;
+    // ~50 ms of queued audio: a few device periods plus one frame of jitter
+    target_frames = this->audio != nullptr
+                        ? std::min<std::uint64_t>(this->audio->sample_rate() / 20, this->audio->capacity_frames() / 2)
+                        : 0;
+    ratio = 1.0;
+    late_frames = 0;
+}
+
+void rate_control::frame_done()
+{
+    switch (mode)
+    {
+    case sync::none:
+        break;
+    case sync::video:
+        adjust_rate();
+        wait_for_video();
+        break;
+    case sync::audio:
+        wait_for_audio();
+        break;
+    }
+}
+
+void rate_control::adjust_rate()
+{
+    if (audio == nullptr)
+    {
+        return;
+    }
+    double fill = static_cast<double>(audio->queued_frames());
+    double error = (static_cast<double>(target_frames) - fill) / target_frames;
+    ratio = 1.0 + max_adjust * std::clamp(error, -1.0, 1.0);
+    gb_apu->set_rate_ratio(ratio);
+}
+
+void rate_control::wait_for_video()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now > deadline + frame_period)
+    {
+        // too far behind to catch up without a burst of frames; start over
+        ++late_frames;
+        deadline = now + frame_period;
+        return;
+    }
+    std::this_thread::sleep_until(deadline);
+    deadline += frame_period;
+}
+
+void rate_control::wait_for_audio()
+{
+    // a stalled device must not stall emulation forever
+    auto give_up = std::chrono::steady_clock::now() + 4 * frame_period;
+    std::uint64_t queued = audio->queued_frames();
+    while (queued > target_frames && std::chrono::steady_clock::now() < give_up)
+    {
+        std::chrono::microseconds drain((queued - target_frames) * 1000000 / audio->sample_rate());
+        std::this_thread::sleep_for(std::max(drain, std::chrono::microseconds(500)));
+        queued = audio->queued_frames();
+    }
+}
+
+double rate_control::get_ratio()
+{
+    return ratio;
+}
+
+std::uint64_t rate_control::get_late_frames()
+{
+    return late_frames;
+}
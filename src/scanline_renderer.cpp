@@ -0,0 +1,191 @@
+#include <cstdint>
+#include <algorithm>
+
+#include "renderer.h"
+#include "bus.h"
+
+void ppu_renderer::connect_bus(bus *b)
+{
+    gb_bus = b;
+}
+
+void ppu_renderer::redirect(std::uint16_t *line)
+{
+    this->line = line;
+}
+
+scanline_renderer::scanline_renderer()
+{
+    gb_bus = nullptr;
+    ly = 0;
+    line = nullptr;
+    finished = true;
+    window_line = 0;
+    color_ids.fill(0);
+    bg_priority.fill(false);
+}
+
+void scanline_renderer::begin(std::uint8_t ly, const std::vector<sprite> &sprites, std::uint16_t *line)
+{
+    if (ly == 0)
+    {
+        window_line = 0;
+    }
+    this->ly = ly;
+    this->sprites = sprites;
+    this->line = line;
+    finished = false;
+}
+
+std::uint16_t scanline_renderer::step()
+{
+    draw();
+    finished = true;
+    return 172;
+}
+
+bool scanline_renderer::done()
+{
+    return finished;
+}
+
+// Draws pixels [start, end) of one layer, `source_x` being the layer column
+// under pixel `start`. Each tile row is decoded once and copied out whole,
+// clipped to the span at both ends for fine scroll.
+void scanline_renderer::draw_span(std::uint16_t tilemap_address, std::uint8_t start, std::uint8_t end,
+                                  std::uint8_t source_x, std::uint8_t source_y)
+{
+    std::uint8_t lcdc = gb_bus->read(0xff40);
+    bool cgb = gb_bus->is_cgb();
+    std::array<std::uint16_t, 4> colors = dmg_palette(gb_bus->read(0xff47));
+    std::uint16_t row_address = tilemap_address + (source_y / 8) * 32;
+    std::uint8_t x = start;
+    while (x < end)
+    {
+        std::uint16_t map_address = row_address + (source_x / 8) % 32;
+        std::uint8_t tile_index = gb_bus->read_vram(0, map_address);
+        // CGB: palette 0-2, VRAM bank 3, x flip 5, y flip 6, priority 7
+        std::uint8_t attributes = cgb ? gb_bus->read_vram(1, map_address) : 0;
+        std::uint16_t tile_address = (lcdc & (1 << 4)) ? 0x8000 + tile_index * 16
+                                                        : 0x9000 + static_cast<std::int8_t>(tile_index) * 16;
+        std::uint8_t row = (attributes & (1 << 6)) ? 7 - source_y % 8 : source_y % 8;
+        std::uint8_t bank = (attributes >> 3) & 1;
+        std::uint8_t tile_low = gb_bus->read_vram(bank, tile_address + row * 2);
+        std::uint8_t tile_high = gb_bus->read_vram(bank, tile_address + row * 2 + 1);
+        if (cgb)
+        {
+            for (std::uint8_t i = 0; i < 4; ++i)
+            {
+                colors[i] = gb_bus->bg_color(attributes & 0x07, i);
+            }
+        }
+        std::array<std::uint8_t, 8> ids;
+        for (std::uint8_t i = 0; i < 8; ++i)
+        {
+            int bit = (attributes & (1 << 5)) ? i : 7 - i;
+            ids[i] = (((tile_high >> bit) & 1) << 1) | ((tile_low >> bit) & 1);
+        }
+        std::uint8_t first = source_x % 8;
+        std::uint8_t count = std::min<int>(8 - first, end - x);
+        bool priority = attributes & (1 << 7);
+        for (std::uint8_t i = 0; i < count; ++i)
+        {
+            std::uint8_t color_value = ids[first + i];
+            line[x + i] = colors[color_value];
+            color_ids[x + i] = color_value;
+            bg_priority[x + i] = priority;
+        }
+        x += count;
+        source_x += count;
+    }
+}
+
+void scanline_renderer::draw()
+{
+    std::uint8_t lcdc = gb_bus->read(0xff40);
+    std::uint8_t scy = gb_bus->read(0xff42);
+    std::uint8_t scx = gb_bus->read(0xff43);
+    std::uint8_t wy = gb_bus->read(0xff4a);
+    std::uint8_t wx = gb_bus->read(0xff4b);
+    bool cgb = gb_bus->is_cgb();
+
+    bg_priority.fill(false);
+    // on CGB, LCDC bit 0 only takes priority away from the background
+    if (!cgb && !(lcdc & (1 << 0)))
+    {
+        std::fill(line, line + 160, dmg_colors[0]);
+        color_ids.fill(0);
+    }
+    else
+    {
+        // the window covers everything right of WX-7 once it has started
+        bool window = (lcdc & (1 << 5)) && ly >= wy && wx < 167;
+        std::uint8_t window_start = window ? std::max(wx - 7, 0) : 160;
+        std::uint16_t bg_map = (lcdc & (1 << 3)) ? 0x9c00 : 0x9800;
+        std::uint16_t window_map = (lcdc & (1 << 6)) ? 0x9c00 : 0x9800;
+        draw_span(bg_map, 0, window_start, scx, scy + ly);
+        if (window)
+        {
+            draw_span(window_map, window_start, 160, window_start - (wx - 7), window_line);
+            ++window_line;
+        }
+    }
+
+    // drawn back to front: the DMG ranks sprites by X, then OAM position;
+    // the CGB by OAM position only
+    std::reverse(sprites.begin(), sprites.end());
+    if (!cgb)
+    {
+        std::stable_sort(sprites.begin(), sprites.end(), [](const sprite &left, const sprite &right)
+                         { return left.x > right.x; });
+    }
+
+    std::uint8_t sprite_height = 8;
+    bool obj_size = lcdc & (1 << 2);
+    if (obj_size)
+    {
+        sprite_height = 16;
+    }
+    std::array<std::uint16_t, 4> obp0_colors = dmg_palette(gb_bus->read(0xff48));
+    std::array<std::uint16_t, 4> obp1_colors = dmg_palette(gb_bus->read(0xff49));
+    for (const sprite &obj : sprites)
+    {
+        bool palette_number = obj.flags & (1 << 4);
+        bool x_flip = obj.flags & (1 << 5);
+        bool y_flip = obj.flags & (1 << 6);
+        bool bg_window_over_obj = obj.flags & (1 << 7);
+        std::uint8_t bank = cgb ? (obj.flags >> 3) & 1 : 0;
+        std::uint8_t row = (ly + 16) - obj.y;
+        if (y_flip)
+        {
+            row = (sprite_height - 1) - row;
+        }
+        std::uint16_t pixel_address = 0x8000 + obj.tile * 16 + row * 2;
+        std::uint8_t tile_low = gb_bus->read_vram(bank, pixel_address);
+        std::uint8_t tile_high = gb_bus->read_vram(bank, pixel_address + 1);
+        std::array<std::uint16_t, 4> colors = palette_number ? obp1_colors : obp0_colors;
+        if (cgb)
+        {
+            for (std::uint8_t i = 0; i < 4; ++i)
+            {
+                colors[i] = gb_bus->obj_color(obj.flags & 0x07, i);
+            }
+        }
+        for (int i = 7; i >= 0; --i)
+        {
+            std::uint8_t color_value = (((tile_high >> i) & 1) << 1) | ((tile_low >> i) & 1);
+            int x = x_flip ? obj.x - (8 - i) : obj.x - (i + 1);
+            if (!(lcdc & (1 << 1)) || color_value == 0 || x < 0 || x > 159)
+            {
+                continue;
+            }
+            bool bg_over_obj = cgb ? (lcdc & (1 << 0)) && (bg_window_over_obj || bg_priority[x])
+                                   : bg_window_over_obj;
+            if (bg_over_obj && color_ids[x] != 0)
+            {
+                continue;
+            }
+            line[x] = colors[color_value];
+        }
+    }
+}
@@ -0,0 +1,306 @@
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <iostream>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "serial.h"
+#include "bus.h"
+
+// 8192 Hz shift clock
+static constexpr std::uint32_t cycles_per_bit = 512;
+
+void serial_transport::attach(serial *)
+{
+}
+
+std::uint32_t serial_transport::poll_interval()
+{
+    return 0;
+}
+
+void serial_transport::poll()
+{
+}
+
+std::uint8_t null_serial::exchange(std::uint8_t)
+{
+    return 0xff;
+}
+
+void serial_link::endpoint::attach(serial *s)
+{
+    target = s;
+}
+
+std::uint8_t serial_link::endpoint::exchange(std::uint8_t data)
+{
+    if (peer->target == nullptr)
+    {
+        return 0xff;
+    }
+    return peer->target->external_clock(data);
+}
+
+serial_link::serial_link()
+{
+    ends[0].peer = &ends[1];
+    ends[1].peer = &ends[0];
+}
+
+serial_transport *serial_link::first()
+{
+    return &ends[0];
+}
+
+serial_transport *serial_link::second()
+{
+    return &ends[1];
+}
+
+socket_serial::socket_serial(int fd)
+{
+    this->fd = fd;
+    target = nullptr;
+    window_start = std::chrono::steady_clock::now();
+    waited = std::chrono::microseconds(0);
+}
+
+socket_serial::~socket_serial()
+{
+    if (fd >= 0)
+    {
+        ::close(fd);
+    }
+}
+
+void socket_serial::attach(serial *s)
+{
+    target = s;
+}
+
+bool socket_serial::receive(std::uint8_t &type, std::uint8_t &data, int timeout_ms)
+{
+    pollfd request = {fd, POLLIN, 0};
+    if (fd < 0 || ::poll(&request, 1, timeout_ms) <= 0)
+    {
+        return false;
+    }
+    std::uint8_t message[2];
+    if (::recv(fd, message, sizeof(message), MSG_WAITALL) != sizeof(message))
+    {
+        // peer hung up; behave like an unplugged cable from now on
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    type = message[0];
+    data = message[1];
+    return true;
+}
+
+void socket_serial::reply(std::uint8_t data)
+{
+    std::uint8_t message[2] = {'R', data};
+    ::send(fd, message, sizeof(message), MSG_NOSIGNAL);
+}
+
+std::uint8_t socket_serial::exchange(std::uint8_t data)
+{
+    std::uint8_t message[2] = {'T', data};
+    if (fd < 0 || ::send(fd, message, sizeof(message), MSG_NOSIGNAL) != sizeof(message))
+    {
+        return 0xff;
+    }
+    auto start = std::chrono::steady_clock::now();
+    if (start - window_start >= window)
+    {
+        window_start = start;
+        waited = std::chrono::microseconds(0);
+    }
+    std::uint8_t result = 0xff;
+    std::uint8_t type;
+    std::uint8_t received;
+    while (true)
+    {
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        // rounded up, so a budget that is nearly spent still gets a wait
+        int timeout_ms = static_cast<int>((wait_budget - waited - elapsed).count() + 999) / 1000;
+        if (timeout_ms <= 0 || !receive(type, received, timeout_ms))
+        {
+            break;
+        }
+        if (type == 'R')
+        {
+            result = received;
+            break;
+        }
+        // both sides started a transfer at once; neither is listening
+        reply(target->external_clock(received));
+    }
+    waited += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    return result;
+}
+
+std::uint32_t socket_serial::poll_interval()
+{
+    return cycles_per_bit;
+}
+
+void socket_serial::poll()
+{
+    std::uint8_t type;
+    std::uint8_t received;
+    while (receive(type, received, 0))
+    {
+        // a late reply to a transfer that already timed out is dropped
+        if (type == 'T')
+        {
+            reply(target->external_clock(received));
+        }
+    }
+}
+
+int open_link_socket(const std::string &path)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        return -1;
+    }
+    std::strcpy(address.sun_path, path.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0)
+    {
+        return fd;
+    }
+
+    ::unlink(path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || ::listen(fd, 1) != 0)
+    {
+        ::close(fd);
+        return -1;
+    }
+    std::cerr << "waiting for link partner on " << path << std::endl;
+    int peer = ::accept(fd, nullptr, nullptr);
+    ::close(fd);
+    ::unlink(path.c_str());
+    return peer;
+}
+
+serial::serial(serial_state &s) : state(s)
+{
+    state.sb = 0x00;
+    state.sc = 0x00;
+    state.transfer_cycles = 0;
+    poll_interval = 0;
+    poll_cycles = 0;
+    transport = &disconnected;
+    gb_bus = nullptr;
+}
+
+serial &serial::operator=(const serial &other)
+{
+    output = other.output;
+    return *this;
+}
+
+void serial::reset()
+{
+    state.sb = 0x00;
+    state.sc = 0x00;
+    state.transfer_cycles = 0;
+    poll_cycles = 0;
+    output.clear();
+}
+
+void serial::connect_bus(bus *b)
+{
+    gb_bus = b;
+}
+
+void serial::connect(serial_transport *t)
+{
+    transport = t != nullptr ? t : &disconnected;
+    transport->attach(this);
+    poll_interval = transport->poll_interval();
+    poll_cycles = 0;
+}
+
+void serial::clock()
+{
+    if (state.transfer_cycles != 0 && --state.transfer_cycles == 0)
+    {
+        finish_transfer();
+    }
+    if (poll_interval != 0 && ++poll_cycles == poll_interval)
+    {
+        poll_cycles = 0;
+        transport->poll();
+    }
+}
+
+void serial::finish_transfer()
+{
+    state.sb = transport->exchange(state.sb);
+    state.sc = state.sc & ~(1 << 7);
+    gb_bus->write(0xff0f, gb_bus->read(0xff0f) | (1 << 3));
+}
+
+std::uint8_t serial::external_clock(std::uint8_t data)
+{
+    if ((state.sc & 0x81) != 0x80)
+    {
+        return 0xff;
+    }
+    std::uint8_t sent = state.sb;
+    state.sb = data;
+    state.sc = state.sc & ~(1 << 7);
+    gb_bus->write(0xff0f, gb_bus->read(0xff0f) | (1 << 3));
+    return sent;
+}
+
+std::uint8_t serial::read(std::uint16_t address)
+{
+    if (address == 0xff01)
+    {
+        return state.sb;
+    }
+    return state.sc | 0x7e;
+}
+
+void serial::write(std::uint16_t address, std::uint8_t data)
+{
+    if (address == 0xff01)
+    {
+        state.sb = data;
+        return;
+    }
+    state.sc = data & 0x81;
+    if ((state.sc & 0x81) == 0x81)
+    {
+        // logged at the start: test ROMs often don't wait for completion
+        output.push_back(state.sb);
+        state.transfer_cycles = 8 * cycles_per_bit;
+    }
+    else
+    {
+        // external clock: wait for the peer; clearing bit 7 aborts
+        state.transfer_cycles = 0;
+    }
+}
+
+const std::string &serial::get_output()
+{
+    return output;
+}
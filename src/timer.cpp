@@ -3,11 +3,17 @@
 #include "timer.h"
 #include "bus.h"
 
-timer::timer()
+timer::timer(timer_state &s) : state(s)
 {
-    div_counter = 0;
-    tima_counter = 0;
-    tima_delay = 0;
+    gb_bus = nullptr;
+    reset();
+}
+
+void timer::reset()
+{
+    state.div_counter = 0;
+    state.tima_counter = 0;
+    state.tima_delay = 0;
 }
 
 void timer::connect_bus(bus *b)
@@ -27,16 +33,16 @@ void timer::write(std::uint16_t address, std::uint8_t data)
 
 void timer::clock()
 {
-    ++div_counter;
-    if (div_counter == 256)
+    ++state.div_counter;
+    if (state.div_counter == 256)
     {
-        div_counter -= 256;
+        state.div_counter -= 256;
         gb_bus->increment_div();
     }
-    std::uint8_t tac = read(0xff07);
+    std::uint8_t tac = gb_bus->read_io(0x07);
     if (tac & (1 << 2))
     {
-        ++tima_counter;
+        ++state.tima_counter;
         std::uint32_t freq = 4096;
         if (tac & 0x01 == 0x01)
         {
@@ -51,17 +57,17 @@ void timer::clock()
             freq = 16384;
         }
 
-        std::uint8_t tima = read(0xff05);
-        if (tima_delay == 0)
+        std::uint8_t tima = gb_bus->read_io(0x05);
+        if (state.tima_delay == 0)
         {
-            while (tima_counter >= (4194304 / freq))
+            while (state.tima_counter >= (4194304 / freq))
             {
-                tima_counter -= (4194304 / freq);
+                state.tima_counter -= (4194304 / freq);
                 ++tima;
                 if (tima == 0x00)
                 {
                     write(0xff05, 0x00);
-                    ++tima_delay;
+                    ++state.tima_delay;
                 }
                 else
                 {
@@ -71,12 +77,12 @@ void timer::clock()
         }
         else
         {
-            ++tima_delay;
-            if (tima_delay == 4)
+            ++state.tima_delay;
+            if (state.tima_delay == 4)
             {
                 write(0xff0f, read(0xff0f) | (1 << 2));
                 write(0xff05, read(0xff06));
-                tima_delay = 0;
+                state.tima_delay = 0;
             }
         }
     }
@@ -0,0 +1,241 @@
+#include <cstdint>
+#include <cstring>
+#include <csignal>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "trace.h"
+
+trace_buffer::trace_buffer(std::uint64_t capacity)
+{
+    std::uint64_t size = 1;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+    records.resize(size);
+    mask = size - 1;
+    head.store(0);
+}
+
+std::uint64_t trace_buffer::size()
+{
+    return std::min<std::uint64_t>(head.load(std::memory_order_acquire), records.size());
+}
+
+std::uint64_t trace_buffer::capacity()
+{
+    return records.size();
+}
+
+const trace_record &trace_buffer::at(std::uint64_t age)
+{
+    return records[(head.load(std::memory_order_acquire) - 1 - age) & mask];
+}
+
+static bool write_all(int fd, const void *data, size_t size)
+{
+    const char *bytes = static_cast<const char *>(data);
+    while (size > 0)
+    {
+        ssize_t written = ::write(fd, bytes, size);
+        if (written <= 0)
+        {
+            return false;
+        }
+        bytes += written;
+        size -= written;
+    }
+    return true;
+}
+
+// Only uses write(2) so it can run inside a signal handler.
+bool trace_buffer::dump(int fd)
+{
+    std::uint64_t end = head.load(std::memory_order_acquire);
+    std::uint64_t count = std::min<std::uint64_t>(end, records.size());
+    std::uint64_t first = (end - count) & mask;
+
+    trace_header header;
+    header.magic = trace_magic;
+    header.version = 1;
+    header.record_size = sizeof(trace_record);
+    header.count = count;
+    if (!write_all(fd, &header, sizeof(header)))
+    {
+        return false;
+    }
+    std::uint64_t tail = std::min<std::uint64_t>(count, records.size() - first);
+    return write_all(fd, &records[first], tail * sizeof(trace_record)) &&
+           write_all(fd, &records[0], (count - tail) * sizeof(trace_record));
+}
+
+bool trace_buffer::dump(const std::string &path)
+{
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+    bool ok = dump(fd);
+    ::close(fd);
+    return ok;
+}
+
+static trace_buffer *signal_trace_buffer = nullptr;
+static char signal_trace_path[4096];
+
+static void trace_signal_handler(int signal)
+{
+    int fd = ::open(signal_trace_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0)
+    {
+        signal_trace_buffer->dump(fd);
+        ::close(fd);
+    }
+    if (signal != SIGUSR1)
+    {
+        std::raise(signal);
+    }
+}
+
+void install_trace_signal_handlers(trace_buffer *buffer, const std::string &path)
+{
+    signal_trace_buffer = buffer;
+    std::strncpy(signal_trace_path, path.c_str(), sizeof(signal_trace_path) - 1);
+
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = trace_signal_handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGUSR1, &action, nullptr);
+
+    action.sa_flags = SA_RESETHAND;
+    for (int signal : {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT})
+    {
+        sigaction(signal, &action, nullptr);
+    }
+}
+
+trace_file::trace_file()
+{
+    mapping = nullptr;
+    mapping_size = 0;
+    records = nullptr;
+    count = 0;
+}
+
+trace_file::~trace_file()
+{
+    if (mapping != nullptr)
+    {
+        ::munmap(mapping, mapping_size);
+    }
+}
+
+bool trace_file::open(const std::string &path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(trace_header))
+    {
+        ::close(fd);
+        return false;
+    }
+    mapping_size = info.st_size;
+    mapping = ::mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        mapping = nullptr;
+        return false;
+    }
+    ::madvise(mapping, mapping_size, MADV_SEQUENTIAL);
+
+    const trace_header *header = static_cast<const trace_header *>(mapping);
+    if (header->magic != trace_magic || header->record_size != sizeof(trace_record))
+    {
+        return false;
+    }
+    records = reinterpret_cast<const trace_record *>(static_cast<const char *>(mapping) + sizeof(trace_header));
+    count = std::min<std::uint64_t>(header->count, (mapping_size - sizeof(trace_header)) / sizeof(trace_record));
+    return true;
+}
+
+trace_comparator::trace_comparator(trace_buffer *history)
+{
+    this->history = history;
+    index = 0;
+    done = false;
+    failed = false;
+}
+
+bool trace_comparator::open(const std::string &path)
+{
+    return reference.open(path);
+}
+
+static void print_record(std::ostream &out, const char *label, const trace_record &record)
+{
+    char line[128];
+    std::snprintf(line, sizeof(line), "%s A:%02X F:%02X B:%02X C:%02X D:%02X E:%02X H:%02X L:%02X SP:%04X PC:%04X PCMEM:%02X,%02X",
+                  label, record.a, record.f, record.b, record.c, record.d, record.e, record.h, record.l, record.sp, record.pc,
+                  record.memory[0], record.memory[1]);
+    out << line << "\n";
+}
+
+void trace_comparator::report_mismatch(const trace_record &live)
+{
+    const trace_record &expected = reference.records[index];
+    done = true;
+    failed = true;
+
+    std::cerr << "trace mismatch at instruction " << index << " (cycle " << live.cycle << ")\n";
+    std::uint64_t n_history = std::min<std::uint64_t>(history->size(), 16);
+    for (std::uint64_t age = n_history; age > 1; --age)
+    {
+        print_record(std::cerr, "      ", history->at(age - 1));
+    }
+    print_record(std::cerr, "live  ", live);
+    print_record(std::cerr, "ref   ", expected);
+
+    const char *names[] = {"PC", "SP", "A", "F", "B", "C", "D", "E", "H", "L", "PCMEM[0]", "PCMEM[1]"};
+    unsigned live_values[] = {live.pc, live.sp, live.a, live.f, live.b, live.c, live.d, live.e, live.h, live.l,
+                              live.memory[0], live.memory[1]};
+    unsigned expected_values[] = {expected.pc, expected.sp, expected.a, expected.f, expected.b, expected.c, expected.d,
+                                  expected.e, expected.h, expected.l, expected.memory[0], expected.memory[1]};
+    for (size_t i = 0; i < 12; ++i)
+    {
+        if (live_values[i] != expected_values[i])
+        {
+            std::fprintf(stderr, "  %-8s live %04X  ref %04X\n", names[i], live_values[i], expected_values[i]);
+        }
+    }
+    std::cerr.flush();
+}
+
+bool trace_comparator::finished()
+{
+    return done;
+}
+
+bool trace_comparator::mismatched()
+{
+    return failed;
+}
+
+std::uint64_t trace_comparator::matched()
+{
+    return index;
+}
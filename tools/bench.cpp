@@ -0,0 +1,681 @@
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <array>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <utility>
+#include <memory>
+
+#include "gameboy.h"
+#include "profile.h"
+#include "profiler.h"
+
+struct bench_entry
+{
+    std::string name;
+    std::string rom;
+    std::uint32_t frames;
+    std::string input;
+};
+
+struct run_result
+{
+    double seconds;
+    std::uint64_t frames;
+    std::uint64_t cycles;
+    std::uint64_t instructions;
+    std::vector<double> frame_times_us;
+};
+
+struct split_result
+{
+    double cpu_ns;
+    double ppu_ns;
+    double timer_ns;
+    double bus_read_ns;
+    double bus_write_ns;
+    double other_ns;
+    double total_ns;
+    std::uint64_t bus_read_calls;
+    std::uint64_t bus_write_calls;
+};
+
+typedef std::vector<std::pair<std::uint32_t, std::uint8_t>> input_script;
+
+static input_script load_input_script(const std::string &path)
+{
+    input_script script;
+    if (path.empty())
+    {
+        return script;
+    }
+    std::ifstream input(path);
+    std::string line;
+    while (std::getline(input, line))
+    {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::uint32_t frame;
+        std::string mask;
+        if (fields >> frame >> mask)
+        {
+            script.push_back({frame, static_cast<std::uint8_t>(std::stoul(mask, nullptr, 16))});
+        }
+    }
+    std::stable_sort(script.begin(), script.end(), [](auto &left, auto &right)
+                     { return left.first < right.first; });
+    return script;
+}
+
+static std::vector<bench_entry> load_manifest(const std::string &path)
+{
+    std::vector<bench_entry> entries;
+    std::filesystem::path base = std::filesystem::path(path).parent_path();
+    std::ifstream input(path);
+    std::string line;
+    while (std::getline(input, line))
+    {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        bench_entry entry;
+        if (fields >> entry.name >> entry.rom >> entry.frames)
+        {
+            if (entry.frames == 0)
+            {
+                std::cerr << "gb_bench: skipping " << entry.name << ", which runs no frames" << std::endl;
+                continue;
+            }
+            entry.rom = (base / entry.rom).string();
+            if (fields >> entry.input)
+            {
+                entry.input = (base / entry.input).string();
+            }
+            entries.push_back(entry);
+        }
+    }
+    return entries;
+}
+
+static void apply_input(gameboy &gb, const input_script &script, size_t &next, std::uint32_t frame)
+{
+    while (next < script.size() && script[next].first <= frame)
+    {
+        gb.set_buttons(script[next].second);
+        ++next;
+    }
+}
+
+// superinstructions in the throughput runs (--fuse)
+static bool fuse_runs = false;
+
+// From power-on, or from the state the boot ROM left `boot` in.
+static void start(gameboy &gb, const bench_entry &entry, const gameboy *boot)
+{
+    if (boot != nullptr)
+    {
+        gb.restore(*boot);
+    }
+    else
+    {
+        gb.load_rom(entry.rom);
+    }
+    gb.gb_cpu.fusion = fuse_runs;
+}
+
+static run_result run_throughput(const bench_entry &entry, const input_script &script, const gameboy *boot)
+{
+    gameboy gb;
+    start(gb, entry, boot);
+    std::uint64_t start_cycles = gb.get_cycle_count();
+    std::uint64_t start_instructions = gb.gb_cpu.get_instruction_count();
+    run_result result;
+    result.frame_times_us.reserve(entry.frames);
+    size_t next_input = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    auto frame_start = start;
+    for (std::uint32_t frame = 0; frame < entry.frames; ++frame)
+    {
+        apply_input(gb, script, next_input, frame);
+        gb.run_frame();
+        auto frame_end = std::chrono::steady_clock::now();
+        result.frame_times_us.push_back(std::chrono::duration<double, std::micro>(frame_end - frame_start).count());
+        frame_start = frame_end;
+    }
+    result.seconds = std::chrono::duration<double>(frame_start - start).count();
+    result.frames = entry.frames;
+    result.cycles = gb.get_cycle_count() - start_cycles;
+    result.instructions = gb.gb_cpu.get_instruction_count() - start_instructions;
+    return result;
+}
+
+#ifdef GB_INSTRUMENT
+static std::uint64_t timer_overhead_ticks()
+{
+    std::uint64_t best = ~0ull;
+    for (int i = 0; i < 100000; ++i)
+    {
+        std::uint64_t start = host_ticks();
+        std::uint64_t end = host_ticks();
+        best = std::min(best, end - start);
+    }
+    return best;
+}
+
+// Runs the same frames with every subsystem call bracketed by host_ticks().
+// Bus time is measured inside bus::read/bus::write and subtracted from the
+// caller, so the cpu/ppu/timer figures are exclusive of memory accesses.
+// Whatever the brackets themselves cost beyond the calibrated minimum ends
+// up in "other".
+static split_result run_split(const bench_entry &entry, const input_script &script, const gameboy *boot)
+{
+    gameboy gb;
+    start(gb, entry, boot);
+    bus_profile bus_ticks;
+    gb.gb_bus.profile = &bus_ticks;
+    size_t next_input = 0;
+
+    std::uint64_t overhead = timer_overhead_ticks();
+    std::array<std::uint64_t, 3> inclusive = {0, 0, 0}; // cpu, ppu, timer
+    std::array<std::uint64_t, 3> nested_ticks = {0, 0, 0};
+    std::array<std::uint64_t, 3> nested_calls = {0, 0, 0};
+    std::array<std::uint64_t, 3> brackets = {0, 0, 0};
+    auto bus_total_ticks = [&]()
+    { return bus_ticks.read_ticks + bus_ticks.write_ticks; };
+    auto bus_total_calls = [&]()
+    { return bus_ticks.read_calls + bus_ticks.write_calls; };
+    auto measure = [&](size_t owner, auto &&call)
+    {
+        std::uint64_t bus_ticks_before = bus_total_ticks();
+        std::uint64_t bus_calls_before = bus_total_calls();
+        std::uint64_t start = host_ticks();
+        call();
+        inclusive[owner] += host_ticks() - start;
+        nested_ticks[owner] += bus_total_ticks() - bus_ticks_before;
+        nested_calls[owner] += bus_total_calls() - bus_calls_before;
+        ++brackets[owner];
+    };
+
+    auto wall_start = std::chrono::steady_clock::now();
+    std::uint64_t ticks_start = host_ticks();
+    for (std::uint32_t frame = 0; frame < entry.frames; ++frame)
+    {
+        apply_input(gb, script, next_input, frame);
+        std::uint64_t frame_count = gb.gb_ppu.get_frame_count();
+        while (gb.gb_ppu.get_frame_count() == frame_count)
+        {
+            measure(0, [&]()
+                    { gb.gb_cpu.handle_interrupt(); });
+            measure(1, [&]()
+                    { gb.gb_ppu.clock(); });
+            measure(2, [&]()
+                    { gb.gb_timer.clock(); gb.gb_bus.dma_clock(); });
+            measure(0, [&]()
+                    { gb.gb_cpu.clock(); });
+        }
+    }
+    std::uint64_t ticks_total = host_ticks() - ticks_start;
+    double wall_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - wall_start).count();
+    double ns_per_tick = wall_ns / static_cast<double>(ticks_total);
+
+    // Every bracket pays for one host_ticks() pair, and the bus brackets
+    // nested inside a caller are paid for a second time by the caller.
+    auto exclusive = [&](std::uint64_t ticks, std::uint64_t nested, std::uint64_t pairs)
+    {
+        double remaining = static_cast<double>(ticks) - static_cast<double>(nested) - static_cast<double>(pairs * overhead);
+        return std::max(0.0, remaining * ns_per_tick);
+    };
+
+    split_result result;
+    result.cpu_ns = exclusive(inclusive[0], nested_ticks[0], brackets[0] + nested_calls[0]);
+    result.ppu_ns = exclusive(inclusive[1], nested_ticks[1], brackets[1] + nested_calls[1]);
+    result.timer_ns = exclusive(inclusive[2], nested_ticks[2], brackets[2] + nested_calls[2]);
+    result.bus_read_ns = exclusive(bus_ticks.read_ticks, 0, bus_ticks.read_calls);
+    result.bus_write_ns = exclusive(bus_ticks.write_ticks, 0, bus_ticks.write_calls);
+    result.total_ns = wall_ns;
+    result.other_ns = std::max(0.0, wall_ns - result.cpu_ns - result.ppu_ns - result.timer_ns - result.bus_read_ns - result.bus_write_ns);
+    result.bus_read_calls = bus_ticks.read_calls;
+    result.bus_write_calls = bus_ticks.write_calls;
+    return result;
+}
+#endif
+
+static void run_profile(const bench_entry &entry, const input_script &script, const gameboy *boot, std::ostream &out)
+{
+    gameboy gb;
+    start(gb, entry, boot);
+    opcode_profiler profiler;
+    profiler.attach(gb);
+    size_t next_input = 0;
+    for (std::uint32_t frame = 0; frame < entry.frames; ++frame)
+    {
+        apply_input(gb, script, next_input, frame);
+        gb.run_frame<instrumentation::profile>();
+    }
+    out << "== " << entry.name << " (" << entry.rom << ", " << entry.frames << " frames)\n";
+    profiler.dump(out);
+    out << "\n";
+}
+
+// One thread stepping `instances` copies of the entry round-robin, `slice`
+// T-cycles each per turn, as a batched runner would; every turn touches a
+// different instance's state. Rendering is off so the per-tick state is what
+// gets measured. Returns instance-frames per second.
+static double run_rotation(const bench_entry &entry, const input_script &script, const gameboy *boot,
+                           std::uint32_t instances, std::uint32_t slice)
+{
+    std::vector<std::unique_ptr<gameboy>> machines;
+    std::vector<std::uint64_t> start_cycles;
+    std::vector<size_t> next_input(instances, 0);
+    for (std::uint32_t i = 0; i < instances; ++i)
+    {
+        machines.push_back(std::make_unique<gameboy>());
+        start(*machines.back(), entry, boot);
+        machines.back()->gb_ppu.set_render_mode(ppu::render_mode::off);
+        start_cycles.push_back(machines.back()->get_cycle_count());
+    }
+    const std::uint64_t length = 70224ull * entry.frames;
+
+    auto begin = std::chrono::steady_clock::now();
+    bool running = true;
+    while (running)
+    {
+        running = false;
+        for (std::uint32_t i = 0; i < instances; ++i)
+        {
+            gameboy &gb = *machines[i];
+            std::uint64_t end = start_cycles[i] + length;
+            std::uint64_t until = std::min(gb.get_cycle_count() + slice, end);
+            apply_input(gb, script, next_input[i], static_cast<std::uint32_t>(gb.gb_ppu.get_frame_count()));
+            while (gb.get_cycle_count() < until)
+            {
+                gb.clock();
+            }
+            running |= until < end;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return static_cast<double>(instances) * entry.frames / seconds;
+}
+
+// Runs the entry with and without superinstructions side by side; the first
+// frame whose hash differs, or -1.
+static std::int64_t check_fusion(const bench_entry &entry, const input_script &script, const gameboy *boot)
+{
+    gameboy fused;
+    gameboy stepped;
+    start(fused, entry, boot);
+    start(stepped, entry, boot);
+    fused.gb_cpu.fusion = true;
+    stepped.gb_cpu.fusion = false;
+    size_t next_fused = 0;
+    size_t next_stepped = 0;
+    for (std::uint32_t frame = 0; frame < entry.frames; ++frame)
+    {
+        apply_input(fused, script, next_fused, frame);
+        apply_input(stepped, script, next_stepped, frame);
+        fused.run_frame();
+        stepped.run_frame();
+        if (fused.gb_ppu.get_frame_hash() != stepped.gb_ppu.get_frame_hash())
+        {
+            return frame;
+        }
+    }
+    return -1;
+}
+
+static double percentile(std::vector<double> values, double p)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t rank = static_cast<size_t>(p / 100.0 * values.size() + 0.999999);
+    rank = std::clamp<size_t>(rank, 1, values.size());
+    return values[rank - 1];
+}
+
+static std::string json_string(const std::string &text)
+{
+    std::string escaped = "\"";
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+static void write_stats(std::ostream &out, const std::string &key, const std::vector<double> &values, bool last = false)
+{
+    out << "      " << json_string(key) << ": {\"median\": " << percentile(values, 50)
+        << ", \"p99\": " << percentile(values, 99)
+        << ", \"min\": " << (values.empty() ? 0.0 : *std::min_element(values.begin(), values.end()))
+        << ", \"max\": " << (values.empty() ? 0.0 : *std::max_element(values.begin(), values.end()))
+        << "}" << (last ? "\n" : ",\n");
+}
+
+static void write_split(std::ostream &out, const split_result &split)
+{
+    auto share = [&](double ns)
+    { return split.total_ns > 0 ? ns / split.total_ns : 0.0; };
+    out << "      \"split\": {\n";
+    out << "        \"total_ns\": " << split.total_ns << ",\n";
+    out << "        \"cpu_clock\": {\"ns\": " << split.cpu_ns << ", \"share\": " << share(split.cpu_ns) << "},\n";
+    out << "        \"ppu_clock\": {\"ns\": " << split.ppu_ns << ", \"share\": " << share(split.ppu_ns) << "},\n";
+    out << "        \"timer_clock\": {\"ns\": " << split.timer_ns << ", \"share\": " << share(split.timer_ns) << "},\n";
+    out << "        \"bus_read\": {\"ns\": " << split.bus_read_ns << ", \"share\": " << share(split.bus_read_ns) << ", \"calls\": " << split.bus_read_calls << "},\n";
+    out << "        \"bus_write\": {\"ns\": " << split.bus_write_ns << ", \"share\": " << share(split.bus_write_ns) << ", \"calls\": " << split.bus_write_calls << "},\n";
+    out << "        \"other\": {\"ns\": " << split.other_ns << ", \"share\": " << share(split.other_ns) << "}\n";
+    out << "      }\n";
+}
+
+#ifndef GB_INSTRUMENT
+static std::string shell_quote(const std::string &text)
+{
+    std::string quoted = "'";
+    for (char c : text)
+    {
+        quoted += c == '\'' ? std::string("'\\''") : std::string(1, c);
+    }
+    return quoted + "'";
+}
+
+// This build has no bus::read/bus::write brackets, so the split comes from
+// gb_bench_split, the same tool linked against the instrumented core, run
+// on just this entry. Its output is the "split" member; null if it fails.
+static void write_split_from(std::ostream &out, const std::string &tool, const bench_entry &entry,
+                             const std::string &boot_rom)
+{
+    std::string command = shell_quote(tool) + " --split-only --rom " + shell_quote(entry.rom) + " --frames " +
+                          std::to_string(entry.frames);
+    if (!entry.input.empty())
+    {
+        command += " --input " + shell_quote(entry.input);
+    }
+    if (!boot_rom.empty())
+    {
+        command += " --boot-rom " + shell_quote(boot_rom);
+    }
+    std::string fragment;
+    if (FILE *child = ::popen(command.c_str(), "r"))
+    {
+        char buffer[4096];
+        size_t length;
+        while ((length = std::fread(buffer, 1, sizeof(buffer), child)) > 0)
+        {
+            fragment.append(buffer, length);
+        }
+        if (::pclose(child) != 0)
+        {
+            fragment.clear();
+        }
+    }
+    if (fragment.empty())
+    {
+        std::cerr << "gb_bench: no split for " << entry.name << " from " << tool << std::endl;
+        fragment = "      \"split\": null\n";
+    }
+    out << fragment;
+}
+#endif
+
+static void usage()
+{
+    std::cerr << "usage: gb_bench (--rom <path> | --manifest <file>) [--frames N] [--runs N]\n"
+              << "                [--input <script>] [--boot-rom <path>] [--output <file.json>]\n"
+              << "                [--no-split] [--profile <file>] [--fuse] [--check-fusion]\n"
+              << "                [--instances N [--slice T-cycles]]\n"
+              << "  --rom, --manifest  one ROM, or the corpus manifest (name, ROM, frames, input script)\n"
+              << "  --frames N         frames per run for --rom (default 600)\n"
+              << "  --runs N           throughput runs per ROM, reported as median/p99 (default 5)\n"
+              << "  --input <script>   button script for --rom\n"
+              << "  --boot-rom <path>  boot each ROM once and start every run from that state\n"
+              << "  --output <file>    write the JSON report there instead of stdout\n"
+              << "  --no-split         skip the host-time split (run by gb_bench_split)\n"
+              << "  --profile <file>   append an opcode profile of each ROM\n"
+              << "  --fuse             run the throughput runs with superinstructions\n"
+              << "  --check-fusion     compare frame hashes with superinstructions on and off\n"
+              << "  --instances N      also step N instances round-robin on one thread\n"
+              << "  --slice T          T-cycles per instance and turn for --instances (default 456)" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<bench_entry> entries;
+    std::string rom;
+    std::string manifest;
+    std::string input;
+    std::string output;
+    std::string profile;
+    std::string boot_rom;
+    std::uint32_t frames = 600;
+    std::uint32_t runs = 5;
+    bool split = true;
+    bool fusion_check = false;
+    bool split_only = false; // gb_bench_split, run by gb_bench
+    std::uint32_t instances = 0;
+    std::uint32_t slice = 456;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--no-split")
+        {
+            split = false;
+        }
+        else if (arg == "--split-only")
+        {
+            split_only = true;
+        }
+        else if (arg == "--fuse")
+        {
+            fuse_runs = true;
+        }
+        else if (arg == "--check-fusion")
+        {
+            fusion_check = true;
+        }
+        else if (i + 1 < argc && arg == "--rom")
+        {
+            rom = argv[++i];
+        }
+        else if (i + 1 < argc && arg == "--manifest")
+        {
+            manifest = argv[++i];
+        }
+        else if (i + 1 < argc && arg == "--frames")
+        {
+            frames = std::stoul(argv[++i]);
+            if (frames == 0)
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if (i + 1 < argc && arg == "--runs")
+        {
+            runs = std::max(1ul, std::stoul(argv[++i]));
+        }
+        else if (i + 1 < argc && arg == "--instances")
+        {
+            instances = std::stoul(argv[++i]);
+        }
+        else if (i + 1 < argc && arg == "--slice")
+        {
+            slice = std::max(1ul, std::stoul(argv[++i]));
+        }
+        else if (i + 1 < argc && arg == "--input")
+        {
+            input = argv[++i];
+        }
+        else if (i + 1 < argc && arg == "--output")
+        {
+            output = argv[++i];
+        }
+        else if (i + 1 < argc && arg == "--profile")
+        {
+            profile = argv[++i];
+        }
+        else if (i + 1 < argc && arg == "--boot-rom")
+        {
+            boot_rom = argv[++i];
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (!manifest.empty())
+    {
+        entries = load_manifest(manifest);
+    }
+    else if (!rom.empty())
+    {
+        entries.push_back({std::filesystem::path(rom).stem().string(), rom, frames, input});
+    }
+    else
+    {
+        usage();
+        return 1;
+    }
+
+#ifdef GB_INSTRUMENT
+    if (split_only)
+    {
+        // just the "split" member of the report, for gb_bench
+        std::cout << std::setprecision(10);
+        for (const bench_entry &entry : entries)
+        {
+            std::unique_ptr<gameboy> boot;
+            if (!boot_rom.empty() && (boot = gameboy::boot_snapshot(boot_rom, entry.rom)) == nullptr)
+            {
+                return 1;
+            }
+            write_split(std::cout, run_split(entry, load_input_script(entry.input), boot.get()));
+        }
+        return 0;
+    }
+#else
+    if (split_only)
+    {
+        usage();
+        return 1;
+    }
+    std::string split_tool = (std::filesystem::path(argv[0]).parent_path() / "gb_bench_split").string();
+#endif
+
+    std::ofstream file;
+    if (!output.empty())
+    {
+        file.open(output);
+    }
+    std::ostream &out = output.empty() ? std::cout : file;
+    std::ofstream profile_file;
+    if (!profile.empty())
+    {
+        profile_file.open(profile);
+    }
+    out << std::setprecision(10);
+    out << "{\n  \"benchmark\": \"gb_bench\",\n  \"version\": 1,\n  \"runs\": " << runs
+        << ",\n  \"fusion\": " << (fuse_runs ? "true" : "false") << ",\n  \"results\": [\n";
+
+    int failures = 0;
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const bench_entry &entry = entries[i];
+        out << "    {\n      \"name\": " << json_string(entry.name) << ",\n      \"rom\": " << json_string(entry.rom) << ",\n";
+        if (!std::filesystem::is_regular_file(entry.rom))
+        {
+            std::cerr << "gb_bench: missing ROM " << entry.rom << std::endl;
+            out << "      \"error\": \"rom not found\"\n    }" << (i + 1 < entries.size() ? ",\n" : "\n");
+            ++failures;
+            continue;
+        }
+        input_script script = load_input_script(entry.input);
+        // booted once; every run starts from the copy
+        std::unique_ptr<gameboy> boot;
+        if (!boot_rom.empty())
+        {
+            boot = gameboy::boot_snapshot(boot_rom, entry.rom);
+            if (boot == nullptr)
+            {
+                std::cerr << "gb_bench: unable to boot " << entry.rom << " with " << boot_rom << std::endl;
+                out << "      \"error\": \"boot failed\"\n    }" << (i + 1 < entries.size() ? ",\n" : "\n");
+                ++failures;
+                continue;
+            }
+        }
+
+        std::vector<double> fps;
+        std::vector<double> mips;
+        std::vector<double> cycles_per_second;
+        std::vector<double> wall_seconds;
+        std::vector<double> frame_times_us;
+        std::vector<double> rotation_fps;
+        for (std::uint32_t run = 0; run < runs; ++run)
+        {
+            if (instances != 0)
+            {
+                rotation_fps.push_back(run_rotation(entry, script, boot.get(), instances, slice));
+            }
+            run_result result = run_throughput(entry, script, boot.get());
+            fps.push_back(result.frames / result.seconds);
+            mips.push_back(result.instructions / result.seconds / 1e6);
+            cycles_per_second.push_back(result.cycles / result.seconds);
+            wall_seconds.push_back(result.seconds);
+            frame_times_us.insert(frame_times_us.end(), result.frame_times_us.begin(), result.frame_times_us.end());
+        }
+
+        out << "      \"frames\": " << entry.frames << ",\n";
+        if (fusion_check)
+        {
+            std::int64_t mismatch = check_fusion(entry, script, boot.get());
+            if (mismatch >= 0)
+            {
+                std::cerr << "gb_bench: " << entry.name << " differs without fusion at frame " << mismatch << std::endl;
+                ++failures;
+            }
+            out << "      \"fusion_mismatch_frame\": " << mismatch << ",\n";
+        }
+        write_stats(out, "emulated_fps", fps);
+        write_stats(out, "mips", mips);
+        write_stats(out, "t_cycles_per_second", cycles_per_second);
+        write_stats(out, "wall_seconds", wall_seconds);
+        if (instances != 0)
+        {
+            out << "      \"rotation\": {\"instances\": " << instances << ", \"slice\": " << slice << "},\n";
+            write_stats(out, "rotation_instance_fps", rotation_fps);
+        }
+        write_stats(out, "frame_time_us", frame_times_us, !split);
+        if (split)
+        {
+#ifdef GB_INSTRUMENT
+            write_split(out, run_split(entry, script, boot.get()));
+#else
+            write_split_from(out, split_tool, entry, boot_rom);
+#endif
+        }
+        if (!profile.empty())
+        {
+            run_profile(entry, script, boot.get(), profile_file);
+        }
+        out << "    }" << (i + 1 < entries.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}" << std::endl;
+
+    return failures == 0 ? 0 : 2;
+}
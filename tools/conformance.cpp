@@ -0,0 +1,413 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+#include "gameboy.h"
+
+// Runs every ROM under a directory headless, one instance per worker thread,
+// and writes the results as JUnit XML.
+//
+// Each ROM may have a sidecar <rom>.expect file; without one, the common
+// conventions are checked: "Passed"/"Failed" on the serial port (Blargg),
+// the Fibonacci/0x42 byte sequences on the serial port (Mooneye) and the
+// Blargg result signature at 0xa000.
+//   frames <n>                   give up after n frames
+//   serial <text>                pass once the serial output contains text
+//   serial_fail <text>           fail once the serial output contains text
+//   memory <addr> <byte>...      pass once memory at addr holds the bytes (hex)
+//   hash <frame> <hash>          pass if ppu::get_frame_hash at frame matches (hex)
+//   ppu <scanline|fifo>          render with this PPU backend
+
+struct expectation
+{
+    std::uint32_t frames = 0;
+    std::vector<std::string> serial_pass;
+    std::vector<std::string> serial_fail;
+    std::vector<std::pair<std::uint16_t, std::vector<std::uint8_t>>> memory;
+    std::uint32_t hash_frame = 0;
+    std::uint64_t hash = 0;
+    ppu::backend backend = ppu::backend::scanline;
+    bool defaults = true;
+};
+
+struct test_result
+{
+    std::string name;
+    std::string rom;
+    bool passed = false;
+    bool error = false;
+    std::string message;
+    std::string serial;
+    std::uint32_t frames = 0;
+    double seconds = 0;
+};
+
+static bool parse_backend(const std::string &name, ppu::backend &backend)
+{
+    if (name == "scanline" || name == "fifo")
+    {
+        backend = name == "fifo" ? ppu::backend::fifo : ppu::backend::scanline;
+        return true;
+    }
+    return false;
+}
+
+static expectation load_expectation(const std::filesystem::path &rom, std::uint32_t default_frames,
+                                    ppu::backend default_backend)
+{
+    expectation expect;
+    expect.frames = default_frames;
+    expect.backend = default_backend;
+    std::ifstream input(rom.string() + ".expect");
+    std::string line;
+    while (std::getline(input, line))
+    {
+        std::istringstream fields(line.substr(0, line.find('#')));
+        std::string key;
+        if (!(fields >> key))
+        {
+            continue;
+        }
+        if (key == "frames")
+        {
+            fields >> expect.frames;
+        }
+        else if (key == "serial" || key == "serial_fail")
+        {
+            std::string text;
+            std::getline(fields >> std::ws, text);
+            (key == "serial" ? expect.serial_pass : expect.serial_fail).push_back(text);
+            expect.defaults = expect.defaults && key == "serial_fail";
+        }
+        else if (key == "memory")
+        {
+            std::string address;
+            std::string byte;
+            fields >> address;
+            std::vector<std::uint8_t> bytes;
+            while (fields >> byte)
+            {
+                bytes.push_back(std::stoul(byte, nullptr, 16));
+            }
+            expect.memory.push_back({static_cast<std::uint16_t>(std::stoul(address, nullptr, 16)), bytes});
+            expect.defaults = false;
+        }
+        else if (key == "hash")
+        {
+            std::string hash;
+            fields >> expect.hash_frame >> hash;
+            expect.hash = std::stoull(hash, nullptr, 16);
+            expect.defaults = false;
+        }
+        else if (key == "ppu")
+        {
+            std::string name;
+            fields >> name;
+            parse_backend(name, expect.backend);
+        }
+    }
+    if (expect.defaults)
+    {
+        expect.serial_pass.push_back("Passed");
+        expect.serial_pass.push_back(std::string("\x03\x05\x08\x0d\x15\x22", 6));
+        expect.serial_fail.push_back("Failed");
+        expect.serial_fail.push_back(std::string(6, '\x42'));
+    }
+    return expect;
+}
+
+static bool memory_matches(gameboy &gb, std::uint16_t address, const std::vector<std::uint8_t> &bytes)
+{
+    for (size_t i = 0; i < bytes.size(); ++i)
+    {
+        if (gb.gb_bus.read(address + i) != bytes[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool contains_any(const std::string &text, const std::vector<std::string> &needles, std::string &found)
+{
+    for (const std::string &needle : needles)
+    {
+        if (text.find(needle) != std::string::npos)
+        {
+            found = needle;
+            return true;
+        }
+    }
+    return false;
+}
+
+static test_result run_test(const std::filesystem::path &rom, const std::filesystem::path &root, std::uint32_t default_frames,
+                            ppu::backend default_backend)
+{
+    test_result result;
+    result.rom = rom.string();
+    result.name = std::filesystem::relative(rom, root).string();
+    expectation expect = load_expectation(rom, default_frames, default_backend);
+    auto start = std::chrono::steady_clock::now();
+
+    gameboy gb;
+    gb.load_rom(rom.string());
+    gb.gb_ppu.set_backend(expect.backend);
+    bool finished = false;
+    for (std::uint32_t frame = 1; frame <= expect.frames && !finished; ++frame)
+    {
+        gb.run_frame();
+        result.frames = frame;
+        const std::string &serial = gb.gb_serial.get_output();
+        std::string found;
+        if (contains_any(serial, expect.serial_fail, found))
+        {
+            result.message = "serial output reported failure";
+            finished = true;
+        }
+        else if (contains_any(serial, expect.serial_pass, found))
+        {
+            result.passed = true;
+            finished = true;
+        }
+        else if (expect.defaults && memory_matches(gb, 0xa001, {0xde, 0xb0, 0x61}) && gb.gb_bus.read(0xa000) != 0x80)
+        {
+            result.passed = gb.gb_bus.read(0xa000) == 0x00;
+            if (!result.passed)
+            {
+                std::ostringstream message;
+                message << "result code 0x" << std::hex << static_cast<int>(gb.gb_bus.read(0xa000)) << " at 0xa000";
+                result.message = message.str();
+            }
+            finished = true;
+        }
+        else if (!expect.memory.empty() && std::all_of(expect.memory.begin(), expect.memory.end(), [&](auto &entry)
+                                                       { return memory_matches(gb, entry.first, entry.second); }))
+        {
+            result.passed = true;
+            finished = true;
+        }
+        else if (expect.hash_frame == frame)
+        {
+            std::uint64_t hash = gb.gb_ppu.get_frame_hash();
+            result.passed = hash == expect.hash;
+            if (!result.passed)
+            {
+                std::ostringstream message;
+                message << "framebuffer hash " << std::hex << std::setw(16) << std::setfill('0') << hash
+                        << " at frame " << std::dec << frame;
+                result.message = message.str();
+            }
+            finished = true;
+        }
+    }
+    if (!finished)
+    {
+        result.message = "timed out after " + std::to_string(expect.frames) + " frames";
+    }
+    result.serial = gb.gb_serial.get_output();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+static std::string xml_escape(const std::string &text)
+{
+    std::string escaped;
+    for (unsigned char c : text)
+    {
+        switch (c)
+        {
+        case '&':
+            escaped += "&amp;";
+            break;
+        case '<':
+            escaped += "&lt;";
+            break;
+        case '>':
+            escaped += "&gt;";
+            break;
+        case '"':
+            escaped += "&quot;";
+            break;
+        default:
+            if (c >= 0x20 || c == '\n' || c == '\t')
+            {
+                escaped += c;
+            }
+            else
+            {
+                // XML 1.0 has no way to write other control characters, not
+                // even as references; serial output often holds them
+                static const char digits[] = "0123456789abcdef";
+                escaped += "\\x";
+                escaped += digits[c >> 4];
+                escaped += digits[c & 0xf];
+            }
+        }
+    }
+    return escaped;
+}
+
+static void write_junit(std::ostream &out, const std::vector<test_result> &results, double seconds)
+{
+    size_t failures = std::count_if(results.begin(), results.end(), [](auto &result)
+                                    { return !result.passed && !result.error; });
+    size_t errors = std::count_if(results.begin(), results.end(), [](auto &result)
+                                  { return result.error; });
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    out << "<testsuites>\n";
+    out << "  <testsuite name=\"gb_conformance\" tests=\"" << results.size() << "\" failures=\"" << failures
+        << "\" errors=\"" << errors << "\" time=\"" << seconds << "\">\n";
+    for (const test_result &result : results)
+    {
+        out << "    <testcase classname=\"gb_conformance\" name=\"" << xml_escape(result.name) << "\" time=\"" << result.seconds << "\">\n";
+        if (result.error)
+        {
+            out << "      <error message=\"" << xml_escape(result.message) << "\"/>\n";
+        }
+        else if (!result.passed)
+        {
+            out << "      <failure message=\"" << xml_escape(result.message) << "\"/>\n";
+        }
+        out << "      <system-out>frames: " << result.frames << "\n"
+            << xml_escape(result.serial) << "</system-out>\n";
+        out << "    </testcase>\n";
+    }
+    out << "  </testsuite>\n</testsuites>\n";
+}
+
+static void usage()
+{
+    std::cerr << "usage: gb_conformance <rom directory> [--jobs N] [--frames N] [--junit <file.xml>]"
+              << " [--ppu scanline|fifo]" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        usage();
+        return 1;
+    }
+    std::filesystem::path root = argv[1];
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+    std::uint32_t frames = 3600;
+    std::string junit;
+    ppu::backend backend = ppu::backend::scanline;
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (i + 1 < argc && arg == "--jobs")
+        {
+            jobs = std::max(1ul, std::stoul(argv[++i]));
+        }
+        else if (i + 1 < argc && arg == "--frames")
+        {
+            frames = std::stoul(argv[++i]);
+        }
+        else if (i + 1 < argc && arg == "--junit")
+        {
+            junit = argv[++i];
+        }
+        else if (i + 1 < argc && arg == "--ppu" && parse_backend(argv[i + 1], backend))
+        {
+            ++i;
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    std::vector<std::filesystem::path> roms;
+    std::error_code ec;
+    for (auto &entry : std::filesystem::recursive_directory_iterator(root, ec))
+    {
+        std::string extension = entry.path().extension().string();
+        if (entry.is_regular_file() && (extension == ".gb" || extension == ".gbc"))
+        {
+            roms.push_back(entry.path());
+        }
+    }
+    if (ec)
+    {
+        std::cerr << "gb_conformance: " << root << ": " << ec.message() << std::endl;
+        return 1;
+    }
+    std::sort(roms.begin(), roms.end());
+
+    // Largest ROMs first so the long tail does not end up on one thread. A
+    // file that vanished or cannot be read counts as empty.
+    std::vector<size_t> order(roms.size());
+    std::vector<std::uintmax_t> sizes(roms.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+        sizes[i] = std::filesystem::file_size(roms[i], ec);
+        if (ec)
+        {
+            sizes[i] = 0;
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t left, size_t right)
+                     { return sizes[left] > sizes[right]; });
+
+    std::vector<test_result> results(roms.size());
+    std::atomic<size_t> next(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned worker = 0; worker < std::min<size_t>(jobs, roms.size()); ++worker)
+    {
+        workers.emplace_back([&]()
+                             {
+            for (size_t i = next++; i < roms.size(); i = next++)
+            {
+                size_t index = order[i];
+                if (sizes[index] < 0x150)
+                {
+                    results[index].name = std::filesystem::relative(roms[index], root).string();
+                    results[index].rom = roms[index].string();
+                    results[index].error = true;
+                    results[index].message = "ROM too small";
+                    continue;
+                }
+                results[index] = run_test(roms[index], root, frames, backend);
+            } });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t passed = 0;
+    for (const test_result &result : results)
+    {
+        std::cout << (result.passed ? "PASS " : result.error ? "ERROR " : "FAIL ") << result.name;
+        if (!result.passed)
+        {
+            std::cout << " (" << result.message << ")";
+        }
+        std::cout << std::fixed << std::setprecision(3) << " " << result.seconds << "s\n";
+        passed += result.passed;
+    }
+    std::cout << passed << "/" << results.size() << " passed in " << seconds << "s on " << jobs << " threads" << std::endl;
+
+    if (!junit.empty())
+    {
+        std::ofstream out(junit);
+        write_junit(out, results, seconds);
+    }
+    return passed == results.size() ? 0 : 1;
+}
@@ -0,0 +1,836 @@
+#include <cstdint>
+#include <cstdio>
+#include <csignal>
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "gameboy.h"
+#include "breakpoints.h"
+#include "disassembler.h"
+
+// Headless debugger for one ROM: a terminal REPL, or a GDB remote serial
+// protocol stub on a local socket. Built with -DGB_DEBUGGER=ON only; it
+// links the core compiled with the breakpoint check, which the other
+// targets leave out.
+//
+// GDB sees the SM83 as six 16-bit little-endian registers: AF BC DE HL SP PC.
+// Software and hardware breakpoints (Z0/Z1) apply in every ROM bank; Z2-Z4
+// become bus watchpoints.
+
+static void usage()
+{
+    std::cerr << "usage: gb_debugger <rom> [--gdb <port>]" << std::endl;
+}
+
+enum class stop_reason
+{
+    breakpoint,
+    watchpoint,
+    step,
+    frame,
+    interrupt
+};
+
+struct session
+{
+    gameboy gb;
+    breakpoint_map breakpoints;
+    watch_hit hit; // the last watchpoint that paused
+    const char *hit_kind; // GDB stop reason for it: watch, rwatch or awatch
+
+    session()
+    {
+        gb.breakpoints = &breakpoints;
+        hit = {};
+        hit_kind = "watch";
+    }
+};
+
+// Runs `frames` frames, 0 for no limit, stopping early at a breakpoint or
+// watchpoint, or when `interrupted` returns true (checked between frames).
+template <typename poll_function>
+static stop_reason run(session &s, std::uint64_t frames, poll_function interrupted)
+{
+    s.breakpoints.resume();
+    for (std::uint64_t n = 0; frames == 0 || n < frames;)
+    {
+        std::uint64_t frame = s.gb.gb_ppu.get_frame_count();
+        s.gb.run_frame<instrumentation::debug>();
+        if (s.breakpoints.is_stopped())
+        {
+            return stop_reason::breakpoint;
+        }
+        if (s.gb.gb_bus.paused())
+        {
+            return stop_reason::watchpoint;
+        }
+        n += s.gb.gb_ppu.get_frame_count() != frame;
+        if (interrupted())
+        {
+            return stop_reason::interrupt;
+        }
+    }
+    return stop_reason::frame;
+}
+
+// One instruction; a halted CPU runs until an interrupt wakes it.
+template <typename poll_function>
+static stop_reason step(session &s, poll_function interrupted)
+{
+    s.breakpoints.step();
+    while (true)
+    {
+        s.gb.run_frame<instrumentation::debug>();
+        if (s.breakpoints.is_stopped())
+        {
+            return stop_reason::step;
+        }
+        if (s.gb.gb_bus.paused())
+        {
+            return stop_reason::watchpoint;
+        }
+        if (interrupted())
+        {
+            return stop_reason::interrupt;
+        }
+    }
+}
+
+static std::string disassemble_at(session &s, std::uint16_t address, std::uint8_t &length)
+{
+    std::uint8_t bytes[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        bytes[i] = s.gb.gb_bus.peek(address + i);
+    }
+    length = decode(bytes).length;
+    return disassemble(address, bytes);
+}
+
+// --- terminal ---
+
+static volatile std::sig_atomic_t interrupt_requested = 0;
+
+static void handle_sigint(int)
+{
+    interrupt_requested = 1;
+}
+
+static bool parse_number(const std::string &text, std::uint32_t &value)
+{
+    std::string digits = text;
+    if (digits.size() > 1 && digits[0] == '$')
+    {
+        digits.erase(0, 1);
+    }
+    else if (digits.size() > 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X'))
+    {
+        digits.erase(0, 2);
+    }
+    if (digits.empty() || digits.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos)
+    {
+        return false;
+    }
+    value = std::stoul(digits, nullptr, 16);
+    return true;
+}
+
+// "addr" (every bank) or "bank:addr"
+static bool parse_location(const std::string &text, std::uint16_t &address, std::uint16_t &bank)
+{
+    std::uint32_t a = 0;
+    std::uint32_t b = breakpoint_map::any_bank;
+    size_t colon = text.find(':');
+    if (colon != std::string::npos)
+    {
+        if (!parse_number(text.substr(0, colon), b) || !parse_number(text.substr(colon + 1), a))
+        {
+            return false;
+        }
+    }
+    else if (!parse_number(text, a))
+    {
+        return false;
+    }
+    address = a;
+    bank = b;
+    return a <= 0xffff;
+}
+
+static void print_registers(session &s)
+{
+    cpu_registers r = s.gb.gb_cpu.get_registers();
+    std::printf("AF=%02X%02X BC=%02X%02X DE=%02X%02X HL=%02X%02X SP=%04X PC=%04X  %c%c%c%c  cycle %llu\n", r.a, r.f,
+                r.b, r.c, r.d, r.e, r.h, r.l, r.sp, r.pc, r.f & 0x80 ? 'Z' : '-', r.f & 0x40 ? 'N' : '-',
+                r.f & 0x20 ? 'H' : '-', r.f & 0x10 ? 'C' : '-',
+                static_cast<unsigned long long>(s.gb.get_cycle_count()));
+}
+
+static void print_location(session &s)
+{
+    std::uint16_t pc = s.gb.gb_cpu.get_pc();
+    std::uint8_t length;
+    std::string text = disassemble_at(s, pc, length);
+    std::printf("%02X:%04X  %s\n", s.gb.gb_bus.current_rom_bank(pc), pc, text.c_str());
+}
+
+static void print_stop(session &s, stop_reason reason)
+{
+    switch (reason)
+    {
+    case stop_reason::breakpoint:
+        std::printf("breakpoint\n");
+        break;
+    case stop_reason::watchpoint:
+        if (s.hit.access == watch_access::write)
+        {
+            std::printf("watchpoint: write $%04X = $%02X (was $%02X)\n", s.hit.address, s.hit.value, s.hit.previous);
+        }
+        else
+        {
+            std::printf("watchpoint: read $%04X = $%02X\n", s.hit.address, s.hit.value);
+        }
+        break;
+    case stop_reason::interrupt:
+        std::printf("interrupted\n");
+        break;
+    default:
+        break;
+    }
+    print_location(s);
+}
+
+static void help()
+{
+    std::printf("s|step [n]                 run n instructions\n"
+                "f|frame [n]                run to the end of n frames\n"
+                "c|continue                 run until a breakpoint or watchpoint; Ctrl-C stops\n"
+                "b|break [bank:]addr        stop before the instruction at addr (every bank by default)\n"
+                "d|delete [bank:]addr       remove a breakpoint\n"
+                "w|watch addr[-last] [r|w|rw]  stop on memory access (default w)\n"
+                "unwatch <id>               remove a watchpoint\n"
+                "info                       list breakpoints and watchpoints\n"
+                "r|regs                     registers\n"
+                "x addr [count]             memory\n"
+                "l|list [addr] [count]      disassembly, from pc by default\n"
+                "q|quit\n"
+                "numbers are hex\n");
+}
+
+static int repl(session &s)
+{
+    struct watch_entry
+    {
+        std::uint32_t id;
+        std::uint16_t first;
+        std::uint16_t last;
+        std::string access;
+    };
+    std::vector<std::pair<std::uint16_t, std::uint16_t>> breaks; // (bank, address), for listing
+    std::vector<watch_entry> watches;
+    auto interrupted = [] { return interrupt_requested != 0; };
+
+    print_location(s);
+    std::string line;
+    std::string last;
+    while (std::printf("(gb) "), std::fflush(stdout), std::getline(std::cin, line))
+    {
+        // an empty line repeats the last command
+        if (line.empty())
+        {
+            line = last;
+        }
+        last = line;
+        std::istringstream in(line);
+        std::string command;
+        std::vector<std::string> args;
+        in >> command;
+        for (std::string arg; in >> arg;)
+        {
+            args.push_back(arg);
+        }
+        std::uint32_t n = 1;
+        if (!args.empty() && (command == "s" || command == "step" || command == "f" || command == "frame") &&
+            !parse_number(args[0], n))
+        {
+            std::printf("bad count: %s\n", args[0].c_str());
+            continue;
+        }
+
+        if (command.empty())
+        {
+            continue;
+        }
+        else if (command == "q" || command == "quit")
+        {
+            break;
+        }
+        else if (command == "h" || command == "help")
+        {
+            help();
+        }
+        else if (command == "s" || command == "step")
+        {
+            interrupt_requested = 0;
+            std::signal(SIGINT, handle_sigint);
+            stop_reason reason = stop_reason::step;
+            for (std::uint32_t i = 0; i < n && reason == stop_reason::step; ++i)
+            {
+                reason = step(s, interrupted);
+            }
+            std::signal(SIGINT, SIG_DFL);
+            print_stop(s, reason);
+        }
+        else if (command == "f" || command == "frame" || command == "c" || command == "continue")
+        {
+            interrupt_requested = 0;
+            std::signal(SIGINT, handle_sigint);
+            stop_reason reason = run(s, command[0] == 'f' ? n : 0, interrupted);
+            std::signal(SIGINT, SIG_DFL);
+            print_stop(s, reason);
+        }
+        else if ((command == "b" || command == "break" || command == "d" || command == "delete") && args.size() == 1)
+        {
+            std::uint16_t address;
+            std::uint16_t bank;
+            if (!parse_location(args[0], address, bank))
+            {
+                std::printf("bad location: %s\n", args[0].c_str());
+                continue;
+            }
+            std::pair<std::uint16_t, std::uint16_t> location(address < 0x8000 ? bank : breakpoint_map::any_bank,
+                                                             address);
+            if (command[0] == 'b')
+            {
+                s.breakpoints.set(address, bank);
+                breaks.push_back(location);
+            }
+            else
+            {
+                s.breakpoints.clear(address, bank);
+                std::erase(breaks, location);
+            }
+        }
+        else if ((command == "w" || command == "watch") && (args.size() == 1 || args.size() == 2))
+        {
+            std::uint32_t first;
+            std::uint32_t last_address;
+            size_t dash = args[0].find('-');
+            if (!parse_number(args[0].substr(0, dash), first) ||
+                !parse_number(dash == std::string::npos ? args[0] : args[0].substr(dash + 1), last_address) ||
+                last_address < first || last_address > 0xffff)
+            {
+                std::printf("bad range: %s\n", args[0].c_str());
+                continue;
+            }
+            std::string access = args.size() == 2 ? args[1] : "w";
+            std::uint8_t bits = (access.find('r') != std::string::npos ? watch_access::read : 0) |
+                                (access.find('w') != std::string::npos ? watch_access::write : 0);
+            if (bits == 0)
+            {
+                std::printf("bad access: %s\n", access.c_str());
+                continue;
+            }
+            std::uint32_t id = s.gb.gb_bus.add_watchpoint(
+                {static_cast<std::uint16_t>(first), static_cast<std::uint16_t>(last_address), bits, nullptr,
+                 [&s](const watch_hit &hit) {
+                     s.hit = hit;
+                     return true;
+                 }});
+            watches.push_back({id, static_cast<std::uint16_t>(first), static_cast<std::uint16_t>(last_address), access});
+            std::printf("watchpoint %u\n", id);
+        }
+        else if (command == "unwatch" && args.size() == 1)
+        {
+            std::uint32_t id = std::stoul(args[0]);
+            s.gb.gb_bus.remove_watchpoint(id);
+            std::erase_if(watches, [id](const watch_entry &w) { return w.id == id; });
+        }
+        else if (command == "info")
+        {
+            for (const auto &[bank, address] : breaks)
+            {
+                if (bank == breakpoint_map::any_bank)
+                {
+                    std::printf("break %04X\n", address);
+                }
+                else
+                {
+                    std::printf("break %02X:%04X\n", bank, address);
+                }
+            }
+            for (const watch_entry &w : watches)
+            {
+                std::printf("watch %u %04X-%04X %s\n", w.id, w.first, w.last, w.access.c_str());
+            }
+        }
+        else if (command == "r" || command == "regs")
+        {
+            print_registers(s);
+        }
+        else if (command == "x" && (args.size() == 1 || args.size() == 2))
+        {
+            std::uint32_t address;
+            std::uint32_t count = 64;
+            if (!parse_number(args[0], address) || (args.size() == 2 && !parse_number(args[1], count)))
+            {
+                std::printf("bad arguments\n");
+                continue;
+            }
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                std::uint16_t at = address + i;
+                if (i % 16 == 0)
+                {
+                    std::printf("%s%04X ", i == 0 ? "" : "\n", at);
+                }
+                std::printf(" %02X", s.gb.gb_bus.peek(at));
+            }
+            std::printf("\n");
+        }
+        else if (command == "l" || command == "list")
+        {
+            std::uint32_t address = s.gb.gb_cpu.get_pc();
+            std::uint32_t count = 10;
+            if ((!args.empty() && !parse_number(args[0], address)) ||
+                (args.size() == 2 && !parse_number(args[1], count)))
+            {
+                std::printf("bad arguments\n");
+                continue;
+            }
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                std::uint8_t length;
+                std::string text = disassemble_at(s, address, length);
+                std::printf("%c %04X  %s\n", address == s.gb.gb_cpu.get_pc() ? '>' : ' ', address, text.c_str());
+                address = (address + length) & 0xffff;
+            }
+        }
+        else
+        {
+            std::printf("unknown command; try help\n");
+        }
+    }
+    return 0;
+}
+
+// --- GDB remote serial protocol ---
+
+class gdb_stub
+{
+private:
+    session &s;
+    int client;
+    bool acknowledge; // until QStartNoAckMode
+    std::string input; // received bytes not yet handled
+    // Z2-Z4 watchpoints, keyed by (type, address, length)
+    std::map<std::tuple<char, std::uint32_t, std::uint32_t>, std::uint32_t> watches;
+
+    static std::string hex(const std::uint8_t *data, size_t length)
+    {
+        static const char digits[] = "0123456789abcdef";
+        std::string text;
+        for (size_t i = 0; i < length; ++i)
+        {
+            text += digits[data[i] >> 4];
+            text += digits[data[i] & 0x0f];
+        }
+        return text;
+    }
+
+    static std::vector<std::uint8_t> unhex(const std::string &text)
+    {
+        std::vector<std::uint8_t> data;
+        for (size_t i = 0; i + 1 < text.size(); i += 2)
+        {
+            data.push_back(std::stoul(text.substr(i, 2), nullptr, 16));
+        }
+        return data;
+    }
+
+    bool receive()
+    {
+        char buffer[4096];
+        ssize_t n = ::read(client, buffer, sizeof(buffer));
+        if (n <= 0)
+        {
+            return false;
+        }
+        input.append(buffer, n);
+        return true;
+    }
+
+    bool send(const std::string &payload)
+    {
+        std::uint8_t checksum = 0;
+        for (char c : payload)
+        {
+            checksum += static_cast<std::uint8_t>(c);
+        }
+        char trailer[4];
+        std::snprintf(trailer, sizeof(trailer), "#%02x", checksum);
+        std::string packet = "$" + payload + trailer;
+        return ::write(client, packet.data(), packet.size()) == static_cast<ssize_t>(packet.size());
+    }
+
+    // Next packet's payload; false once the client is gone. Ctrl-C outside
+    // of a packet arrives as "\x03".
+    bool next_packet(std::string &payload)
+    {
+        while (true)
+        {
+            size_t start = input.find_first_of("$\x03");
+            if (start != std::string::npos && input[start] == '\x03')
+            {
+                input.erase(0, start + 1);
+                payload = "\x03";
+                return true;
+            }
+            size_t end = start == std::string::npos ? std::string::npos : input.find('#', start);
+            if (end != std::string::npos && end + 2 < input.size())
+            {
+                payload = input.substr(start + 1, end - start - 1);
+                input.erase(0, end + 3);
+                if (acknowledge)
+                {
+                    ::write(client, "+", 1);
+                }
+                return true;
+            }
+            if (!receive())
+            {
+                return false;
+            }
+        }
+    }
+
+    // Ctrl-C while the target runs
+    bool interrupted()
+    {
+        pollfd p = {client, POLLIN, 0};
+        if (::poll(&p, 1, 0) <= 0 || !receive())
+        {
+            return false;
+        }
+        size_t at = input.find('\x03');
+        if (at == std::string::npos)
+        {
+            return false;
+        }
+        input.erase(at, 1);
+        return true;
+    }
+
+    std::string registers()
+    {
+        cpu_registers r = s.gb.gb_cpu.get_registers();
+        std::uint8_t bytes[12] = {r.f, r.a, r.c, r.b, r.e, r.d, r.l, r.h, static_cast<std::uint8_t>(r.sp),
+                                  static_cast<std::uint8_t>(r.sp >> 8), static_cast<std::uint8_t>(r.pc),
+                                  static_cast<std::uint8_t>(r.pc >> 8)};
+        return hex(bytes, sizeof(bytes));
+    }
+
+    void set_registers(const std::vector<std::uint8_t> &bytes)
+    {
+        if (bytes.size() < 12)
+        {
+            return;
+        }
+        cpu_registers r;
+        r.f = bytes[0];
+        r.a = bytes[1];
+        r.c = bytes[2];
+        r.b = bytes[3];
+        r.e = bytes[4];
+        r.d = bytes[5];
+        r.l = bytes[6];
+        r.h = bytes[7];
+        r.sp = bytes[8] | (bytes[9] << 8);
+        r.pc = bytes[10] | (bytes[11] << 8);
+        s.gb.gb_cpu.set_registers(r);
+    }
+
+    std::string stop_reply(stop_reason reason)
+    {
+        if (reason == stop_reason::interrupt)
+        {
+            return "S02";
+        }
+        if (reason == stop_reason::watchpoint)
+        {
+            char reply[32];
+            std::snprintf(reply, sizeof(reply), "T05%s:%04x;", s.hit_kind, s.hit.address);
+            return reply;
+        }
+        return "S05";
+    }
+
+    std::string watch(char type, bool insert, std::uint32_t address, std::uint32_t length)
+    {
+        auto key = std::make_tuple(type, address, length);
+        if (!insert)
+        {
+            auto found = watches.find(key);
+            if (found != watches.end())
+            {
+                s.gb.gb_bus.remove_watchpoint(found->second);
+                watches.erase(found);
+            }
+            return "OK";
+        }
+        if (length == 0 || address + length > 0x10000)
+        {
+            return "E01";
+        }
+        std::uint8_t access = type == '2' ? watch_access::write
+                              : type == '3' ? watch_access::read
+                                            : watch_access::read | watch_access::write;
+        const char *kind = type == '2' ? "watch" : type == '3' ? "rwatch" : "awatch";
+        watches[key] = s.gb.gb_bus.add_watchpoint(
+            {static_cast<std::uint16_t>(address), static_cast<std::uint16_t>(address + length - 1), access, nullptr,
+             [this, kind](const watch_hit &hit) {
+                 s.hit = hit;
+                 s.hit_kind = kind;
+                 return true;
+             }});
+        return "OK";
+    }
+
+    // Reply to one packet; an empty reply means "unsupported".
+    std::string handle(const std::string &packet, bool &done)
+    {
+        auto poll = [this] { return interrupted(); };
+        char command = packet.empty() ? '\0' : packet[0];
+        std::string args = packet.size() > 1 ? packet.substr(1) : "";
+        switch (command)
+        {
+        case '?':
+            return "S05";
+        case 'g':
+            return registers();
+        case 'G':
+            set_registers(unhex(args));
+            return "OK";
+        case 'p':
+        {
+            std::uint32_t n = std::stoul(args, nullptr, 16);
+            std::string all = registers();
+            return n < 6 ? all.substr(n * 4, 4) : "E01";
+        }
+        case 'P':
+        {
+            size_t equals = args.find('=');
+            std::uint32_t n = std::stoul(args.substr(0, equals), nullptr, 16);
+            std::vector<std::uint8_t> bytes = unhex(registers());
+            std::vector<std::uint8_t> value = unhex(args.substr(equals + 1));
+            if (n >= 6 || value.size() < 2)
+            {
+                return "E01";
+            }
+            bytes[n * 2] = value[0];
+            bytes[n * 2 + 1] = value[1];
+            set_registers(bytes);
+            return "OK";
+        }
+        case 'm':
+        {
+            size_t comma = args.find(',');
+            std::uint32_t address = std::stoul(args.substr(0, comma), nullptr, 16);
+            std::uint32_t length = std::stoul(args.substr(comma + 1), nullptr, 16);
+            std::vector<std::uint8_t> bytes;
+            for (std::uint32_t i = 0; i < length && address + i <= 0xffff; ++i)
+            {
+                bytes.push_back(s.gb.gb_bus.peek(address + i));
+            }
+            return bytes.empty() ? "E01" : hex(bytes.data(), bytes.size());
+        }
+        case 'M':
+        {
+            size_t comma = args.find(',');
+            size_t colon = args.find(':');
+            std::uint32_t address = std::stoul(args.substr(0, comma), nullptr, 16);
+            std::vector<std::uint8_t> bytes = unhex(args.substr(colon + 1));
+            for (size_t i = 0; i < bytes.size() && address + i <= 0xffff; ++i)
+            {
+                s.gb.gb_bus.poke(address + i, bytes[i]);
+            }
+            return "OK";
+        }
+        case 'c':
+            return stop_reply(run(s, 0, poll));
+        case 's':
+            return stop_reply(step(s, poll));
+        case 'Z':
+        case 'z':
+        {
+            size_t first = args.find(',');
+            size_t second = args.find(',', first + 1);
+            std::uint32_t address = std::stoul(args.substr(first + 1, second - first - 1), nullptr, 16);
+            std::uint32_t kind = std::stoul(args.substr(second + 1), nullptr, 16);
+            if (address > 0xffff)
+            {
+                return "E01";
+            }
+            switch (args[0])
+            {
+            case '0':
+            case '1':
+                if (command == 'Z')
+                {
+                    s.breakpoints.set(address);
+                }
+                else
+                {
+                    s.breakpoints.clear(address);
+                }
+                return "OK";
+            case '2':
+            case '3':
+            case '4':
+                return watch(args[0], command == 'Z', address, kind);
+            default:
+                return "";
+            }
+        }
+        case 'H':
+            return "OK";
+        case 'D':
+            done = true;
+            return "OK";
+        case 'k':
+            done = true;
+            return "";
+        case 'q':
+            if (packet.rfind("qSupported", 0) == 0)
+            {
+                return "PacketSize=1000;QStartNoAckMode+";
+            }
+            if (packet == "qAttached")
+            {
+                return "1";
+            }
+            if (packet == "qfThreadInfo")
+            {
+                return "m1";
+            }
+            if (packet == "qsThreadInfo")
+            {
+                return "l";
+            }
+            if (packet == "qC")
+            {
+                return "QC1";
+            }
+            return "";
+        case 'Q':
+            if (packet == "QStartNoAckMode")
+            {
+                acknowledge = false;
+                return "OK";
+            }
+            return "";
+        default:
+            return "";
+        }
+    }
+
+public:
+    gdb_stub(session &s, int client) : s(s), client(client)
+    {
+        acknowledge = true;
+    }
+
+    void serve()
+    {
+        std::string packet;
+        bool done = false;
+        while (!done && next_packet(packet))
+        {
+            if (packet == "\x03")
+            {
+                // already stopped
+                send("S02");
+                continue;
+            }
+            std::string reply;
+            try
+            {
+                reply = handle(packet, done);
+            }
+            catch (const std::exception &)
+            {
+                reply = "E01"; // malformed numbers
+            }
+            if (packet != "k" && !send(reply))
+            {
+                break;
+            }
+        }
+    }
+};
+
+static int serve_gdb(session &s, std::uint16_t port)
+{
+    int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, 1) != 0)
+    {
+        std::cerr << "gb_debugger: unable to listen on port " << port << std::endl;
+        return 1;
+    }
+    std::cerr << "gb_debugger: waiting for gdb on 127.0.0.1:" << port << std::endl;
+    int client = ::accept(listener, nullptr, nullptr);
+    ::close(listener);
+    if (client < 0)
+    {
+        return 1;
+    }
+    gdb_stub(s, client).serve();
+    ::close(client);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        usage();
+        return 1;
+    }
+    std::string rom = argv[1];
+    std::uint32_t port = 0;
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (i + 1 < argc && arg == "--gdb")
+        {
+            port = std::stoul(argv[++i]);
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    session s;
+    s.gb.load_rom(rom);
+    return port != 0 ? serve_gdb(s, port) : repl(s);
+}
@@ -0,0 +1,832 @@
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <array>
+#include <map>
+#include <set>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <utility>
+
+#include "cpu.h"
+#include "disassembler.h"
+#include "block_index.h"
+
+// Static disassembler: recursive descent from the reset and interrupt
+// vectors through every bank reachable by a call or jump, then basic blocks,
+// a call graph, an annotated listing and a block index (block_index.h).
+//
+// Banks are analysed in rounds, one worker per bank at a time: code in bank
+// 0 reaches a switchable bank through 0x4000-0x7fff, and the bank is taken
+// from a constant written to the MBC register earlier in the same straight
+// line of code (LD A,n / XOR A, then LD (2000-3fff),A). Targets whose bank
+// cannot be told that way are listed as unresolved.
+
+static void usage()
+{
+    std::cerr << "usage: gb_disasm <rom> [--listing <file>] [--index <file>] [--jobs N]" << std::endl;
+}
+
+static constexpr size_t bank_size = 0x4000;
+static constexpr std::uint16_t unknown_bank = 0xffff;
+
+// per byte of a bank
+namespace mark
+{
+    constexpr std::uint8_t code = 1 << 0;     // part of a decoded instruction
+    constexpr std::uint8_t start = 1 << 1;    // first byte of one
+    constexpr std::uint8_t leader = 1 << 2;   // a block starts here
+    constexpr std::uint8_t function = 1 << 3; // call target or vector
+    constexpr std::uint8_t target = 1 << 4;   // jump target
+    constexpr std::uint8_t invalid = 1 << 5;  // decoding stopped here
+}
+
+struct location
+{
+    std::uint16_t bank;
+    std::uint16_t address;
+
+    bool operator<(const location &other) const
+    {
+        return bank != other.bank ? bank < other.bank : address < other.address;
+    }
+    bool operator==(const location &other) const
+    {
+        return bank == other.bank && address == other.address;
+    }
+};
+
+// What an instruction does to control flow.
+struct flow
+{
+    std::uint8_t exit = block_exit::fallthrough;
+    bool conditional = false;
+    bool has_target = false;
+    std::uint16_t target = 0;
+};
+
+static std::vector<std::string> operands(const std::string &mnemonic)
+{
+    std::vector<std::string> result;
+    size_t space = mnemonic.find(' ');
+    if (space == std::string::npos)
+    {
+        return result;
+    }
+    std::string rest = mnemonic.substr(space + 1);
+    size_t start = 0;
+    while (true)
+    {
+        size_t comma = rest.find(',', start);
+        result.push_back(rest.substr(start, comma - start));
+        if (comma == std::string::npos)
+        {
+            return result;
+        }
+        start = comma + 1;
+    }
+}
+
+namespace target_operand
+{
+    constexpr std::uint8_t none = 0;
+    constexpr std::uint8_t relative = 1; // r8
+    constexpr std::uint8_t absolute = 2; // a16
+    constexpr std::uint8_t vector = 3;   // RST
+}
+
+// Per opcode, read off the opcode_table mnemonics once.
+struct opcode_flow
+{
+    std::uint8_t exit;
+    bool conditional;
+    std::uint8_t operand; // target_operand
+    std::uint16_t vector;
+    bool writes_a; // leaves A holding something other than before
+};
+
+static bool mnemonic_writes_a(const std::string &mnemonic)
+{
+    std::string op = mnemonic.substr(0, mnemonic.find(' '));
+    std::vector<std::string> args = operands(mnemonic);
+    if (!args.empty() && args[0] == "A")
+    {
+        return true;
+    }
+    if ((op == "SET" || op == "RES") && args.size() == 2 && args[1] == "A")
+    {
+        return true;
+    }
+    static const std::set<std::string> implicit = {"SUB", "AND", "XOR", "OR", "CPL", "DAA", "RLA", "RLCA", "RRA", "RRCA"};
+    return implicit.count(op) != 0 || mnemonic == "POP AF";
+}
+
+struct flow_tables
+{
+    std::array<opcode_flow, 256> base;
+    std::array<bool, 256> cb_writes_a;
+
+    flow_tables()
+    {
+        for (unsigned opcode = 0; opcode < 256; ++opcode)
+        {
+            std::uint8_t bytes[3] = {static_cast<std::uint8_t>(opcode), 0, 0};
+            std::string mnemonic = decode(bytes).mnemonic;
+            std::string op = mnemonic.substr(0, mnemonic.find(' '));
+            std::vector<std::string> args = operands(mnemonic);
+            opcode_flow f = {block_exit::fallthrough, false, target_operand::none, 0, mnemonic_writes_a(mnemonic)};
+            if (op == "INVALID")
+            {
+                f.exit = block_exit::invalid;
+            }
+            else if (op == "JP" || op == "JR" || op == "CALL")
+            {
+                f.conditional = args.size() == 2;
+                f.exit = op == "CALL" ? block_exit::call : f.conditional ? block_exit::branch : block_exit::jump;
+                if (args.back() == "(HL)")
+                {
+                    f.exit = block_exit::indirect;
+                }
+                else
+                {
+                    f.operand = op == "JR" ? target_operand::relative : target_operand::absolute;
+                }
+            }
+            else if (op == "RST")
+            {
+                f.exit = block_exit::call;
+                f.operand = target_operand::vector;
+                f.vector = static_cast<std::uint16_t>(std::stoul(args[0], nullptr, 16));
+            }
+            else if (op == "RET" || op == "RETI")
+            {
+                f.exit = block_exit::ret;
+                f.conditional = !args.empty();
+            }
+            base[opcode] = f;
+
+            std::uint8_t prefixed[2] = {0xcb, static_cast<std::uint8_t>(opcode)};
+            cb_writes_a[opcode] = mnemonic_writes_a(decode(prefixed).mnemonic);
+        }
+    }
+};
+
+static const flow_tables &tables()
+{
+    static const flow_tables instance;
+    return instance;
+}
+
+static flow classify(std::uint16_t address, const std::uint8_t *bytes)
+{
+    const opcode_flow &entry = tables().base[bytes[0]];
+    flow f;
+    f.exit = entry.exit;
+    f.conditional = entry.conditional;
+    f.has_target = entry.operand != target_operand::none;
+    switch (entry.operand)
+    {
+    case target_operand::relative:
+        f.target = static_cast<std::uint16_t>(address + 2 + static_cast<std::int8_t>(bytes[1]));
+        break;
+    case target_operand::absolute:
+        f.target = static_cast<std::uint16_t>(bytes[1] | (bytes[2] << 8));
+        break;
+    case target_operand::vector:
+        f.target = entry.vector;
+        break;
+    }
+    return f;
+}
+
+static bool writes_a(const std::uint8_t *bytes)
+{
+    return bytes[0] == 0xcb ? tables().cb_writes_a[bytes[1]] : tables().base[bytes[0]].writes_a;
+}
+
+struct call_site
+{
+    location from; // the calling instruction
+    location to;   // bank unknown_bank if unresolved
+};
+
+class rom_image
+{
+public:
+    std::vector<std::uint8_t> bytes;
+    std::uint16_t banks;
+    bool mbc5;
+    std::uint16_t checksum;
+
+    bool load(const std::string &path)
+    {
+        std::ifstream input(path, std::ios::binary);
+        if (!input)
+        {
+            return false;
+        }
+        bytes.assign(std::istreambuf_iterator<char>(input), {});
+        if (bytes.size() < 0x150)
+        {
+            return false;
+        }
+        bytes.resize((bytes.size() + bank_size - 1) / bank_size * bank_size, 0xff);
+        banks = bytes.size() / bank_size;
+        std::uint8_t type = bytes[0x147];
+        mbc5 = 0x19 <= type && type <= 0x1e;
+        checksum = (bytes[0x14e] << 8) | bytes[0x14f];
+        return true;
+    }
+
+    // The bank a write of `value` to the MBC bank register selects.
+    std::uint16_t selected_bank(std::uint8_t value) const
+    {
+        std::uint16_t bank = value;
+        if (bank == 0 && !mbc5)
+        {
+            bank = 1;
+        }
+        return bank % banks;
+    }
+};
+
+// One ROM bank's share of the analysis; touched by one worker at a time.
+class bank_analysis
+{
+public:
+    std::uint16_t bank;
+    std::uint16_t base; // CPU address of the first byte
+    std::vector<std::uint8_t> marks;
+    std::vector<std::uint16_t> pending; // CPU addresses still to decode
+    std::vector<call_site> calls;
+    std::vector<std::pair<location, bool>> outgoing; // code found in other banks, merged between rounds
+    std::vector<call_site> unresolved;
+
+    bank_analysis(std::uint16_t bank) : bank(bank), base(bank == 0 ? 0x0000 : 0x4000), marks(bank_size, 0)
+    {
+    }
+
+    bool contains(std::uint16_t address) const
+    {
+        return base <= address && address < base + bank_size;
+    }
+
+    // Where a branch from here to `target` lands; bank_switch is the bank
+    // the code selected beforehand, if known.
+    location resolve(const rom_image &rom, std::uint16_t target, std::uint16_t bank_switch) const
+    {
+        if (target < 0x4000)
+        {
+            return {0, target};
+        }
+        if (target >= 0x8000)
+        {
+            return {unknown_bank, target};
+        }
+        if (bank_switch != unknown_bank)
+        {
+            return {bank_switch, target};
+        }
+        if (bank != 0 || rom.banks <= 2)
+        {
+            return {static_cast<std::uint16_t>(bank == 0 ? 1 : bank), target};
+        }
+        return {unknown_bank, target};
+    }
+
+    void add_target(const location &to, bool function)
+    {
+        if (to.bank != bank)
+        {
+            outgoing.push_back({to, function});
+            return;
+        }
+        std::uint8_t &m = marks[to.address - base];
+        m |= mark::leader | (function ? mark::function : mark::target);
+        if (!(m & mark::start))
+        {
+            pending.push_back(to.address);
+        }
+    }
+
+    void explore(const rom_image &rom)
+    {
+        const std::uint8_t *data = rom.bytes.data() + bank * bank_size;
+        while (!pending.empty())
+        {
+            std::uint16_t address = pending.back();
+            pending.pop_back();
+            std::int16_t a_value = -1; // A, if known
+            std::uint16_t bank_switch = unknown_bank;
+            while (contains(address))
+            {
+                size_t offset = address - base;
+                if (marks[offset] & (mark::start | mark::invalid))
+                {
+                    break; // joined code already decoded
+                }
+                std::uint8_t bytes[3] = {data[offset], 0, 0};
+                for (size_t i = 1; i < 3 && offset + i < bank_size; ++i)
+                {
+                    bytes[i] = data[offset + i];
+                }
+                const opcode_info &info = decode(bytes);
+                flow f = classify(address, bytes);
+                if (f.exit == block_exit::invalid || offset + info.length > bank_size)
+                {
+                    marks[offset] |= mark::invalid;
+                    break;
+                }
+                marks[offset] |= mark::start;
+                for (size_t i = 0; i < info.length; ++i)
+                {
+                    marks[offset + i] |= mark::code;
+                }
+
+                // constant bank numbers written to the MBC
+                if (bytes[0] == 0x3e)
+                {
+                    a_value = bytes[1];
+                }
+                else if (bytes[0] == 0xaf)
+                {
+                    a_value = 0;
+                }
+                else if (bytes[0] == 0xea)
+                {
+                    std::uint16_t destination = bytes[1] | (bytes[2] << 8);
+                    if (0x2000 <= destination && destination < (rom.mbc5 ? 0x3000 : 0x4000))
+                    {
+                        bank_switch = a_value < 0 ? unknown_bank : rom.selected_bank(a_value);
+                    }
+                }
+                else if (writes_a(bytes))
+                {
+                    a_value = -1;
+                }
+
+                std::uint16_t next = address + info.length;
+                if (f.has_target)
+                {
+                    location to = resolve(rom, f.target, bank_switch);
+                    if (f.exit == block_exit::call)
+                    {
+                        calls.push_back({{bank, address}, to});
+                    }
+                    if (to.bank == unknown_bank)
+                    {
+                        if (f.target < 0x8000)
+                        {
+                            unresolved.push_back({{bank, address}, to});
+                        }
+                    }
+                    else
+                    {
+                        add_target(to, f.exit == block_exit::call);
+                    }
+                }
+                if (f.exit != block_exit::fallthrough)
+                {
+                    if (f.exit == block_exit::jump || f.exit == block_exit::indirect ||
+                        (f.exit == block_exit::ret && !f.conditional))
+                    {
+                        break;
+                    }
+                    // after a call or a branch not taken
+                    if (contains(next))
+                    {
+                        marks[next - base] |= mark::leader;
+                    }
+                    a_value = -1;
+                    bank_switch = unknown_bank;
+                }
+                address = next;
+            }
+        }
+    }
+};
+
+struct block
+{
+    block_record record;
+    std::uint16_t last; // address of the last instruction
+    std::vector<location> successors; // same-bank and bank 0 flow, not calls
+};
+
+static std::vector<block> find_blocks(const rom_image &rom, const bank_analysis &b)
+{
+    std::vector<block> blocks;
+    const std::uint8_t *data = rom.bytes.data() + b.bank * bank_size;
+    size_t offset = 0;
+    while (offset < bank_size)
+    {
+        if (!(b.marks[offset] & mark::start))
+        {
+            ++offset;
+            continue;
+        }
+        block current = {};
+        current.record.bank = b.bank;
+        current.record.address = b.base + offset;
+        current.record.function = (b.marks[offset] & mark::function) != 0;
+        current.record.exit = block_exit::fallthrough;
+        while (true)
+        {
+            std::uint8_t bytes[3] = {data[offset], offset + 1 < bank_size ? data[offset + 1] : std::uint8_t(0),
+                                     offset + 2 < bank_size ? data[offset + 2] : std::uint8_t(0)};
+            std::uint16_t address = b.base + offset;
+            std::uint8_t length = decode(bytes).length;
+            flow f = classify(address, bytes);
+            current.last = address;
+            current.record.length += length;
+            ++current.record.instructions;
+            offset += length;
+            if (f.exit != block_exit::fallthrough)
+            {
+                current.record.exit = f.exit;
+                if (f.has_target && f.exit != block_exit::call)
+                {
+                    location to = b.resolve(rom, f.target, unknown_bank);
+                    if (to.bank != unknown_bank)
+                    {
+                        current.successors.push_back(to);
+                    }
+                }
+                bool falls_through = f.conditional || f.exit == block_exit::call;
+                if (falls_through && offset < bank_size)
+                {
+                    current.successors.push_back({b.bank, static_cast<std::uint16_t>(b.base + offset)});
+                }
+                break;
+            }
+            if (offset >= bank_size || !(b.marks[offset] & mark::start))
+            {
+                current.record.exit = offset < bank_size && (b.marks[offset] & mark::invalid) ? block_exit::invalid
+                                                                                            : block_exit::fallthrough;
+                if (current.record.exit == block_exit::fallthrough && offset < bank_size)
+                {
+                    current.successors.push_back({b.bank, static_cast<std::uint16_t>(b.base + offset)});
+                }
+                break;
+            }
+            if (b.marks[offset] & mark::leader)
+            {
+                current.successors.push_back({b.bank, static_cast<std::uint16_t>(b.base + offset)});
+                break;
+            }
+        }
+        blocks.push_back(current);
+    }
+    return blocks;
+}
+
+static std::string label(const location &l, bool function)
+{
+    char text[24];
+    std::snprintf(text, sizeof(text), "%s_%02X_%04X", function ? "func" : "loc", l.bank, l.address);
+    return text;
+}
+
+static std::string name(const location &l)
+{
+    char text[16];
+    if (l.bank == unknown_bank)
+    {
+        std::snprintf(text, sizeof(text), "??:%04X", l.address);
+    }
+    else
+    {
+        std::snprintf(text, sizeof(text), "%02X:%04X", l.bank, l.address);
+    }
+    return text;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        usage();
+        return 1;
+    }
+    std::string listing_path;
+    std::string index_path;
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (i + 1 < argc && arg == "--listing")
+        {
+            listing_path = argv[++i];
+        }
+        else if (i + 1 < argc && arg == "--index")
+        {
+            index_path = argv[++i];
+        }
+        else if (i + 1 < argc && arg == "--jobs")
+        {
+            jobs = std::max(1ul, std::stoul(argv[++i]));
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    rom_image rom;
+    if (!rom.load(argv[1]))
+    {
+        std::cerr << "gb_disasm: unable to read " << argv[1] << std::endl;
+        return 1;
+    }
+    auto start_time = std::chrono::steady_clock::now();
+
+    std::vector<bank_analysis> banks;
+    banks.reserve(rom.banks);
+    for (std::uint16_t b = 0; b < rom.banks; ++b)
+    {
+        banks.emplace_back(b);
+    }
+    // entry point, RST and interrupt vectors
+    for (std::uint16_t vector : {0x0100, 0x00, 0x08, 0x10, 0x18, 0x20, 0x28, 0x30, 0x38, 0x40, 0x48, 0x50, 0x58, 0x60})
+    {
+        banks[0].add_target({0, vector}, true);
+    }
+
+    // Rounds: every bank with pending work in parallel, then hand the code
+    // each found in other banks over to them.
+    size_t rounds = 0;
+    while (true)
+    {
+        std::vector<size_t> work;
+        for (size_t b = 0; b < banks.size(); ++b)
+        {
+            if (!banks[b].pending.empty())
+            {
+                work.push_back(b);
+            }
+        }
+        if (work.empty())
+        {
+            break;
+        }
+        ++rounds;
+        std::atomic<size_t> next(0);
+        auto worker = [&] {
+            for (size_t i = next++; i < work.size(); i = next++)
+            {
+                banks[work[i]].explore(rom);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < std::min<size_t>(jobs, work.size()); ++t)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (std::thread &t : threads)
+        {
+            t.join();
+        }
+        for (bank_analysis &b : banks)
+        {
+            for (const auto &[to, function] : b.outgoing)
+            {
+                banks[to.bank].add_target(to, function);
+            }
+            b.outgoing.clear();
+        }
+    }
+
+    // blocks, one bank per worker
+    std::vector<std::vector<block>> blocks(banks.size());
+    {
+        std::atomic<size_t> next(0);
+        auto worker = [&] {
+            for (size_t i = next++; i < banks.size(); i = next++)
+            {
+                blocks[i] = find_blocks(rom, banks[i]);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < std::min<size_t>(jobs, banks.size()); ++t)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (std::thread &t : threads)
+        {
+            t.join();
+        }
+    }
+
+    // Call graph: a function is every block reachable from its entry without
+    // following calls; reaching another function's entry is a tail call.
+    std::map<location, const block *> by_start;
+    for (const std::vector<block> &bank_blocks : blocks)
+    {
+        for (const block &b : bank_blocks)
+        {
+            by_start[{b.record.bank, b.record.address}] = &b;
+        }
+    }
+    std::map<location, std::vector<location>> callers; // callee -> call sites
+    std::map<location, location> call_at;              // call site -> callee
+    for (const bank_analysis &b : banks)
+    {
+        for (const call_site &call : b.calls)
+        {
+            callers[call.to].push_back(call.from);
+            call_at[call.from] = call.to;
+        }
+    }
+    std::map<location, std::set<location>> callees; // function -> functions it calls
+    for (const auto &[entry, bank_blocks] : by_start)
+    {
+        if (!bank_blocks->record.function)
+        {
+            continue;
+        }
+        std::set<location> seen = {entry};
+        std::vector<location> stack = {entry};
+        std::set<location> &calls = callees[entry];
+        while (!stack.empty())
+        {
+            location at = stack.back();
+            stack.pop_back();
+            auto found = by_start.find(at);
+            if (found == by_start.end())
+            {
+                continue;
+            }
+            const block &b = *found->second;
+            if (b.record.exit == block_exit::call)
+            {
+                auto call = call_at.find({b.record.bank, b.last});
+                if (call != call_at.end())
+                {
+                    calls.insert(call->second);
+                }
+            }
+            for (const location &successor : b.successors)
+            {
+                auto next = by_start.find(successor);
+                if (next != by_start.end() && next->second->record.function)
+                {
+                    calls.insert(successor); // tail call
+                }
+                else if (seen.insert(successor).second)
+                {
+                    stack.push_back(successor);
+                }
+            }
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    block_index index;
+    index.rom_checksum = rom.checksum;
+    size_t instructions = 0;
+    size_t functions = 0;
+    for (const std::vector<block> &bank_blocks : blocks)
+    {
+        for (const block &b : bank_blocks)
+        {
+            index.blocks.push_back(b.record);
+            instructions += b.record.instructions;
+            functions += b.record.function;
+        }
+    }
+    if (!index_path.empty() && !index.save(index_path))
+    {
+        std::cerr << "gb_disasm: unable to write " << index_path << std::endl;
+        return 1;
+    }
+
+    // annotated listing
+    std::ofstream listing_file;
+    if (!listing_path.empty())
+    {
+        listing_file.open(listing_path);
+        if (!listing_file)
+        {
+            std::cerr << "gb_disasm: unable to write " << listing_path << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &out = listing_path.empty() ? std::cout : listing_file;
+    out << "; " << argv[1] << ": " << rom.banks << " banks, " << index.blocks.size() << " blocks, " << functions
+        << " functions\n";
+    char line[160];
+    for (const bank_analysis &b : banks)
+    {
+        const std::uint8_t *data = rom.bytes.data() + b.bank * bank_size;
+        std::snprintf(line, sizeof(line), "\n; ===== bank %02X =====\n", b.bank);
+        out << line;
+        size_t gap = 0;
+        for (size_t offset = 0; offset <= bank_size; ++offset)
+        {
+            bool is_start = offset < bank_size && (b.marks[offset] & mark::start);
+            bool in_code = offset < bank_size && (b.marks[offset] & mark::code);
+            if (!in_code && offset < bank_size)
+            {
+                ++gap;
+                continue;
+            }
+            if (gap != 0)
+            {
+                std::snprintf(line, sizeof(line), "; %zu bytes not reached at %04zX-%04zX\n", gap,
+                              b.base + offset - gap, b.base + offset - 1);
+                out << line;
+                gap = 0;
+            }
+            if (!is_start)
+            {
+                continue;
+            }
+            location here = {b.bank, static_cast<std::uint16_t>(b.base + offset)};
+            std::uint8_t m = b.marks[offset];
+            if (m & (mark::function | mark::target))
+            {
+                out << "\n" << label(here, m & mark::function) << ":";
+                auto found = callers.find(here);
+                if (found != callers.end())
+                {
+                    out << "  ; called from";
+                    size_t shown = 0;
+                    for (const location &from : found->second)
+                    {
+                        if (shown++ == 8)
+                        {
+                            out << " +" << found->second.size() - 8 << " more";
+                            break;
+                        }
+                        out << ' ' << name(from);
+                    }
+                }
+                out << '\n';
+            }
+            std::uint8_t bytes[3] = {data[offset], offset + 1 < bank_size ? data[offset + 1] : std::uint8_t(0),
+                                     offset + 2 < bank_size ? data[offset + 2] : std::uint8_t(0)};
+            std::uint8_t length = decode(bytes).length;
+            char encoded[12] = "";
+            for (std::uint8_t i = 0; i < length; ++i)
+            {
+                std::snprintf(encoded + i * 3, sizeof(encoded) - i * 3, "%02X ", bytes[i]);
+            }
+            std::string text = disassemble(here.address, bytes);
+            flow f = classify(here.address, bytes);
+            std::string comment;
+            if (f.has_target)
+            {
+                auto call = call_at.find(here);
+                location to = call != call_at.end() ? call->second : b.resolve(rom, f.target, unknown_bank);
+                comment = to.bank == unknown_bank ? (f.target < 0x8000 ? "; bank unknown" : "")
+                                                  : "; " + label(to, f.exit == block_exit::call);
+            }
+            else if (f.exit == block_exit::indirect)
+            {
+                comment = "; indirect";
+            }
+            if (comment.empty())
+            {
+                std::snprintf(line, sizeof(line), "    %04X  %-9s %s\n", here.address, encoded, text.c_str());
+            }
+            else
+            {
+                std::snprintf(line, sizeof(line), "    %04X  %-9s %-20s %s\n", here.address, encoded, text.c_str(),
+                              comment.c_str());
+            }
+            out << line;
+        }
+    }
+
+    out << "\n; ===== call graph =====\n";
+    for (const auto &[function, called] : callees)
+    {
+        out << label(function, true) << " ->";
+        for (const location &callee : called)
+        {
+            out << ' ' << (callee.bank == unknown_bank ? name(callee) : label(callee, true));
+        }
+        out << '\n';
+    }
+
+    size_t unresolved = 0;
+    for (const bank_analysis &b : banks)
+    {
+        unresolved += b.unresolved.size();
+    }
+    std::fprintf(stderr, "gb_disasm: %u banks, %zu instructions, %zu blocks, %zu functions, %zu unresolved bank "
+                         "targets, %zu rounds, %.3f s\n",
+                 rom.banks, instructions, index.blocks.size(), functions, unresolved, rounds, seconds);
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "trace.h"
+
+// Converts between binary traces (gb_emulator --trace, --compare-trace) and
+// the text format used by Gameboy Doctor and most other emulators' logs:
+//   A:01 F:B0 B:00 C:13 D:00 E:D8 H:01 L:4D SP:FFFE PC:0100 PCMEM:00,C3,13,02
+
+static void usage()
+{
+    std::cerr << "usage: gb_trace decode <trace.bin> [--cycles]\n"
+              << "       gb_trace encode <trace.log> <trace.bin>" << std::endl;
+}
+
+static int decode(const std::string &path, bool cycles)
+{
+    std::ifstream input(path, std::ios::binary);
+    trace_header header;
+    if (!input.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != trace_magic ||
+        header.record_size != sizeof(trace_record))
+    {
+        std::cerr << "gb_trace: " << path << " is not a trace file" << std::endl;
+        return 1;
+    }
+
+    trace_record record;
+    char line[128];
+    for (std::uint64_t i = 0; i < header.count && input.read(reinterpret_cast<char *>(&record), sizeof(record)); ++i)
+    {
+        int length = std::snprintf(line, sizeof(line),
+                                   "A:%02X F:%02X B:%02X C:%02X D:%02X E:%02X H:%02X L:%02X SP:%04X PC:%04X PCMEM:%02X,%02X,%02X,%02X",
+                                   record.a, record.f, record.b, record.c, record.d, record.e, record.h, record.l,
+                                   record.sp, record.pc, record.memory[0], record.memory[1], record.memory[2], record.memory[3]);
+        std::cout.write(line, length);
+        if (cycles)
+        {
+            std::cout << " BANK:" << record.bank << " CY:" << record.cycle;
+        }
+        std::cout << '\n';
+    }
+    return 0;
+}
+
+static int encode(const std::string &input_path, const std::string &output_path)
+{
+    std::ifstream input(input_path);
+    std::ofstream output(output_path, std::ios::binary);
+    if (!input || !output)
+    {
+        std::cerr << "gb_trace: unable to open " << (input ? output_path : input_path) << std::endl;
+        return 1;
+    }
+
+    trace_header header;
+    header.magic = trace_magic;
+    header.version = 1;
+    header.record_size = sizeof(trace_record);
+    header.count = 0;
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    std::vector<trace_record> batch;
+    batch.reserve(1 << 16);
+    auto flush = [&]()
+    {
+        output.write(reinterpret_cast<const char *>(batch.data()), batch.size() * sizeof(trace_record));
+        header.count += batch.size();
+        batch.clear();
+    };
+
+    std::string line;
+    std::uint64_t line_number = 0;
+    while (std::getline(input, line))
+    {
+        ++line_number;
+        trace_record record = {};
+        unsigned a, f, b, c, d, e, h, l, sp, pc;
+        unsigned memory[4] = {0, 0, 0, 0};
+        int fields = std::sscanf(line.c_str(), "A:%x F:%x B:%x C:%x D:%x E:%x H:%x L:%x SP:%x PC:%x PCMEM:%x,%x,%x,%x",
+                                 &a, &f, &b, &c, &d, &e, &h, &l, &sp, &pc, &memory[0], &memory[1], &memory[2], &memory[3]);
+        if (fields < 10)
+        {
+            std::cerr << "gb_trace: skipping malformed line " << line_number << std::endl;
+            continue;
+        }
+        if (fields < 14)
+        {
+            // --compare-trace checks the opcode bytes, so a record without
+            // them would mismatch on the first instruction
+            std::cerr << "gb_trace: line " << line_number << " has no PCMEM:xx,xx,xx,xx" << std::endl;
+            return 1;
+        }
+        record.a = a;
+        record.f = f;
+        record.b = b;
+        record.c = c;
+        record.d = d;
+        record.e = e;
+        record.h = h;
+        record.l = l;
+        record.sp = sp;
+        record.pc = pc;
+        for (int i = 0; i < 4; ++i)
+        {
+            record.memory[i] = memory[i];
+        }
+        batch.push_back(record);
+        if (batch.size() == batch.capacity())
+        {
+            flush();
+        }
+    }
+    flush();
+    output.seekp(0);
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string command = argc > 1 ? argv[1] : "";
+    if (command == "decode" && argc >= 3)
+    {
+        bool cycles = argc > 3 && std::string(argv[3]) == "--cycles";
+        return decode(argv[2], cycles);
+    }
+    if (command == "encode" && argc == 4)
+    {
+        return encode(argv[2], argv[3]);
+    }
+    usage();
+    return 1;
+}